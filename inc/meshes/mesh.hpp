@@ -3,7 +3,11 @@
 // std libraries
 #include <vector>         	  	 // std::vector
 #include <unordered_map>         // std::unordered_map
-#include <algorithm>             // std::min
+#include <algorithm>             // std::min, std::sort
+#include <cstdint>               // std::uint64_t
+#include <cstddef>               // std::size_t
+#include <limits>                // std::numeric_limits
+#include <type_traits>           // std::enable_if_t
 
 // 3rd party libraries
 #define GLM_ENABLE_EXPERIMENTAL
@@ -14,6 +18,7 @@
 #include <series/types.hpp>     	 // floats, etc.
 #include <series/glm/types.hpp>	 // *vec*s
 #include <series/glm/geometric.hpp>// normalize, etc.
+#include <series/execution.hpp>   // sequenced, parallel, etc.
 
 
 namespace meshes
@@ -183,6 +188,221 @@ namespace meshes
 		}
 		return mesh(series::vec3s(vertices), series::uvec3s(faces));
 	}
-}
 
+	namespace
+	{
+		const unsigned int NO_FACE = std::numeric_limits<unsigned int>::max();
+
+		// returns the index within `face` of the edge from `a` to `b` or `b` to `a`, where edge `i` runs from `face[i]` to `face[(i+1)%3]`
+		inline unsigned int get_edge_index(const glm::uvec3 face, const unsigned int a, const unsigned int b)
+		{
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				if (edge_id(face[i], face[(i+1)%3]) == edge_id(a, b)) { return i; }
+			}
+			return 3;
+		}
+		// returns the index within `face` of `vertex_id`
+		inline unsigned int get_vertex_index(const glm::uvec3 face, const unsigned int vertex_id)
+		{
+			return face.x == vertex_id? 0 : face.y == vertex_id? 1 : 2;
+		}
+		// returns whether face `face_id` creates the midpoint of the edge it shares with `neighbor_id` in `subdivide()`
+		inline bool is_midpoint_owner(const unsigned int face_id, const unsigned int neighbor_id)
+		{
+			return neighbor_id == NO_FACE || face_id < neighbor_id;
+		}
+	}
 
+	/*
+	`subdivide()` can also be given the number of times to subdivide, in which case it returns the same mesh as 
+	calling `subdivide()` that many times, with the same vertex and face ids, but without building a hash map per level.
+	Faces of the input are first matched with the faces that they share an edge with,
+	after which the faces and neighbors of each level are found in closed form from the faces and neighbors of the last:
+	the 4 faces that subdivide face `i` are given ids `4i` through `4i+3`,
+	and the midpoint of an edge is created by the face of lowest id that shares it, as it is in `subdivide()`,
+	so the id of each midpoint follows from a running count of the midpoints that are created by each face.
+	Each level is therefore built using independent loops over faces that are run according to `policy`, see "series/execution.hpp".
+	If `normalize_each_level` is set, vertices are normalized after each level, 
+	as is commonly done to produce icospheres whose vertices all lie on the unit sphere.
+	*/
+	template<typename Tpolicy, 
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	mesh subdivide(const Tpolicy policy, const mesh& input, const unsigned int level_count, const bool normalize_each_level = false)
+	{
+		series::vec3s  vertices(input.vertices);
+		series::uvec3s faces(input.faces);
+
+		// neighbors[i][j] is the face that shares edge j of face i, or NO_FACE if no face shares the edge
+		series::uvec3s neighbors(faces.size(), glm::uvec3(NO_FACE));
+		std::unordered_map<glm::uvec2, unsigned int> edge_face_ids {};
+		for (unsigned int i = 0; i < faces.size(); ++i)
+		{
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				const glm::uvec2 edge = edge_id(faces[i][j], faces[i][(j+1)%3]);
+				const auto found = edge_face_ids.find(edge);
+				if (found == edge_face_ids.end())
+				{
+					edge_face_ids[edge] = i;
+				}
+				else
+				{
+					const unsigned int k = found->second;
+					neighbors[i][j] = k;
+					neighbors[k][get_edge_index(faces[k], edge.x, edge.y)] = i;
+				}
+			}
+		}
+
+		for (unsigned int level = 0; level < level_count; ++level)
+		{
+			const std::size_t vertex_count = vertices.size();
+			const std::size_t face_count = faces.size();
+
+			// midpoint_offsets[i] is the number of midpoints created by faces with ids less than i
+			series::uints midpoint_offsets(face_count+1, 0u);
+			for (std::size_t i = 0; i < face_count; ++i)
+			{
+				unsigned int count = 0;
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					count += is_midpoint_owner(i, neighbors[i][j]);
+				}
+				midpoint_offsets[i+1] = midpoint_offsets[i] + count;
+			}
+			const auto get_midpoint_id = [&](const unsigned int face_id, const unsigned int edge_index) {
+				unsigned int id = vertex_count + midpoint_offsets[face_id];
+				for (unsigned int j = 0; j < edge_index; ++j)
+				{
+					id += is_midpoint_owner(face_id, neighbors[face_id][j]);
+				}
+				return id;
+			};
+
+			series::vec3s  fine_vertices(vertex_count + midpoint_offsets[face_count]);
+			series::uvec3s fine_faces(4*face_count);
+			series::uvec3s fine_neighbors(4*face_count);
+			series::for_each_id(policy, vertex_count, [&](const std::size_t i) {
+				fine_vertices[i] = vertices[i];
+			});
+			series::for_each_id(policy, face_count, [&](const std::size_t i) {
+				const glm::uvec3 face = faces[i];
+				const glm::uvec3 neighbor = neighbors[i];
+				glm::uvec3 midpoints;
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					const unsigned int a = face[j];
+					const unsigned int b = face[(j+1)%3];
+					if (is_midpoint_owner(i, neighbor[j]))
+					{
+						midpoints[j] = get_midpoint_id(i, j);
+						fine_vertices[midpoints[j]] = (vertices[a]+vertices[b])/2.f;
+					}
+					else
+					{
+						midpoints[j] = get_midpoint_id(neighbor[j], get_edge_index(faces[neighbor[j]], a, b));
+					}
+				}
+				// returns the id of the face that subdivides `face_id` and contains `vertex_id`, or NO_FACE if `face_id` is NO_FACE
+				const auto get_corner_face_id = [&](const unsigned int face_id, const unsigned int vertex_id) {
+					return face_id == NO_FACE? NO_FACE : 4*face_id + get_vertex_index(faces[face_id], vertex_id);
+				};
+				const unsigned int center_id = 4*i+3;
+				fine_faces[4*i+0] = glm::uvec3(face.x, midpoints.x, midpoints.z);
+				fine_faces[4*i+1] = glm::uvec3(face.y, midpoints.x, midpoints.y);
+				fine_faces[4*i+2] = glm::uvec3(face.z, midpoints.z, midpoints.y);
+				fine_faces[4*i+3] = glm::uvec3(midpoints.x, midpoints.y, midpoints.z);
+				fine_neighbors[4*i+0] = glm::uvec3(get_corner_face_id(neighbor.x, face.x), center_id, get_corner_face_id(neighbor.z, face.x));
+				fine_neighbors[4*i+1] = glm::uvec3(get_corner_face_id(neighbor.x, face.y), center_id, get_corner_face_id(neighbor.y, face.y));
+				fine_neighbors[4*i+2] = glm::uvec3(get_corner_face_id(neighbor.z, face.z), center_id, get_corner_face_id(neighbor.y, face.z));
+				fine_neighbors[4*i+3] = glm::uvec3(4*i+1, 4*i+2, 4*i+0);
+			});
+			if (normalize_each_level)
+			{
+				series::for_each_id(policy, fine_vertices.size(), [&](const std::size_t i) {
+					fine_vertices[i] = glm::normalize(fine_vertices[i]);
+				});
+			}
+			vertices = fine_vertices;
+			faces = fine_faces;
+			neighbors = fine_neighbors;
+		}
+		return mesh(vertices, faces);
+	}
+	mesh subdivide(const mesh& input, const unsigned int level_count, const bool normalize_each_level = false)
+	{
+		return subdivide(series::sequenced, input, level_count, normalize_each_level);
+	}
+
+	/*
+	`get_morton_order()` returns the ids of vertices sorted by their position along a Morton curve (a.k.a. "Z-order curve").
+	Vertices that are near each other in space tend to be near each other on the curve,
+	so renumbering vertices in this order causes neighboring vertices to be stored near each other in memory.
+	This improves cache utilization for operations that gather values from neighbors, such as those in "vector_calculus.hpp".
+	The output is a permutation where the `i`th element is the id of the vertex that should be renumbered to `i`.
+	*/
+	series::uints get_morton_order(const series::vec3s& vertices)
+	{
+		const unsigned int bits = 21; // the largest number of bits per dimension that fits within a 64 bit key
+		glm::vec3 lo = vertices[0];
+		glm::vec3 hi = vertices[0];
+		for (std::size_t i = 0; i < vertices.size(); ++i)
+		{
+			lo = glm::min(lo, vertices[i]);
+			hi = glm::max(hi, vertices[i]);
+		}
+		const glm::vec3 scale = float((1u << bits) - 1) / glm::max(hi - lo, glm::vec3(1e-30f));
+		auto spread = [](std::uint64_t x) {
+			// inserts two zero bits between each of the lower 21 bits of x
+			x &= 0x1fffff;
+			x = (x | x << 32) & 0x1f00000000ffff;
+			x = (x | x << 16) & 0x1f0000ff0000ff;
+			x = (x | x << 8)  & 0x100f00f00f00f00f;
+			x = (x | x << 4)  & 0x10c30c30c30c30c3;
+			x = (x | x << 2)  & 0x1249249249249249;
+			return x;
+		};
+		std::vector<std::uint64_t> keys(vertices.size());
+		for (std::size_t i = 0; i < vertices.size(); ++i)
+		{
+			glm::uvec3 cell = glm::uvec3((vertices[i] - lo) * scale);
+			keys[i] = spread(cell.x) | spread(cell.y) << 1 | spread(cell.z) << 2;
+		}
+		std::vector<unsigned int> order(vertices.size());
+		for (std::size_t i = 0; i < vertices.size(); ++i)
+		{
+			order[i] = i;
+		}
+		std::sort(order.begin(), order.end(), 
+			[&keys](unsigned int a, unsigned int b){ return keys[a] < keys[b] || (keys[a] == keys[b] && a < b); });
+		return series::uints(order);
+	}
+
+	/*
+	`reorder()` renumbers the vertices of a mesh so that the `i`th vertex of the output is the `old_ids[i]`th vertex of the input.
+	Faces are renumbered to match, and are then sorted by their smallest vertex id, so that faces are stored near their vertices.
+	`old_ids` should be retained if rasters must be mapped between the two meshes:
+	`series::get(input_raster, old_ids, output_raster)` maps from the input mesh to the output mesh,
+	and `series::set(input_raster, old_ids, output_raster)` maps back.
+	*/
+	mesh reorder(const mesh& input, const series::uints& old_ids)
+	{
+		assert(old_ids.size() == input.vertices.size());
+		series::vec3s vertices(input.vertices.size());
+		series::uints new_ids(old_ids.size());
+		for (std::size_t i = 0; i < old_ids.size(); ++i)
+		{
+			vertices[i] = input.vertices[old_ids[i]];
+			new_ids[old_ids[i]] = i;
+		}
+		std::vector<glm::uvec3> faces(input.faces.size());
+		for (std::size_t i = 0; i < input.faces.size(); ++i)
+		{
+			faces[i] = glm::uvec3(new_ids[input.faces[i].x], new_ids[input.faces[i].y], new_ids[input.faces[i].z]);
+		}
+		std::stable_sort(faces.begin(), faces.end(), 
+			[](glm::uvec3 a, glm::uvec3 b){ return std::min(a.x, std::min(a.y, a.z)) < std::min(b.x, std::min(b.y, b.z)); });
+		return mesh(vertices, series::uvec3s(faces));
+	}
+}
@@ -26,3 +26,70 @@ TEST_CASE( "mesh subdivision correctness", "[rasters]" ) {
         CHECK(icosphere.faces.size() == 4 * meshes::tetrahedron.faces.size());
     }
 }
+TEST_CASE( "mesh repeated subdivision consistency", "[rasters]" ) {
+    SECTION("subdivide(mesh, level_count) must produce the same output as calling subdivide(mesh) repeatedly"){
+        for (const meshes::mesh& base : {meshes::tetrahedron, meshes::octahedron, meshes::icosahedron})
+        {
+            meshes::mesh expected = base;
+            for (unsigned int i = 0; i < 4; ++i)
+            {
+                expected = meshes::subdivide(expected);
+            }
+            meshes::mesh icosphere = meshes::subdivide(base, 4);
+            CHECK(icosphere.vertices==expected.vertices);
+            CHECK(icosphere.faces==expected.faces);
+        }
+    }
+    SECTION("subdivide(mesh, level_count, true) must produce the same output as normalizing after each call to subdivide(mesh)"){
+        meshes::mesh expected = meshes::icosahedron;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            expected = meshes::subdivide(expected);
+            series::normalize(expected.vertices, expected.vertices);
+        }
+        meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 3, true);
+        CHECK(icosphere.vertices==expected.vertices);
+        CHECK(icosphere.faces==expected.faces);
+    }
+    SECTION("subdivide(mesh, level_count) must produce the same output regardless of policy"){
+        meshes::mesh icosphere1 = meshes::subdivide(meshes::icosahedron, 5);
+        meshes::mesh icosphere2 = meshes::subdivide(series::ParallelPolicy(4, 16), meshes::icosahedron, 5);
+        CHECK(icosphere1.vertices==icosphere2.vertices);
+        CHECK(icosphere1.faces==icosphere2.faces);
+    }
+    SECTION("subdivide(mesh, 0) must return a copy of the input"){
+        meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 0);
+        CHECK(icosphere.vertices==meshes::icosahedron.vertices);
+        CHECK(icosphere.faces==meshes::icosahedron.faces);
+    }
+}
+TEST_CASE( "mesh reordering correctness", "[rasters]" ) {
+    meshes::mesh icosphere = meshes::subdivide(meshes::subdivide(meshes::icosahedron));
+    series::uints old_ids = meshes::get_morton_order(icosphere.vertices);
+    meshes::mesh reordered = meshes::reorder(icosphere, old_ids);
+    SECTION("reorder(mesh) must preserve the number of vertices and faces"){
+        CHECK(reordered.vertices.size() == icosphere.vertices.size());
+        CHECK(reordered.faces.size() == icosphere.faces.size());
+    }
+    SECTION("get_morton_order(vertices) must return a permutation of vertex ids"){
+        series::uints counts(old_ids.size(), 0u);
+        for (std::size_t i = 0; i < old_ids.size(); ++i)
+        {
+            counts[old_ids[i]]++;
+        }
+        CHECK(counts == series::uints(old_ids.size(), 1u));
+    }
+    SECTION("reorder(mesh) must preserve the positions of the vertices of each face"){
+        series::vec3s input_face_midpoints(icosphere.faces.size());
+        series::vec3s output_face_midpoints(reordered.faces.size());
+        for (std::size_t i = 0; i < icosphere.faces.size(); ++i)
+        {
+            input_face_midpoints[i]  = icosphere.vertices[icosphere.faces[i].x] + icosphere.vertices[icosphere.faces[i].y] + icosphere.vertices[icosphere.faces[i].z];
+            output_face_midpoints[i] = reordered.vertices[reordered.faces[i].x] + reordered.vertices[reordered.faces[i].y] + reordered.vertices[reordered.faces[i].z];
+        }
+        auto is_less = [](glm::vec3 a, glm::vec3 b){ return a.x < b.x || (a.x == b.x && (a.y < b.y || (a.y == b.y && a.z < b.z))); };
+        std::sort(input_face_midpoints.begin(),  input_face_midpoints.end(),  is_less);
+        std::sort(output_face_midpoints.begin(), output_face_midpoints.end(), is_less);
+        CHECK(input_face_midpoints == output_face_midpoints);
+    }
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>          // std::array
+#include <cstdint>        // std::uint64_t
+#include <stdexcept>      // std::runtime_error
 #include <unordered_set>  // std::unordered_set
 #include <vector>         // std::vector
 
@@ -14,12 +17,37 @@
 #include <series/glm/convenience.hpp> // dot
 #include <series/convenience.hpp>     // in place add, sub, mult, div, etc.
 #include <series/operators.hpp>       // +, -, *, /
+#include <series/execution.hpp>       // sequenced, parallel, etc.
+#include <series/binary.hpp>          // BinaryReader, BinaryWriter
 
 #include <rasters/components/Structure/Structure.hpp>
 
 namespace rasters 
 {
 
+    /*
+    `metric_attributes` is a bitmask that selects which optional attributes of `Metrics` are stored.
+    Optional attributes only duplicate values that are already stored elsewhere in `Metrics`,
+    so they can be omitted from headless runs that never need them, which saves several vec3s per arrow.
+    Omitted attributes are left empty, and can be calculated on demand where they are needed, e.g.:
+
+        metrics.vertex_positions[structure.face_vertex_id_a]          // face_endpoint_a
+        metrics.vertex_positions[structure.edge_vertex_id_a]          // edge_endpoint_a
+        metrics.vertex_positions[structure.arrow_vertex_id_from]      // arrow_endpoint_from
+        metrics.face_midpoints[structure.arrow_face_id_a]             // arrow_dual_endpoint_a
+        metrics.vertex_positions[structure.flattened_face_vertex_ids] // flattened_face_vertex_coordinates, before flattening
+    */
+    namespace metric_attributes
+    {
+        constexpr unsigned int none                              = 0;
+        constexpr unsigned int face_endpoints                    = 1 << 0;
+        constexpr unsigned int edge_endpoints                    = 1 << 1;
+        constexpr unsigned int arrow_endpoints                   = 1 << 2;
+        constexpr unsigned int arrow_dual_endpoints              = 1 << 3;
+        constexpr unsigned int flattened_face_vertex_coordinates = 1 << 4;
+        constexpr unsigned int all                               = (1 << 5) - 1;
+    }
+
     /*
     A "grid" is a collection of interconnected grid cells on the surface of 
     an object that are intended to store values in a Raster. 
@@ -80,39 +108,42 @@ namespace rasters
 
         Tfloat                                           total_area;
 
+        // the `metric_attributes` that are stored
+        unsigned int                                     attributes;
+
 
         ~Metrics()
         {
 
         }
     private:
-        Metrics(const std::size_t vertex_count, const std::size_t face_count, const std::size_t edge_count)
+        Metrics(const std::size_t vertex_count, const std::size_t face_count, const std::size_t edge_count, const unsigned int attributes)
             : 
-                flattened_face_vertex_coordinates(3*3*face_count),
+                flattened_face_vertex_coordinates(attributes & metric_attributes::flattened_face_vertex_coordinates? 3*3*face_count : 0),
 
                 vertex_positions       (vertex_count),
                 vertex_normals         (vertex_count),
                 vertex_areas           (vertex_count),
                 vertex_average_area    (0),
 
-                face_endpoint_a        (face_count),
-                face_endpoint_b        (face_count),
-                face_endpoint_c        (face_count),
+                face_endpoint_a        (attributes & metric_attributes::face_endpoints? face_count : 0),
+                face_endpoint_b        (attributes & metric_attributes::face_endpoints? face_count : 0),
+                face_endpoint_c        (attributes & metric_attributes::face_endpoints? face_count : 0),
                 face_midpoints         (face_count),
                 face_normals           (face_count),
                 face_areas             (face_count),
                 face_average_area      (0),
 
-                edge_endpoint_a        (edge_count),
-                edge_endpoint_b        (edge_count),
+                edge_endpoint_a        (attributes & metric_attributes::edge_endpoints? edge_count : 0),
+                edge_endpoint_b        (attributes & metric_attributes::edge_endpoints? edge_count : 0),
                 edge_midpoints         (edge_count),
                 edge_lengths           (edge_count),
                 edge_normals           (edge_count),
             //  edge_areas             (edge_count),
                 edge_average_length    (0),
                 
-                arrow_endpoint_from    (2*edge_count),
-                arrow_endpoint_to      (2*edge_count),
+                arrow_endpoint_from    (attributes & metric_attributes::arrow_endpoints? 2*edge_count : 0),
+                arrow_endpoint_to      (attributes & metric_attributes::arrow_endpoints? 2*edge_count : 0),
                 arrow_midpoints        (2*edge_count),
                 arrow_offsets          (2*edge_count),
                 arrow_lengths          (2*edge_count), 
@@ -121,109 +152,246 @@ namespace rasters
                 arrow_average_length   (0),
 
                 vertex_dual_areas      (vertex_count),
-                arrow_dual_endpoint_a  (2*edge_count),
-                arrow_dual_endpoint_b  (2*edge_count),
+                arrow_dual_endpoint_a  (attributes & metric_attributes::arrow_dual_endpoints? 2*edge_count : 0),
+                arrow_dual_endpoint_b  (attributes & metric_attributes::arrow_dual_endpoints? 2*edge_count : 0),
                 arrow_dual_lengths     (2*edge_count),
                 arrow_dual_normals     (2*edge_count),
 
-                total_area             (0)
+                total_area             (0),
+
+                attributes             (attributes)
+        {
+
+        }
+
+        // calls `f` on each series of a metrics object, in the order that they are stored within binary files
+        template<typename Tmetrics, typename F>
+        static void for_each_series(Tmetrics& metrics, F f)
         {
+            f(metrics.flattened_face_vertex_coordinates);
+            f(metrics.vertex_positions);
+            f(metrics.vertex_normals);
+            f(metrics.vertex_areas);
+            f(metrics.face_endpoint_a);
+            f(metrics.face_endpoint_b);
+            f(metrics.face_endpoint_c);
+            f(metrics.face_midpoints);
+            f(metrics.face_normals);
+            f(metrics.face_areas);
+            f(metrics.edge_endpoint_a);
+            f(metrics.edge_endpoint_b);
+            f(metrics.edge_midpoints);
+            f(metrics.edge_lengths);
+            f(metrics.edge_normals);
+            f(metrics.arrow_endpoint_from);
+            f(metrics.arrow_endpoint_to);
+            f(metrics.arrow_midpoints);
+            f(metrics.arrow_offsets);
+            f(metrics.arrow_lengths);
+            f(metrics.arrow_normals);
+            f(metrics.vertex_dual_areas);
+            f(metrics.arrow_dual_endpoint_a);
+            f(metrics.arrow_dual_endpoint_b);
+            f(metrics.arrow_dual_lengths);
+            f(metrics.arrow_dual_normals);
+        }
 
+        explicit Metrics(const std::array<std::uint64_t,4> header):
+            Metrics(header[0], header[1], header[2], header[3])
+        {
+        }
+
+        // reads the counts and attributes of metrics, rejecting those that could not possibly be stored within the rest of the input
+        static std::array<std::uint64_t,4> read_header(series::BinaryReader& reader)
+        {
+            const std::array<std::uint64_t,4> header = reader.read<std::array<std::uint64_t,4>>();
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                if (header[i] > reader.remaining() / sizeof(Tfloat))
+                {
+                    throw std::runtime_error("Metrics has more elements than its input can store");
+                }
+            }
+            if ((header[3] & ~std::uint64_t(metric_attributes::all)) != 0)
+            {
+                throw std::runtime_error("Metrics has attributes that are not supported");
+            }
+            return header;
         }
 
     public:
+        /*
+        Reads metrics that were previously stored using `write()`, see "series/binary.hpp".
+        Input is validated before it is used, so a file that is truncated or corrupted results in a `std::runtime_error`.
+        */
+        explicit Metrics(series::BinaryReader& reader):
+            Metrics(read_header(reader))
+        {
+            const std::array<Tfloat,5> averages = reader.read<std::array<Tfloat,5>>();
+            vertex_average_area  = averages[0];
+            face_average_area    = averages[1];
+            edge_average_length  = averages[2];
+            arrow_average_length = averages[3];
+            total_area           = averages[4];
+            for_each_series(*this, [&reader](auto& a){ 
+                const std::size_t expected_size = a.size();
+                reader.read(a); 
+                if (a.size() != expected_size)
+                {
+                    throw std::runtime_error("Metrics does not have the expected number of elements");
+                }
+            });
+        }
+
+        void write(series::BinaryWriter& writer) const
+        {
+            writer.write(std::array<std::uint64_t,4>{vertex_positions.size(), face_midpoints.size(), edge_midpoints.size(), attributes});
+            writer.write(std::array<Tfloat,5>{vertex_average_area, face_average_area, edge_average_length, arrow_average_length, total_area});
+            for_each_series(*this, [&writer](const auto& a){ writer.write(a); });
+        }
+
+        explicit Metrics(
+            const series::Series<glm::vec<3,Tfloat,glm::defaultp>>& vertices, 
+            const Structure<Tid>& structure,
+            const unsigned int attributes = metric_attributes::all
+        ):
+            Metrics(series::sequenced, vertices, structure, attributes)
+        {
+        }
+
+        /*
+        Attributes are calculated in a handful of fused passes over vertices, faces, and arrows.
+        Each pass calculates every attribute for an element at once, so no temporary series are allocated,
+        and peak memory stays close to the memory that is occupied by the attributes themselves.
+        Passes that only write to the element they visit are run according to `policy`, see "series/execution.hpp".
+        The output is the same regardless of policy.
+        Only the optional attributes that are listed in `attributes` are stored, see `metric_attributes`.
+        */
+        template<typename Tpolicy, std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
         explicit Metrics(
+            const Tpolicy policy,
             const series::Series<glm::vec<3,Tfloat,glm::defaultp>>& vertices, 
-            const Structure<Tid>& structure
+            const Structure<Tid>& structure,
+            const unsigned int attributes = metric_attributes::all
         ):
-            Metrics(structure.vertex_count, structure.face_count, structure.edge_count)
+            Metrics(structure.vertex_count, structure.face_count, structure.edge_count, attributes)
         {
+            typedef glm::vec<3,Tfloat,glm::defaultp> vec3;
+
             copy(vertex_positions, vertices);
-            
-            series::Series<glm::vec<3,Tfloat,glm::defaultp>>      flattened_face_vertex_positions(3*structure.face_count);
-            get     (vertex_positions, structure.flattened_face_vertex_ids, flattened_face_vertex_positions   );
-            flatten (flattened_face_vertex_positions,                       flattened_face_vertex_coordinates );
-
-            get     (vertex_positions, structure.face_vertex_id_a,    face_endpoint_a);
-            get     (vertex_positions, structure.face_vertex_id_b,    face_endpoint_b);
-            get     (vertex_positions, structure.face_vertex_id_c,    face_endpoint_c);
-            face_midpoints = (face_endpoint_a + face_endpoint_b + face_endpoint_c) / Tfloat(3);
-
-            face_areas     = length   (cross(face_endpoint_c - face_endpoint_b, face_endpoint_a - face_endpoint_b)) / Tfloat(2); 
-            // ^^^ NOTE: the magnitude of cross product is the area of a parallelogram, so half that is the area of a triangle
+
+            // Pass 1: faces
+            series::for_each_id(policy, structure.face_count, [&](const std::size_t i) {
+                const vec3 a = vertex_positions[structure.face_vertex_id_a[i]];
+                const vec3 b = vertex_positions[structure.face_vertex_id_b[i]];
+                const vec3 c = vertex_positions[structure.face_vertex_id_c[i]];
+                if (attributes & metric_attributes::face_endpoints)
+                {
+                    face_endpoint_a[i] = a;
+                    face_endpoint_b[i] = b;
+                    face_endpoint_c[i] = c;
+                }
+                face_midpoints[i]  = (a + b + c) / Tfloat(3);
+                face_areas[i]      = glm::length(glm::cross(c - b, a - b)) / Tfloat(2);
+                // ^^^ NOTE: the magnitude of cross product is the area of a parallelogram, so half that is the area of a triangle
+                const vec3 normal  = series::normalize(glm::cross(c - b, a - b));
+                face_normals[i]    = normal * series::sign(glm::dot(normal, series::normalize(face_midpoints[i])));
+                // ^^^ NOTE: we correct by the sign of the cosine similarity of normals and midpoints.
+                // This way, the face normals will be somewhat standardized to face outward.
+                // This will hold for most well centered convex shapes. 
+                if (attributes & metric_attributes::flattened_face_vertex_coordinates)
+                {
+                    const vec3 endpoints[3] = {a, b, c};
+                    for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        for (std::size_t k = 0; k < 3; ++k)
+                        {
+                            flattened_face_vertex_coordinates[9*i+3*j+k] = endpoints[j][k];
+                        }
+                    }
+                }
+            });
             face_average_area = mean(face_areas);
             total_area = sum(face_areas);
 
-            face_normals   = normalize(cross(face_endpoint_c - face_endpoint_b, face_endpoint_a - face_endpoint_b)); 
-            face_normals  *= sign(dot(face_normals, normalize(face_midpoints)));
-            // ^^^ NOTE: we correct by the sign of the cosine similarity of normals and midpoints.
-            // This way, the face normals will be somewhat standardized to face outward.
-            // This will hold for most well centered convex shapes. 
-
-            series::Series<Tfloat> face_vertex_areas_a = length(cross((face_endpoint_c - face_endpoint_a)/Tfloat(2), (face_endpoint_b - face_endpoint_a)/Tfloat(2))) / Tfloat(2); 
-            series::Series<Tfloat> face_vertex_areas_b = length(cross((face_endpoint_a - face_endpoint_b)/Tfloat(2), (face_endpoint_c - face_endpoint_b)/Tfloat(2))) / Tfloat(2); 
-            series::Series<Tfloat> face_vertex_areas_c = length(cross((face_endpoint_b - face_endpoint_c)/Tfloat(2), (face_endpoint_a - face_endpoint_c)/Tfloat(2))) / Tfloat(2); 
-            // ^^^ NOTE: these 3 represent the surface area of the face that lies within a vertex's region of influence
-            aggregate_into(face_vertex_areas_a, structure.face_vertex_id_a, [](Tfloat a, Tfloat b){ return a+b; }, vertex_areas);
-            aggregate_into(face_vertex_areas_b, structure.face_vertex_id_b, [](Tfloat a, Tfloat b){ return a+b; }, vertex_areas);
-            aggregate_into(face_vertex_areas_c, structure.face_vertex_id_c, [](Tfloat a, Tfloat b){ return a+b; }, vertex_areas);
+            // Pass 2: faces, scattering into vertices, this must be sequential since faces share vertices
+            fill    (vertex_areas,   Tfloat(0));
+            fill    (vertex_normals, vec3(0));
+            for (std::size_t i = 0; i < structure.face_count; ++i)
+            {
+                const vec3 a = vertex_positions[structure.face_vertex_id_a[i]];
+                const vec3 b = vertex_positions[structure.face_vertex_id_b[i]];
+                const vec3 c = vertex_positions[structure.face_vertex_id_c[i]];
+                const vec3 area_weighted_normal = face_normals[i] * face_areas[i];
+                vertex_areas  [structure.face_vertex_id_a[i]] += glm::length(glm::cross((c - a)/Tfloat(2), (b - a)/Tfloat(2))) / Tfloat(2);
+                vertex_areas  [structure.face_vertex_id_b[i]] += glm::length(glm::cross((a - b)/Tfloat(2), (c - b)/Tfloat(2))) / Tfloat(2);
+                vertex_areas  [structure.face_vertex_id_c[i]] += glm::length(glm::cross((b - c)/Tfloat(2), (a - c)/Tfloat(2))) / Tfloat(2);
+                // ^^^ NOTE: these 3 represent the surface area of the face that lies within a vertex's region of influence
+                vertex_normals[structure.face_vertex_id_a[i]] += area_weighted_normal;
+                vertex_normals[structure.face_vertex_id_b[i]] += area_weighted_normal;
+                vertex_normals[structure.face_vertex_id_c[i]] += area_weighted_normal;
+            }
             vertex_average_area = mean(vertex_areas);
-
-            series::Series<glm::vec<3,Tfloat,glm::defaultp>> face_area_weighted_normals = face_normals * face_areas;
-            aggregate_into(face_area_weighted_normals, structure.face_vertex_id_a, [](glm::vec<3,Tfloat,glm::defaultp> a, glm::vec<3,Tfloat,glm::defaultp> b){ return a+b; }, vertex_normals);
-            aggregate_into(face_area_weighted_normals, structure.face_vertex_id_b, [](glm::vec<3,Tfloat,glm::defaultp> a, glm::vec<3,Tfloat,glm::defaultp> b){ return a+b; }, vertex_normals);
-            aggregate_into(face_area_weighted_normals, structure.face_vertex_id_c, [](glm::vec<3,Tfloat,glm::defaultp> a, glm::vec<3,Tfloat,glm::defaultp> b){ return a+b; }, vertex_normals);
             normalize(vertex_normals, vertex_normals);
 
-            //  edge_average_length  = 0.0f;
-            //  arrow_average_length = 0.0f;
-
-            get     (vertex_positions,   structure.edge_vertex_id_a, edge_endpoint_a );
-            get     (vertex_positions,   structure.edge_vertex_id_b, edge_endpoint_b );
-            distance(edge_endpoint_a,    edge_endpoint_b,            edge_lengths    );
-            add     (edge_endpoint_a,    edge_endpoint_b,            edge_midpoints  ); 
-            div     (edge_midpoints,     Tfloat(2),                  edge_midpoints  );
-            add     (get(vertex_normals, structure.edge_vertex_id_b), 
-                     get(vertex_normals, structure.edge_vertex_id_a), 
-                                                           edge_normals    ); 
-            normalize(edge_normals,                        edge_normals    );
+            // Pass 3: edges
+            series::for_each_id(policy, structure.edge_count, [&](const std::size_t i) {
+                const Tid a = structure.edge_vertex_id_a[i];
+                const Tid b = structure.edge_vertex_id_b[i];
+                if (attributes & metric_attributes::edge_endpoints)
+                {
+                    edge_endpoint_a[i] = vertex_positions[a];
+                    edge_endpoint_b[i] = vertex_positions[b];
+                }
+                edge_lengths[i]    = glm::distance(vertex_positions[a], vertex_positions[b]);
+                edge_midpoints[i]  = (vertex_positions[a] + vertex_positions[b]) / Tfloat(2);
+                edge_normals[i]    = series::normalize(vertex_normals[b] + vertex_normals[a]);
+            });
             edge_average_length = mean(edge_lengths);
 
-            get     (vertex_positions,   structure.arrow_vertex_id_from,arrow_endpoint_from);
-            get     (vertex_positions,   structure.arrow_vertex_id_to,  arrow_endpoint_to  );
-            distance(arrow_endpoint_from,arrow_endpoint_to,   arrow_lengths      );
-            sub     (arrow_endpoint_to,  arrow_endpoint_from, arrow_offsets      );
-            add     (arrow_endpoint_to,  arrow_endpoint_from, arrow_midpoints    );
-            div     (arrow_midpoints,    Tfloat(2),           arrow_midpoints    );
-            add     (get(vertex_normals, structure.arrow_vertex_id_from), 
-                     get(vertex_normals, structure.arrow_vertex_id_to), 
-                                                              arrow_normals      ); 
-            normalize(arrow_normals,                          arrow_normals      );
+            // Pass 4: arrows
+            series::for_each_id(policy, structure.arrow_count, [&](const std::size_t i) {
+                const Tid from = structure.arrow_vertex_id_from[i];
+                const Tid to   = structure.arrow_vertex_id_to[i];
+                const vec3 endpoint_from = vertex_positions[from];
+                const vec3 endpoint_to   = vertex_positions[to];
+                if (attributes & metric_attributes::arrow_endpoints)
+                {
+                    arrow_endpoint_from[i] = endpoint_from;
+                    arrow_endpoint_to[i]   = endpoint_to;
+                }
+                arrow_lengths[i]       = glm::distance(endpoint_from, endpoint_to);
+                arrow_offsets[i]       = endpoint_to - endpoint_from;
+                arrow_midpoints[i]     = (endpoint_to + endpoint_from) / Tfloat(2);
+                arrow_normals[i]       = series::normalize(vertex_normals[from] + vertex_normals[to]);
+
+                const vec3 dual_endpoint_a = face_midpoints[structure.arrow_face_id_a[i]];
+                const vec3 dual_endpoint_b = face_midpoints[structure.arrow_face_id_b[i]];
+                if (attributes & metric_attributes::arrow_dual_endpoints)
+                {
+                    arrow_dual_endpoint_a[i] = dual_endpoint_a;
+                    arrow_dual_endpoint_b[i] = dual_endpoint_b;
+                }
+                arrow_dual_lengths[i]    = glm::distance(dual_endpoint_a, dual_endpoint_b);
+                const vec3 dual_normal   = series::normalize(glm::cross(dual_endpoint_b - dual_endpoint_a, arrow_normals[i]));
+                arrow_dual_normals[i]    = dual_normal * series::sign(glm::dot(dual_normal, arrow_offsets[i]));
+            });
             arrow_average_length = mean(arrow_lengths);
 
-            series::Series<glm::vec<3,Tfloat,glm::defaultp>>  arrow_dual_offset_a    (2*structure.edge_count);
-            series::Series<glm::vec<3,Tfloat,glm::defaultp>>  arrow_dual_offset_b    (2*structure.edge_count);
-            series::Series<glm::vec<3,Tfloat,glm::defaultp>>  arrow_dual_offset_cross(2*structure.edge_count);
-            series::Series<glm::vec<3,Tfloat,glm::defaultp>>  arrow_dual_offset_ab   (2*structure.edge_count);
-            series::Series<Tfloat>                            arrow_dual_areas       (2*structure.edge_count);
-
-            get     (face_midpoints,         structure.arrow_face_id_a,       arrow_dual_endpoint_a   );
-            get     (face_midpoints,         structure.arrow_face_id_b,       arrow_dual_endpoint_b   );
-            distance(arrow_dual_endpoint_a,  arrow_dual_endpoint_b, arrow_dual_lengths      );
-            sub     (arrow_dual_endpoint_a,  arrow_endpoint_from,   arrow_dual_offset_a     );
-            sub     (arrow_dual_endpoint_b,  arrow_endpoint_from,   arrow_dual_offset_b     );
-            cross   (arrow_dual_offset_a,    arrow_dual_offset_b,   arrow_dual_offset_cross );
-            length  (arrow_dual_offset_cross,                       arrow_dual_areas        );
-            div     (arrow_dual_areas,       Tfloat(2),             arrow_dual_areas        );
-            sub     (arrow_dual_endpoint_b,  arrow_dual_endpoint_a, arrow_dual_offset_ab    );
-
-            cross   (arrow_dual_offset_ab,   arrow_normals,         arrow_dual_normals      );
-            normalize(arrow_dual_normals,                           arrow_dual_normals      );
-            arrow_dual_normals *= sign(dot(arrow_dual_normals, arrow_offsets));
-            
-            fill    (vertex_dual_areas,      Tfloat(0));
-            aggregate_into(arrow_dual_areas, structure.arrow_vertex_id_from, [](Tfloat a, Tfloat b) -> Tfloat { return a+b; }, vertex_dual_areas);
-
+            // Pass 5: vertices, gathering from the arrows that depart from them
+            series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+                Tfloat dual_area(0);
+                for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+                {
+                    const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                    const vec3 dual_endpoint_a = face_midpoints[structure.arrow_face_id_a[arrow_id]];
+                    const vec3 dual_endpoint_b = face_midpoints[structure.arrow_face_id_b[arrow_id]];
+                    dual_area += glm::length(glm::cross(
+                        dual_endpoint_a - vertex_positions[i], 
+                        dual_endpoint_b - vertex_positions[i])) / Tfloat(2);
+                }
+                vertex_dual_areas[i] = dual_area;
+            });
         }
     };
 
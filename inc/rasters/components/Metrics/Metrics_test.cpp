@@ -9,6 +9,7 @@
 
 // in-house libraries
 #include <meshes/mesh.hpp>  
+#include <series/glm/relational.hpp>  // equal
 
 #include <rasters/components/Structure/Structure.hpp>
 
@@ -88,3 +89,122 @@ TEST_CASE( "Metrics nontriviality", "[Metrics]" ) {
 
     }
 }
+
+TEST_CASE( "Metrics execution policy consistency", "[Metrics]" ) {
+    meshes::mesh icosphere_mesh(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    icosphere_mesh = meshes::subdivide(icosphere_mesh);
+    icosphere_mesh = meshes::subdivide(icosphere_mesh);
+    Structure<unsigned int> structure(icosphere_mesh.vertices.size(), icosphere_mesh.faces);
+    Metrics<unsigned int,float> sequential_metrics(series::sequenced, icosphere_mesh.vertices, structure);
+    Metrics<unsigned int,float> parallel_metrics(series::ParallelPolicy(4, 16), icosphere_mesh.vertices, structure);
+
+    SECTION("Metrics must have the same attributes regardless of the policy used to construct it"){
+        CHECK(sequential_metrics.flattened_face_vertex_coordinates == parallel_metrics.flattened_face_vertex_coordinates);
+        CHECK(series::equal(sequential_metrics.vertex_normals, parallel_metrics.vertex_normals));
+        CHECK(sequential_metrics.vertex_areas == parallel_metrics.vertex_areas);
+        CHECK(series::equal(sequential_metrics.face_normals, parallel_metrics.face_normals));
+        CHECK(sequential_metrics.face_areas == parallel_metrics.face_areas);
+        CHECK(series::equal(sequential_metrics.edge_normals, parallel_metrics.edge_normals));
+        CHECK(sequential_metrics.edge_lengths == parallel_metrics.edge_lengths);
+        CHECK(series::equal(sequential_metrics.arrow_normals, parallel_metrics.arrow_normals));
+        CHECK(series::equal(sequential_metrics.arrow_dual_normals, parallel_metrics.arrow_dual_normals));
+        CHECK(sequential_metrics.arrow_dual_lengths == parallel_metrics.arrow_dual_lengths);
+        CHECK(sequential_metrics.vertex_dual_areas == parallel_metrics.vertex_dual_areas);
+    }
+}
+
+TEST_CASE( "Metrics attribute selection", "[Metrics]" ) {
+    meshes::mesh icosphere_mesh(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    icosphere_mesh = meshes::subdivide(icosphere_mesh);
+    Structure<unsigned int> structure(icosphere_mesh.vertices.size(), icosphere_mesh.faces);
+    Metrics<unsigned int,float> full_metrics(icosphere_mesh.vertices, structure);
+    Metrics<unsigned int,float> lean_metrics(icosphere_mesh.vertices, structure, metric_attributes::none);
+
+    SECTION("Metrics must leave attributes empty if they are not selected"){
+        CHECK(lean_metrics.flattened_face_vertex_coordinates.size() == 0);
+        CHECK(lean_metrics.face_endpoint_a.size() == 0);
+        CHECK(lean_metrics.edge_endpoint_a.size() == 0);
+        CHECK(lean_metrics.arrow_endpoint_from.size() == 0);
+        CHECK(lean_metrics.arrow_dual_endpoint_a.size() == 0);
+        CHECK(full_metrics.arrow_endpoint_from.size() == structure.arrow_count);
+    }
+    SECTION("Metrics must calculate the same required attributes regardless of which attributes are selected"){
+        CHECK(series::equal(full_metrics.vertex_normals, lean_metrics.vertex_normals));
+        CHECK(full_metrics.vertex_areas == lean_metrics.vertex_areas);
+        CHECK(full_metrics.face_areas == lean_metrics.face_areas);
+        CHECK(full_metrics.edge_lengths == lean_metrics.edge_lengths);
+        CHECK(series::equal(full_metrics.arrow_dual_normals, lean_metrics.arrow_dual_normals));
+        CHECK(full_metrics.arrow_dual_lengths == lean_metrics.arrow_dual_lengths);
+        CHECK(full_metrics.vertex_dual_areas == lean_metrics.vertex_dual_areas);
+    }
+    SECTION("Metrics must allow omitted attributes to be calculated on demand"){
+        CHECK(series::equal(full_metrics.arrow_endpoint_from, lean_metrics.vertex_positions[structure.arrow_vertex_id_from]));
+        CHECK(series::equal(full_metrics.arrow_dual_endpoint_a, lean_metrics.face_midpoints[structure.arrow_face_id_a]));
+    }
+}
+
+TEST_CASE( "Metrics baseline consistency", "[Metrics]" ) {
+    meshes::mesh icosphere_mesh(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    icosphere_mesh = meshes::subdivide(icosphere_mesh);
+    icosphere_mesh = meshes::subdivide(icosphere_mesh);
+    Structure<unsigned int> structure(icosphere_mesh.vertices.size(), icosphere_mesh.faces);
+    Metrics<unsigned int,float> metrics(icosphere_mesh.vertices, structure);
+    // baseline attributes are calculated one whole series at a time, which is how Metrics was calculated before its passes were fused
+    const vec3s face_endpoint_a = series::get(metrics.vertex_positions, structure.face_vertex_id_a);
+    const vec3s face_endpoint_b = series::get(metrics.vertex_positions, structure.face_vertex_id_b);
+    const vec3s face_endpoint_c = series::get(metrics.vertex_positions, structure.face_vertex_id_c);
+    const vec3s face_midpoints  = (face_endpoint_a + face_endpoint_b + face_endpoint_c) / 3.0f;
+    const floats face_areas     = series::length(series::cross(face_endpoint_c - face_endpoint_b, face_endpoint_a - face_endpoint_b)) / 2.0f;
+    vec3s face_normals          = series::normalize(series::cross(face_endpoint_c - face_endpoint_b, face_endpoint_a - face_endpoint_b));
+    face_normals *= series::sign(series::dot(face_normals, series::normalize(face_midpoints)));
+    vec3s vertex_normals(structure.vertex_count, vec3(0));
+    const vec3s face_area_weighted_normals = face_normals * face_areas;
+    aggregate_into(face_area_weighted_normals, structure.face_vertex_id_a, [](vec3 a, vec3 b){ return a+b; }, vertex_normals);
+    aggregate_into(face_area_weighted_normals, structure.face_vertex_id_b, [](vec3 a, vec3 b){ return a+b; }, vertex_normals);
+    aggregate_into(face_area_weighted_normals, structure.face_vertex_id_c, [](vec3 a, vec3 b){ return a+b; }, vertex_normals);
+    series::normalize(vertex_normals, vertex_normals);
+    const vec3s edge_normals  = series::normalize(series::get(vertex_normals, structure.edge_vertex_id_a) + series::get(vertex_normals, structure.edge_vertex_id_b));
+    const vec3s arrow_offsets = series::get(metrics.vertex_positions, structure.arrow_vertex_id_to) - series::get(metrics.vertex_positions, structure.arrow_vertex_id_from);
+    const vec3s arrow_normals = series::normalize(series::get(vertex_normals, structure.arrow_vertex_id_from) + series::get(vertex_normals, structure.arrow_vertex_id_to));
+    const vec3s arrow_dual_endpoint_a = series::get(face_midpoints, structure.arrow_face_id_a);
+    const vec3s arrow_dual_endpoint_b = series::get(face_midpoints, structure.arrow_face_id_b);
+    vec3s arrow_dual_normals = series::normalize(series::cross(arrow_dual_endpoint_b - arrow_dual_endpoint_a, arrow_normals));
+    arrow_dual_normals *= series::sign(series::dot(arrow_dual_normals, arrow_offsets));
+
+    SECTION("Metrics must have the same attributes as those calculated one series at a time"){
+        CHECK(series::equal(metrics.face_midpoints, face_midpoints, 1e-6f));
+        CHECK(series::equal(metrics.face_areas, face_areas, 1e-6f));
+        CHECK(series::equal(metrics.face_normals, face_normals, 1e-6f));
+        CHECK(series::equal(metrics.vertex_normals, vertex_normals, 1e-6f));
+        CHECK(series::equal(metrics.edge_normals, edge_normals, 1e-6f));
+        CHECK(series::equal(metrics.arrow_offsets, arrow_offsets, 1e-6f));
+        CHECK(series::equal(metrics.arrow_normals, arrow_normals, 1e-6f));
+        CHECK(series::equal(metrics.arrow_dual_lengths, series::distance(arrow_dual_endpoint_a, arrow_dual_endpoint_b), 1e-6f));
+        CHECK(series::equal(metrics.arrow_dual_normals, arrow_dual_normals, 1e-6f));
+    }
+}
+
+TEST_CASE( "Metrics degenerate faces", "[Metrics]" ) {
+    meshes::mesh icosahedron_mesh(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    Structure<unsigned int> structure(icosahedron_mesh.vertices.size(), icosahedron_mesh.faces);
+    // faces that share the edge between the first two vertices collapse to a line, so their normals have no direction
+    vec3s vertices(icosahedron_mesh.vertices);
+    vertices[1] = vertices[0];
+    Metrics<unsigned int,float> metrics(vertices, structure);
+
+    auto has_nan = [](const vec3s& a){
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            if (std::isnan(a[i].x) || std::isnan(a[i].y) || std::isnan(a[i].z)) { return true; }
+        }
+        return false;
+    };
+
+    SECTION("Metrics must not produce NaNs for faces with no area"){
+        CHECK(!has_nan(metrics.face_normals));
+        CHECK(!has_nan(metrics.vertex_normals));
+        CHECK(!has_nan(metrics.edge_normals));
+        CHECK(!has_nan(metrics.arrow_normals));
+        CHECK(!has_nan(metrics.arrow_dual_normals));
+    }
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+// C libraries
+#include <assert.h>     // assert
+
+// std libraries
+#include <algorithm>    // std::min, std::find
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t
+#include <stdexcept>    // std::runtime_error
+#include <vector>       // std::vector
+
+// in-house libraries
+#include <series/types.hpp>
+#include <series/glm/types.hpp>
+#include <series/binary.hpp>        // BinaryReader, BinaryWriter
+#include <series/execution.hpp>     // sequenced, parallel, etc.
+
+#include "SpheroidVoronoi.hpp"
+
+namespace rasters
+{
+
+	/*
+	A "CompactSpheroidVoronoi" returns the same values as the "SpheroidVoronoi" it is constructed from,
+	using roughly a third of the memory.
+
+	Cells are divided into chunks of `CHUNK_SIZE` consecutive cells.
+	Each chunk stores the distinct vertex ids that occur within it in a "palette", 
+	and each cell stores the index of its vertex id within the palette of its chunk.
+	Neighboring cells usually share a vertex, so palettes are short, 
+	and since a chunk has no more than 256 cells, a cell index always fits in a single byte.
+	A lookup reads one byte from the cell and one id from the palette.
+	*/
+	class CompactSpheroidVoronoi : public SpheroidLookup<std::uint8_t>
+	{
+		// cells store palette indices rather than values, so they must not be modified through `get_ref()`
+		using SpheroidLookup<std::uint8_t>::get_ref;
+		friend class SpheroidLookup<std::uint8_t>;
+
+	protected:
+		static constexpr int CHUNK_SIZE = 256;
+		// palette of chunk `i` occupies ids `chunk_palette_offsets[i]` up to `chunk_palette_offsets[i+1]` within `palette`
+		std::vector<uint> chunk_palette_offsets;
+		std::vector<uint> palette;
+
+		// stores the output of `get_value()` for each of `count` points, where `count` is at most `LOOKUP_BATCH_SIZE`
+		void get_batch_values(const glm::vec3* points, const std::size_t count, uint* out) const
+		{
+			int memory_ids[LOOKUP_BATCH_SIZE];
+			get_batch_memory_ids(points, count, memory_ids);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out[i] = palette[chunk_palette_offsets[memory_ids[i] / CHUNK_SIZE] + cells[memory_ids[i]]];
+			}
+		}
+
+	public:
+		explicit CompactSpheroidVoronoi(const SpheroidVoronoi& voronoi) : 
+			SpheroidLookup<std::uint8_t>(voronoi.get_cell_width(), 0),
+			chunk_palette_offsets((cells.size() + CHUNK_SIZE - 1) / CHUNK_SIZE + 1, 0)
+		{
+			// cells are visited in the order they are stored
+			int memory_id = 0;
+			for (int side_id = 0; side_id < OCTAHEDRON_SIDE_COUNT; ++side_id)
+			{
+				for (int xi2d = 0; xi2d < dimensions.x; ++xi2d)
+				{
+					for (int yi2d = 0; yi2d < dimensions.y; ++yi2d, ++memory_id)
+					{
+						assert(memory_id == get_memory_id(xi2d, yi2d, side_id));
+						const int chunk_id = memory_id / CHUNK_SIZE;
+						if (memory_id % CHUNK_SIZE == 0)
+						{
+							chunk_palette_offsets[chunk_id] = palette.size();
+						}
+						const auto chunk_palette = palette.begin() + chunk_palette_offsets[chunk_id];
+						const uint vertex_id = voronoi.get_value(glm::ivec3(xi2d, yi2d, side_id));
+						const auto match = std::find(chunk_palette, palette.end(), vertex_id);
+						cells[memory_id] = match - chunk_palette;
+						if (match == palette.end())
+						{
+							palette.push_back(vertex_id);
+						}
+					}
+				}
+			}
+			chunk_palette_offsets.back() = palette.size();
+			palette.shrink_to_fit();
+		}
+		/*
+		Reads a lookup that was previously stored using `write()`, see "series/binary.hpp",
+		and checks that it is consistent with a grid of `vertex_count` vertices, see `validate()`.
+		*/
+		explicit CompactSpheroidVoronoi(series::BinaryReader& reader, const std::size_t vertex_count) : 
+			SpheroidLookup<std::uint8_t>(reader.read<float>(), 0)
+		{
+			reader.read(cells);
+			reader.read(chunk_palette_offsets);
+			reader.read(palette);
+			if (int(cells.size()) != cell_count() || 
+				chunk_palette_offsets.size() != (cells.size() + CHUNK_SIZE - 1) / CHUNK_SIZE + 1 ||
+				chunk_palette_offsets.back() != palette.size())
+			{
+				throw std::runtime_error("CompactSpheroidVoronoi does not have the expected number of cells");
+			}
+			validate(vertex_count);
+		}
+		/*
+		Throws if any cell refers to an index that lies outside the palette of its chunk,
+		or if any palette refers to a vertex that does not exist among `vertex_count` vertices,
+		such as when a file that stores the lookup is corrupted or does not match the vertices it was read with.
+		*/
+		void validate(const std::size_t vertex_count) const
+		{
+			for (std::size_t chunk_id = 0; chunk_id+1 < chunk_palette_offsets.size(); ++chunk_id)
+			{
+				if (chunk_palette_offsets[chunk_id] > chunk_palette_offsets[chunk_id+1])
+				{
+					throw std::runtime_error("CompactSpheroidVoronoi has a palette that does not exist");
+				}
+			}
+			for (std::size_t i = 0; i < cells.size(); ++i)
+			{
+				const std::size_t chunk_id = i / CHUNK_SIZE;
+				if (cells[i] >= chunk_palette_offsets[chunk_id+1] - chunk_palette_offsets[chunk_id])
+				{
+					throw std::runtime_error("CompactSpheroidVoronoi refers to a palette index that does not exist");
+				}
+			}
+			for (std::size_t i = 0; i < palette.size(); ++i)
+			{
+				if (palette[i] >= vertex_count)
+				{
+					throw std::runtime_error("CompactSpheroidVoronoi refers to a vertex that does not exist");
+				}
+			}
+		}
+		void write(series::BinaryWriter& writer) const
+		{
+			writer.write(cell_width);
+			writer.write(cells);
+			writer.write(chunk_palette_offsets);
+			writer.write(palette);
+		}
+
+		// the number of bytes that are occupied by the lookup tables
+		std::size_t memory_size() const
+		{
+			return cells.size() * sizeof(std::uint8_t) + (chunk_palette_offsets.size() + palette.size()) * sizeof(uint);
+		}
+
+		uint get_value(const glm::ivec3 conceptual_id) const
+		{
+			const int memory_id = get_memory_id(conceptual_id);
+			return palette[chunk_palette_offsets[memory_id / CHUNK_SIZE] + cells[memory_id]];
+		}
+		uint get_value(const glm::vec3 point) const
+		{
+			return get_value(get_conceptual_id(glm::normalize(point)));
+		}
+
+		/*
+		`get_values()` looks up many points at once, storing the same output as calling `get_value()` for each point
+		in the first `points.size()` elements of `out`, see `SpheroidLookup::get_values()`.
+		*/
+		template<typename Tpolicy, std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+		void get_values(const Tpolicy policy, const series::vec3s& points, series::Series<uint>& out) const
+		{
+			get_batched_values(policy, *this, points, out);
+		}
+		void get_values(const series::vec3s& points, series::Series<uint>& out) const
+		{
+			get_values(series::sequenced, points, out);
+		}
+	};
+}
@@ -0,0 +1,91 @@
+
+// std libraries
+#include <iostream>     // std::ostream
+#include <sstream>      // std::stringstream
+#include <random>       // std::mt19937
+
+// 3rd party libraries
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch/catch.hpp"
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>             // *vec3
+
+// in-house libraries
+#include <series/types.hpp>
+#include <series/operators.hpp>       // ==
+#include <series/glm/glm.hpp>         // *vec*s
+#include <series/glm/convenience.hpp> //  operators, etc.
+#include <series/execution.hpp>       // sequenced, ParallelPolicy
+#include <series/binary.hpp>          // BinaryReader, BinaryWriter
+#include <meshes/mesh.hpp>
+
+#include <rasters/components/Structure/Structure.hpp>
+
+#include "SpheroidVoronoi.hpp"
+#include "CompactSpheroidVoronoi.hpp"
+
+TEST_CASE( "CompactSpheroidVoronoi consistency", "[rasters]" ) {
+    const meshes::mesh icosphere = meshes::subdivide(meshes::subdivide(meshes::subdivide(meshes::icosahedron)));
+    const series::vec3s vertices = series::normalize(icosphere.vertices);
+    const rasters::Structure<unsigned int> structure(vertices.size(), icosphere.faces);
+    const rasters::SpheroidVoronoi voronoi(series::sequenced, vertices, 
+        structure.vertex_neighbor_offsets, structure.vertex_neighbor_ids, 0.005f, 0.2f);
+    const rasters::CompactSpheroidVoronoi compact(voronoi);
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    series::vec3s points(1000);
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+        points[i] = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+    series::uints expected(points.size());
+    voronoi.get_values(points, expected);
+    SECTION("CompactSpheroidVoronoi.get_value() must return the same output as the SpheroidVoronoi it was constructed from"){
+        int error_count = 0;
+        for (unsigned int i = 0; i < points.size(); ++i)
+        {
+            error_count += compact.get_value(points[i]) != voronoi.get_value(points[i]);
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("CompactSpheroidVoronoi.get_values() must return the same output regardless of execution policy"){
+        series::uints out(points.size());
+        compact.get_values(points, out);
+        CHECK(out == expected);
+        compact.get_values(series::ParallelPolicy(4, 16), points, out);
+        CHECK(out == expected);
+    }
+    SECTION("CompactSpheroidVoronoi.get_values() must accept empty input and output"){
+        series::uints out(0);
+        compact.get_values(series::vec3s(0), out);
+        CHECK(out.size() == 0);
+    }
+    SECTION("CompactSpheroidVoronoi must occupy less memory than the SpheroidVoronoi it was constructed from"){
+        CHECK(compact.memory_size() < voronoi.memory_size() / 2);
+    }
+    SECTION("CompactSpheroidVoronoi must return the same output after being written and read"){
+        std::stringstream stream;
+        series::BinaryWriter writer(stream);
+        compact.write(writer);
+        const std::string bytes = stream.str();
+        series::BinaryReader reader(bytes.data(), bytes.size());
+        const rasters::CompactSpheroidVoronoi loaded(reader, vertices.size());
+        series::uints out(points.size());
+        loaded.get_values(points, out);
+        CHECK(out == expected);
+    }
+    SECTION("CompactSpheroidVoronoi must refuse to read a lookup that refers to a vertex or palette index that does not exist"){
+        std::stringstream stream;
+        series::BinaryWriter writer(stream);
+        compact.write(writer);
+        const std::string bytes = stream.str();
+        series::BinaryReader reader(bytes.data(), bytes.size());
+        CHECK_THROWS_AS(rasters::CompactSpheroidVoronoi(reader, vertices.size()/2), std::runtime_error);
+        // the cells of the lookup begin after the cell width and the element count, each padded to `series::binary_alignment`
+        std::string corrupted = bytes;
+        corrupted[2*series::binary_alignment] = char(255);
+        series::BinaryReader corrupted_reader(corrupted.data(), corrupted.size());
+        CHECK_THROWS_AS(rasters::CompactSpheroidVoronoi(corrupted_reader, vertices.size()), std::runtime_error);
+    }
+}
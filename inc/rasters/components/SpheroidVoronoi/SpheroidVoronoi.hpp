@@ -1,6 +1,7 @@
 #pragma once
 
 // C libraries
+#include <assert.h>     // assert
 #include <math.h>       // ceil, round 
 
 // std libraries
@@ -8,6 +9,8 @@
 #include <vector>		// vectors
 #include <array>		// arrays
 #include <limits>       // infinity
+#include <cstddef>      // std::size_t
+#include <stdexcept>    // std::runtime_error
 
 // 3rd party libraries
 #include <glm/vec2.hpp>       	 // *vec3
@@ -18,6 +21,8 @@
 #include <series/glm/types.hpp>
 #include <series/glm/geometric.hpp>
 #include <series/glm/convenience.hpp>
+#include <series/binary.hpp>        // BinaryReader, BinaryWriter
+#include <series/execution.hpp>     // sequenced, parallel, etc.
 
 namespace rasters
 {
@@ -67,6 +72,77 @@ namespace rasters
 		{
 			return get_midpoint(conceptual_id.x, conceptual_id.y, conceptual_id.z);
 		}
+
+		static constexpr std::size_t LOOKUP_BATCH_SIZE = 64;
+
+		// stores the memory id of the cell that `get_value()` would read for each of `count` points, where `count` is at most `LOOKUP_BATCH_SIZE`
+		void get_batch_memory_ids(const glm::vec3* points, const std::size_t count, int* memory_ids) const
+		{
+			float side_x[3][OCTAHEDRON_SIDE_COUNT];
+			float side_y[3][OCTAHEDRON_SIDE_COUNT];
+			for (int side_id = 0; side_id < OCTAHEDRON_SIDE_COUNT; ++side_id)
+			{
+				for (int j = 0; j < 3; ++j)
+				{
+					side_x[j][side_id] = OCTAHEDRON_SIDE_X[side_id][j];
+					side_y[j][side_id] = OCTAHEDRON_SIDE_Y[side_id][j];
+				}
+			}
+
+			// Step 1: normalize points and find the side of the octahedron they project onto
+			float x[LOOKUP_BATCH_SIZE];
+			float y[LOOKUP_BATCH_SIZE];
+			float z[LOOKUP_BATCH_SIZE];
+			int side_ids[LOOKUP_BATCH_SIZE];
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const glm::vec3 point = glm::normalize(points[i]);
+				x[i] = point.x;
+				y[i] = point.y;
+				z[i] = point.z;
+				side_ids[i] = (x[i] > 0) + 2*(y[i] > 0) + 4*(z[i] > 0);
+			}
+
+			// Step 2: project points onto the 2d grid of their side, and find the id of the cell they occupy
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const int side_id = side_ids[i];
+				const double x2d = side_x[0][side_id]*x[i] + side_x[1][side_id]*y[i] + side_x[2][side_id]*z[i];
+				const double y2d = side_y[0][side_id]*x[i] + side_y[1][side_id]*y[i] + side_y[2][side_id]*z[i];
+				const int xi2d = (x2d + 1.) / cell_width;
+				const int yi2d = (y2d + 1.) / cell_width;
+				memory_ids[i] = get_memory_id(xi2d, yi2d, side_id);
+			}
+
+		}
+		// stores the output of `get_value()` for each of `count` points, where `count` is at most `LOOKUP_BATCH_SIZE`
+		void get_batch_values(const glm::vec3* points, const std::size_t count, T* out) const
+		{
+			int memory_ids[LOOKUP_BATCH_SIZE];
+			get_batch_memory_ids(points, count, memory_ids);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out[i] = cells[memory_ids[i]];
+			}
+		}
+		/*
+		`get_batched_values()` implements `get_values()` for `lookup`, which may be any class that derives from `SpheroidLookup`,
+		so long as it defines `get_batch_values()` and, if that is protected, is a friend of `SpheroidLookup`.
+		*/
+		template<typename Tpolicy, typename Tlookup, typename Tout>
+		static void get_batched_values(const Tpolicy policy, const Tlookup& lookup, const series::vec3s& points, series::Series<Tout>& out)
+		{
+			assert(points.size() <= out.size());
+			const glm::vec3* point_data = points.data();
+			Tout* out_data = out.data();
+			series::for_each_block(series::get_block_count(policy, points.size()), points.size(),
+				[&lookup, point_data, out_data](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+					for (std::size_t batch_begin = begin; batch_begin < end; batch_begin += LOOKUP_BATCH_SIZE)
+					{
+						lookup.get_batch_values(point_data + batch_begin, std::min(LOOKUP_BATCH_SIZE, end - batch_begin), out_data + batch_begin);
+					}
+				});
+		}
 	public:
 		~SpheroidLookup()
 		{
@@ -104,6 +180,16 @@ namespace rasters
 		{
 		}
 
+		float get_cell_width() const
+		{
+			return cell_width;
+		}
+		// the number of bytes that are occupied by the lookup table
+		std::size_t memory_size() const
+		{
+			return cells.size() * sizeof(T);
+		}
+
 		glm::ivec3 get_conceptual_id(const int xi2d, const int yi2d, const int side_id) const
 		{
 			return glm::ivec3(xi2d, yi2d, side_id);
@@ -147,12 +233,19 @@ namespace rasters
 			return get_value(get_conceptual_id(glm::normalize(point)));
 		}
 
+		/*
+		`get_values()` looks up many points at once, storing the same output as calling `get_value()` for each point in the first `points.size()` elements of `out`.
+		Points are processed in small batches, where each step of the lookup is a separate branchless loop over the batch,
+		so that the compiler can vectorize each step. Batches are distributed according to `policy`, see "series/execution.hpp".
+		*/
+		template<typename Tpolicy, std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+		void get_values(const Tpolicy policy, const series::vec3s& points, series::Series<T>& out) const
+		{
+			get_batched_values(policy, *this, points, out);
+		}
 		void get_values(const series::vec3s& points, series::Series<T>& out) const
 		{
-			for (unsigned int i = 0; i < points.size(); ++i)
-			{
-				out[i] = get_value(get_conceptual_id(glm::normalize(points[i])));
-			}
+			get_values(series::sequenced, points, out);
 		}
 
 	};
@@ -201,10 +294,192 @@ namespace rasters
 					}
 				}
 			}
+			// cells that are not within `max_vertex_distance` of any point keep the default value, so that every cell refers to a valid point
 			for (uint i = 0; i < cells.size(); ++i)
 			{
-				cells[i] = temp[i].first;
+				if (temp[i].first >= 0) { cells[i] = temp[i].first; }
+			}
+		}
+		/*
+		Populates the lookup by walking the graph of a mesh whose vertices are `points`,
+		where the neighbors of vertex `i` are `vertex_neighbor_ids[vertex_neighbor_offsets[i]]` 
+		up to but not including `vertex_neighbor_ids[vertex_neighbor_offsets[i+1]]`, see "Structure.hpp".
+		Cells are visited row by row, and the nearest point to each cell is found by starting at the nearest point to the previous cell
+		and stepping to whichever neighbor is closer until no neighbor is closer.
+		Rows alternate direction, so each row starts next to where the previous row ended and is seeded by its result.
+		The first row of each side and of each block is seeded by a search of every point instead.
+		Neighboring cells usually share the same nearest point, so most cells only need to check the neighbors of a single point,
+		regardless of how many points there are or how large `max_vertex_distance` is.
+
+		The walk only finds the exact nearest point if the mesh, once its points are normalized, is a delaunay triangulation of the sphere, 
+		which is the case if and only if its faces form the convex hull of its normalized points, see `is_delaunay_on_sphere()`.
+		Otherwise the walk can stop at a point that is merely nearer than its neighbors, 
+		so callers must check this precondition, and use the constructor above if it does not hold.
+		Cells are assigned only if their nearest point is within `max_vertex_distance`, as with the constructor above,
+		and cells that are not assigned store 0, as with the default constructor of `SpheroidLookup`, so that every cell refers to a valid point.
+		Rows of cells are distributed according to `policy`, see "series/execution.hpp".
+		*/
+		template<typename Tpolicy, typename Tid, std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+		explicit SpheroidVoronoi(
+			const Tpolicy policy,
+			const series::vec3s& points, 
+			const series::Series<Tid>& vertex_neighbor_offsets,
+			const series::Series<Tid>& vertex_neighbor_ids,
+			const float cell_width,
+			const float max_vertex_distance
+		  )	: 
+			SpheroidLookup<uint>(cell_width, 0)
+		{
+			assert(vertex_neighbor_offsets.size() == points.size()+1);
+			if (points.size() < 1) { return; }
+			const series::vec3s normalized(series::normalize(points));
+			/*
+			A cell that is closer to a point than half the distance from that point to its nearest neighbor
+			must be closer to that point than to any of its neighbors, so the walk can stop without checking them.
+			*/
+			series::floats inner_distances2(points.size(), std::numeric_limits<float>::infinity());
+			for (uint i = 0; i < points.size(); ++i)
+			{
+				for (Tid j = vertex_neighbor_offsets[i]; j < vertex_neighbor_offsets[i+1]; ++j)
+				{
+					const glm::vec3 offset = (normalized[vertex_neighbor_ids[j]] - normalized[i]) / 2.f;
+					inner_distances2[i] = std::min(inner_distances2[i], glm::dot(offset, offset));
+				}
+			}
+			/*
+			The component of a midpoint along `OCTAHEDRON_SIDE_Z` is `z2d`, and no cell can be within `max_vertex_distance` 
+			of a point that belongs to its side if that component is less than `min_z2d`.
+			*/
+			const float min_z2d = (1/sqrt(3)) - 2*max_vertex_distance;
+			const float max_distance2 = max_vertex_distance * max_vertex_distance;
+			const int row_count = OCTAHEDRON_SIDE_COUNT * dimensions.x;
+			auto get_nearest_id = [&](const glm::vec3 point) {
+				uint nearest_id = 0;
+				for (uint i = 1; i < points.size(); ++i)
+				{
+					if (glm::distance(normalized[i], point) < glm::distance(normalized[nearest_id], point)) { nearest_id = i; }
+				}
+				return nearest_id;
+			};
+			series::for_each_block(series::get_block_count(policy, cells.size()), row_count,
+				[&](const std::size_t block_id, const std::size_t row_begin, const std::size_t row_end) {
+					uint nearest_id = 0;
+					for (int row_id = row_begin; row_id < int(row_end); ++row_id)
+					{
+						const int side_id = row_id / dimensions.x;
+						const int xi2d = row_id % dimensions.x;
+						if (row_id == int(row_begin) || xi2d == 0)
+						{
+							// the previous row is on another side or in another block, so it cannot seed this row
+							nearest_id = get_nearest_id(OCTAHEDRON_SIDE_Z[side_id]);
+						}
+						const float x2d = (float)xi2d * cell_width - 1.;
+						// the part of each midpoint in the row that is contributed by `x2d`, see `get_midpoint()`
+						const glm::vec3 row_midpoint = OCTAHEDRON_SIDE_X[side_id] * x2d;
+						const glm::vec3 side_y = OCTAHEDRON_SIDE_Y[side_id];
+						const glm::vec3 side_z = OCTAHEDRON_SIDE_Z[side_id];
+						for (int k = 0; k < dimensions.y; ++k)
+						{
+							// alternate direction on each row so that the walk never has to cross the side
+							const int yi2d = row_id % 2 == 0? k : dimensions.y-1-k;
+							const float y2d = (float)yi2d * cell_width - 1.;
+							const float z2d2 = 1.f - (x2d*x2d) - (y2d*y2d);
+							if (min_z2d > 0 && z2d2 < min_z2d*min_z2d) { continue; }
+							const glm::vec3 midpoint = row_midpoint + side_y * y2d + side_z * std::sqrt(std::max(z2d2, 0.f));
+							glm::vec3 offset = normalized[nearest_id] - midpoint;
+							float nearest_distance2 = glm::dot(offset, offset);
+							for (uint current_id = -1; current_id != nearest_id && nearest_distance2 >= inner_distances2[nearest_id]; )
+							{
+								current_id = nearest_id;
+								for (Tid j = vertex_neighbor_offsets[current_id]; j < vertex_neighbor_offsets[current_id+1]; ++j)
+								{
+									const uint neighbor_id = vertex_neighbor_ids[j];
+									offset = normalized[neighbor_id] - midpoint;
+									const float distance2 = glm::dot(offset, offset);
+									if (distance2 < nearest_distance2)
+									{
+										nearest_id = neighbor_id;
+										nearest_distance2 = distance2;
+									}
+								}
+							}
+							if (nearest_distance2 <= max_distance2)
+							{
+								cells[get_memory_id(xi2d, yi2d, side_id)] = nearest_id;
+							}
+						}
+					}
+				});
+		}
+		/*
+		Reads a lookup that was previously stored using `write()`, see "series/binary.hpp".
+		*/
+		explicit SpheroidVoronoi(series::BinaryReader& reader) : 
+			SpheroidLookup<uint>(reader.read<float>(), 0)
+		{
+			reader.read(cells);
+			if (int(cells.size()) != cell_count())
+			{
+				throw std::runtime_error("SpheroidVoronoi does not have the expected number of cells");
+			}
+		}
+		/*
+		Throws if any cell refers to a vertex that does not exist among `vertex_count` vertices,
+		such as when a file that stores the lookup is corrupted or does not match the vertices it was read with.
+		*/
+		void validate(const std::size_t vertex_count) const
+		{
+			for (std::size_t i = 0; i < cells.size(); ++i)
+			{
+				if (cells[i] >= vertex_count)
+				{
+					throw std::runtime_error("SpheroidVoronoi refers to a vertex that does not exist");
+				}
 			}
 		}
+		void write(series::BinaryWriter& writer) const
+		{
+			writer.write(cell_width);
+			writer.write(cells);
+		}
 	};
+
+	/*
+	`is_delaunay_on_sphere()` returns whether the faces of a closed mesh form a delaunay triangulation of its points once they are normalized,
+	which is the precondition for the constructor of `SpheroidVoronoi` that walks the mesh.
+	On a sphere, a triangulation is delaunay if and only if it is the convex hull of its points, 
+	and a closed triangulation is the convex hull if no edge is concave, so only the two faces of each edge need to be checked.
+	Points that lie on the same circle may be triangulated either way, so an edge is only rejected if it is concave by more than `tolerance`.
+	*/
+	template<typename Tid>
+	bool is_delaunay_on_sphere(
+		const series::vec3s& points,
+		const series::Series<glm::vec<3,Tid,glm::defaultp>>& face_vertex_ids,
+		const series::Series<glm::vec<2,Tid,glm::defaultp>>& edge_vertex_ids,
+		const series::Series<glm::vec<2,Tid,glm::defaultp>>& edge_face_ids,
+		const float tolerance = 1e-5f
+	){
+		for (std::size_t i = 0; i < edge_vertex_ids.size(); ++i)
+		{
+			if (edge_face_ids[i].x == edge_face_ids[i].y) { return false; } // the mesh is not closed
+			const glm::vec<3,Tid,glm::defaultp> face = face_vertex_ids[edge_face_ids[i].x];
+			const glm::vec<3,Tid,glm::defaultp> other_face = face_vertex_ids[edge_face_ids[i].y];
+			// the vertex of the other face that is not on the edge
+			Tid other_vertex_id = other_face.x;
+			for (int j = 0; j < 3; ++j)
+			{
+				if (other_face[j] != edge_vertex_ids[i].x && other_face[j] != edge_vertex_ids[i].y) { other_vertex_id = other_face[j]; }
+			}
+			const glm::vec3 a = glm::normalize(points[face.x]);
+			const glm::vec3 b = glm::normalize(points[face.y]);
+			const glm::vec3 c = glm::normalize(points[face.z]);
+			glm::vec3 normal = glm::cross(b - a, c - a);
+			const float normal_length = glm::length(normal);
+			if (normal_length == 0.f) { return false; }
+			// orient the normal outward, away from the center of the sphere
+			normal = (glm::dot(normal, a) < 0.f? -normal : normal) / normal_length;
+			if (glm::dot(normal, glm::normalize(points[other_vertex_id]) - a) > tolerance) { return false; }
+		}
+		return true;
+	}
 }
\ No newline at end of file
@@ -1,4 +1,8 @@
 
+// std libraries
+#include <iostream>     // std::ostream
+#include <random>       // std::mt19937
+
 // 3rd party libraries
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include "catch/catch.hpp"
@@ -10,8 +14,13 @@
 #include <series/types.hpp>
 #include <series/common.hpp>
 #include <series/convenience.hpp>  
+#include <series/operators.hpp>       // ==
 #include <series/glm/glm.hpp>         // *vec*s
 #include <series/glm/convenience.hpp> //  operators, etc.
+#include <series/execution.hpp>       // sequenced, ParallelPolicy
+#include <meshes/mesh.hpp>
+
+#include <rasters/components/Structure/Structure.hpp>
 
 #include "SpheroidVoronoi.hpp"
 
@@ -58,4 +67,101 @@ TEST_CASE( "SpheroidVoronoi.get_value() happy path", "[rasters]" ) {
         CHECK(  voronoi.get_value(glm::normalize(glm::vec3(-1, 1, 1))) == 12 );
         CHECK(  voronoi.get_value(glm::normalize(glm::vec3( 1, 1, 1))) == 13 );
     }
-}
\ No newline at end of file
+}
+TEST_CASE( "SpheroidVoronoi.get_values() consistency", "[rasters]" ) {
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    series::vec3s points(1000);
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+        points[i] = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+    series::uints expected(points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+        expected[i] = voronoi.get_value(points[i]);
+    }
+    SECTION("SpheroidVoronoi.get_values() must return the same output as calling get_value() for each point"){
+        series::uints out(points.size());
+        voronoi.get_values(points, out);
+        CHECK(out == expected);
+    }
+    SECTION("SpheroidVoronoi.get_values() must return the same output regardless of execution policy"){
+        series::uints out(points.size());
+        voronoi.get_values(series::ParallelPolicy(4, 16), points, out);
+        CHECK(out == expected);
+    }    SECTION("SpheroidVoronoi.get_values() must accept empty input and output"){
+        series::uints out(0);
+        voronoi.get_values(series::vec3s(0), out);
+        CHECK(out.size() == 0);
+    }
+}
+TEST_CASE( "SpheroidVoronoi mesh walk correctness", "[rasters]" ) {
+    const meshes::mesh icosphere = meshes::subdivide(meshes::subdivide(meshes::icosahedron));
+    const series::vec3s vertices = series::normalize(icosphere.vertices);
+    const rasters::Structure<unsigned int> structure(vertices.size(), icosphere.faces);
+    const float cell_width = 0.01f;
+    const rasters::SpheroidVoronoi walked(series::sequenced, vertices, 
+        structure.vertex_neighbor_offsets, structure.vertex_neighbor_ids, cell_width, 1.f);
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    series::vec3s points(1000);
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+        points[i] = glm::normalize(glm::vec3(distribution(generator), distribution(generator), distribution(generator)));
+    }
+    SECTION("SpheroidVoronoi must return the same vertex as a search of every vertex near each cell"){
+        const rasters::SpheroidVoronoi searched(vertices, cell_width, 1.f);
+        int error_count = 0;
+        for (unsigned int i = 0; i < points.size(); ++i)
+        {
+            error_count += walked.get_value(points[i]) != searched.get_value(points[i]);
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("SpheroidVoronoi must only refer to vertices that exist, even for cells that are far from any vertex"){
+        const rasters::SpheroidVoronoi sparse(series::sequenced, vertices, 
+            structure.vertex_neighbor_offsets, structure.vertex_neighbor_ids, cell_width, cell_width);
+        series::uints ids(points.size());
+        sparse.get_values(points, ids);
+        CHECK(series::max(ids) < vertices.size());
+    }
+    SECTION("A subdivided icosahedron must be a delaunay triangulation once normalized"){
+        CHECK(rasters::is_delaunay_on_sphere(vertices, structure.face_vertex_ids, structure.edge_vertex_ids, structure.edge_face_ids));
+    }
+    SECTION("A mesh with a concave edge must not be a delaunay triangulation"){
+        // replace the first edge (a,b) with the other diagonal (c,d) of the quad that is formed by its two faces
+        series::uvec3s faces(icosphere.faces);
+        const glm::uvec2 edge = structure.edge_vertex_ids[0];
+        const glm::uvec2 edge_faces = structure.edge_face_ids[0];
+        auto get_opposite = [&](const glm::uvec3 face){ 
+            for (int j = 0; j < 3; ++j) { if (face[j] != edge.x && face[j] != edge.y) { return face[j]; } }
+            return face.x;
+        };
+        const unsigned int c = get_opposite(faces[edge_faces.x]);
+        const unsigned int d = get_opposite(faces[edge_faces.y]);
+        faces[edge_faces.x] = glm::uvec3(edge.x, c, d);
+        faces[edge_faces.y] = glm::uvec3(edge.y, d, c);
+        const rasters::Structure<unsigned int> flipped(vertices.size(), faces);
+        CHECK(!rasters::is_delaunay_on_sphere(vertices, flipped.face_vertex_ids, flipped.edge_vertex_ids, flipped.edge_face_ids));
+    }
+    SECTION("SpheroidVoronoi must return the same vertex for a vertex position"){
+        series::uints ids(vertices.size());
+        walked.get_values(vertices, ids);
+        int error_count = 0;
+        for (unsigned int i = 0; i < vertices.size(); ++i)
+        {
+            error_count += ids[i] != i;
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("SpheroidVoronoi must be constructed the same way regardless of execution policy"){
+        const rasters::SpheroidVoronoi parallel_walked(series::ParallelPolicy(4, 16), vertices, 
+            structure.vertex_neighbor_offsets, structure.vertex_neighbor_ids, cell_width, 1.f);
+        series::uints expected(points.size());
+        series::uints out(points.size());
+        walked.get_values(points, expected);
+        parallel_walked.get_values(points, out);
+        CHECK(out == expected);
+    }
+}
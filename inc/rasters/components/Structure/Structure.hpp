@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>          // std::array
+#include <cstdint>        // std::uint64_t
+#include <stdexcept>      // std::runtime_error
 #include <unordered_set>  // std::unordered_set
 #include <vector>         // std::vector
 
@@ -14,6 +17,7 @@
 #include <series/glm/convenience.hpp> // dot
 #include <series/convenience.hpp>     // in place add, sub, mult, div, etc.
 #include <series/operators.hpp>       // +, -, *, /
+#include <series/binary.hpp>          // BinaryReader, BinaryWriter
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp>           // unordered_set<vec*>
@@ -21,6 +25,17 @@
 namespace rasters 
 {
 
+    /*
+    Tags that select how a `Structure` generates its edges and arrows from faces.
+    `SortedArrowConstruction` is the default: it packs the vertex ids of each arrow into a 64 bit key 
+    and radix sorts the keys, which takes linear time and only allocates a handful of flat arrays.
+    `HashedArrowConstruction` inserts arrows into hash tables, which is slower and far more memory intensive,
+    but it is retained for comparison, see "profile/profile_structure.cpp".
+    Both produce the same edges, arrows, and adjacent faces.
+    */
+    struct SortedArrowConstruction {};
+    struct HashedArrowConstruction {};
+
     /*
     A "grid" is a collection of interconnected grid cells on the surface of 
     an object that are intended to store values in a Raster. 
@@ -43,9 +58,19 @@ namespace rasters
         */
         series::Series<Tid>                              flattened_face_vertex_ids;
 
-        //ivecNs                                         vertex_neighbor_ids;
         const std::size_t                                vertex_count;
         series::Series<Tid>                              vertex_neighbor_counts;
+        /*
+        Neighbors of each vertex in compressed sparse row format:
+        the neighbors of vertex `i` occupy ids `vertex_neighbor_offsets[i]` up to `vertex_neighbor_offsets[i+1]`
+        within `vertex_neighbor_ids` and `vertex_neighbor_arrow_ids`, sorted by neighbor id.
+        `vertex_neighbor_arrow_ids` stores the id of the arrow that departs from `i` towards each neighbor.
+        This allows operations over neighborhoods to be written as loops that gather input for each vertex,
+        which have better write locality than loops that scatter output from arrows, and can be run in parallel without races.
+        */
+        series::Series<Tid>                              vertex_neighbor_offsets;
+        series::Series<Tid>                              vertex_neighbor_ids;
+        series::Series<Tid>                              vertex_neighbor_arrow_ids;
 
         const std::size_t                                face_count;
         series::Series<glm::vec<3,Tid,glm::defaultp>>    face_vertex_ids;
@@ -82,9 +107,11 @@ namespace rasters
             : 
                 flattened_face_vertex_ids        (3*face_count),
 
-            //  vertex_neighbor_ids    (0),
                 vertex_count           (vertex_count),
                 vertex_neighbor_counts (vertex_count),
+                vertex_neighbor_offsets  (vertex_count+1),
+                vertex_neighbor_ids      (2*edge_count),
+                vertex_neighbor_arrow_ids(2*edge_count),
 
                 face_count             (face_count),
                 face_vertex_ids        (face_count),
@@ -116,9 +143,7 @@ namespace rasters
 
         }
 
-    public:
-        explicit Structure(const std::size_t vertex_count, const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces):
-            Structure(vertex_count, faces.size(), 0)
+        void store_faces(const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces)
         {
             copy(face_vertex_ids,  faces);
             
@@ -127,6 +152,322 @@ namespace rasters
             get_x   (face_vertex_ids,                       face_vertex_id_a);
             get_y   (face_vertex_ids,                       face_vertex_id_b);
             get_z   (face_vertex_ids,                       face_vertex_id_c);
+        }
+
+        // resizes edge and arrow attributes once `edge_vertex_ids` and `arrow_vertex_ids` are known
+        void resize_edges_and_arrows()
+        {
+            edge_count = edge_vertex_ids.size();
+
+            edge_vertex_id_a       .vector().resize(edge_count);
+            edge_vertex_id_b       .vector().resize(edge_count);
+            edge_face_ids          .vector().resize(edge_count);
+            edge_face_id_a         .vector().resize(edge_count);
+            edge_face_id_b         .vector().resize(edge_count);
+            
+            arrow_count = arrow_vertex_ids.size();
+
+            arrow_vertex_id_from   .vector().resize(2*edge_count);
+            arrow_vertex_id_to     .vector().resize(2*edge_count);
+            arrow_face_ids         .vector().resize(2*edge_count);
+            arrow_face_id_a        .vector().resize(2*edge_count);
+            arrow_face_id_b        .vector().resize(2*edge_count);
+
+            vertex_neighbor_ids      .vector().resize(2*edge_count);
+            vertex_neighbor_arrow_ids.vector().resize(2*edge_count);
+        }
+
+        // stores attributes that can be derived from `edge_*_ids` and `arrow_*_ids`
+        void store_edge_and_arrow_components()
+        {
+            get_x   (edge_vertex_ids,                      edge_vertex_id_a);
+            get_y   (edge_vertex_ids,                      edge_vertex_id_b);
+            get_x   (edge_face_ids,                        edge_face_id_a  );
+            get_y   (edge_face_ids,                        edge_face_id_b  );
+
+            get_x   (arrow_vertex_ids,                        arrow_vertex_id_from); 
+            get_y   (arrow_vertex_ids,                        arrow_vertex_id_to );
+            get_x   (arrow_face_ids,                          arrow_face_id_a    );
+            get_y   (arrow_face_ids,                          arrow_face_id_b    );
+
+            fill    (vertex_neighbor_counts, Tid(0));
+            aggregate_into(arrow_vertex_id_from, [](Tid a){ return a+1; }, vertex_neighbor_counts);
+
+            store_vertex_neighbors();
+        }
+
+        // stores `vertex_neighbor_*` attributes using a counting sort of arrows by the vertex they depart from
+        void store_vertex_neighbors()
+        {
+            vertex_neighbor_offsets[0] = 0;
+            for (std::size_t i=0; i<vertex_count; i++)
+            {
+                vertex_neighbor_offsets[i+1] = vertex_neighbor_offsets[i] + vertex_neighbor_counts[i];
+            }
+            std::vector<std::size_t> next_ids(vertex_neighbor_offsets.begin(), vertex_neighbor_offsets.end()-1);
+            for (std::size_t i=0; i<arrow_count; i++)
+            {
+                std::size_t j = next_ids[arrow_vertex_id_from[i]]++;
+                vertex_neighbor_ids[j]       = arrow_vertex_id_to[i];
+                vertex_neighbor_arrow_ids[j] = Tid(i);
+            }
+            // arrows are usually listed in order already, so an insertion sort of each vertex's neighbors is nearly free
+            for (std::size_t i=0; i<vertex_count; i++)
+            {
+                for (std::size_t j=vertex_neighbor_offsets[i]+1; j<vertex_neighbor_offsets[i+1]; j++)
+                {
+                    for (std::size_t k=j; k>vertex_neighbor_offsets[i] && vertex_neighbor_ids[k-1] > vertex_neighbor_ids[k]; k--)
+                    {
+                        std::swap(vertex_neighbor_ids[k-1],       vertex_neighbor_ids[k]);
+                        std::swap(vertex_neighbor_arrow_ids[k-1], vertex_neighbor_arrow_ids[k]);
+                    }
+                }
+            }
+        }
+
+        /*
+        `sort_keys()` performs a stable least significant digit radix sort on `keys`, 
+        moving `values` alongside them. Only digits that are needed to represent `max_key` are visited.
+        */
+        static void sort_keys(std::vector<std::uint64_t>& keys, std::vector<Tid>& values, const std::uint64_t max_key)
+        {
+            const unsigned int digit_bits = 8;
+            const std::size_t  digit_count = 1 << digit_bits;
+            std::vector<std::uint64_t> keys_scratch  (keys.size());
+            std::vector<Tid>           values_scratch(values.size());
+            std::vector<std::size_t>   offsets       (digit_count);
+            for (unsigned int shift = 0; shift < 64 && (max_key >> shift) > 0; shift += digit_bits)
+            {
+                std::fill(offsets.begin(), offsets.end(), 0);
+                for (std::size_t i = 0; i < keys.size(); ++i)
+                {
+                    offsets[(keys[i] >> shift) & (digit_count-1)]++;
+                }
+                std::size_t offset = 0;
+                for (std::size_t digit = 0; digit < digit_count; ++digit)
+                {
+                    std::size_t count = offsets[digit];
+                    offsets[digit] = offset;
+                    offset += count;
+                }
+                for (std::size_t i = 0; i < keys.size(); ++i)
+                {
+                    std::size_t j = offsets[(keys[i] >> shift) & (digit_count-1)]++;
+                    keys_scratch[j]   = keys[i];
+                    values_scratch[j] = values[i];
+                }
+                keys.swap(keys_scratch);
+                values.swap(values_scratch);
+            }
+        }
+
+        // calls `f` on each series of a structure, in the order that they are stored within binary files
+        template<typename Tstructure, typename F>
+        static void for_each_series(Tstructure& structure, F f)
+        {
+            f(structure.flattened_face_vertex_ids);
+            f(structure.vertex_neighbor_counts);
+            f(structure.vertex_neighbor_offsets);
+            f(structure.vertex_neighbor_ids);
+            f(structure.vertex_neighbor_arrow_ids);
+            f(structure.face_vertex_ids);
+            f(structure.face_vertex_id_a);
+            f(structure.face_vertex_id_b);
+            f(structure.face_vertex_id_c);
+            f(structure.edge_vertex_ids);
+            f(structure.edge_vertex_id_a);
+            f(structure.edge_vertex_id_b);
+            f(structure.edge_face_ids);
+            f(structure.edge_face_id_a);
+            f(structure.edge_face_id_b);
+            f(structure.arrow_vertex_ids);
+            f(structure.arrow_vertex_id_from);
+            f(structure.arrow_vertex_id_to);
+            f(structure.arrow_face_ids);
+            f(structure.arrow_face_id_a);
+            f(structure.arrow_face_id_b);
+        }
+
+        explicit Structure(const std::array<std::uint64_t,3> counts):
+            Structure(counts[0], counts[1], counts[2])
+        {
+        }
+
+        // reads the counts of a structure, rejecting counts that could not possibly be stored within the rest of the input
+        static std::array<std::uint64_t,3> read_counts(series::BinaryReader& reader)
+        {
+            const std::array<std::uint64_t,3> counts = reader.read<std::array<std::uint64_t,3>>();
+            for (const std::uint64_t count : counts)
+            {
+                if (count > reader.remaining() / sizeof(Tid))
+                {
+                    throw std::runtime_error("Structure has more elements than its input can store");
+                }
+            }
+            return counts;
+        }
+
+        // throws if any id refers to an element that does not exist, or if redundant series disagree with one another
+        void validate() const
+        {
+            auto validate_ids = [](const series::Series<Tid>& ids, const std::size_t count) {
+                for (std::size_t i = 0; i < ids.size(); ++i)
+                {
+                    if (std::size_t(ids[i]) >= count)
+                    {
+                        throw std::runtime_error("Structure refers to an element that does not exist");
+                    }
+                }
+            };
+            validate_ids(flattened_face_vertex_ids, vertex_count);
+            validate_ids(vertex_neighbor_ids,       vertex_count);
+            validate_ids(vertex_neighbor_arrow_ids, arrow_count);
+            validate_ids(face_vertex_id_a,          vertex_count);
+            validate_ids(face_vertex_id_b,          vertex_count);
+            validate_ids(face_vertex_id_c,          vertex_count);
+            validate_ids(edge_vertex_id_a,          vertex_count);
+            validate_ids(edge_vertex_id_b,          vertex_count);
+            validate_ids(edge_face_id_a,            face_count);
+            validate_ids(edge_face_id_b,            face_count);
+            validate_ids(arrow_vertex_id_from,      vertex_count);
+            validate_ids(arrow_vertex_id_to,        vertex_count);
+            validate_ids(arrow_face_id_a,           face_count);
+            validate_ids(arrow_face_id_b,           face_count);
+            for (std::size_t i=0; i<face_count; i++)
+            {
+                if (face_vertex_ids[i] != glm::vec<3,Tid,glm::defaultp>(face_vertex_id_a[i], face_vertex_id_b[i], face_vertex_id_c[i]))
+                {
+                    throw std::runtime_error("Structure has face vertex ids that disagree with one another");
+                }
+            }
+            for (std::size_t i=0; i<edge_count; i++)
+            {
+                if (edge_vertex_ids[i] != glm::vec<2,Tid,glm::defaultp>(edge_vertex_id_a[i], edge_vertex_id_b[i]) ||
+                    edge_face_ids[i]   != glm::vec<2,Tid,glm::defaultp>(edge_face_id_a[i],   edge_face_id_b[i]))
+                {
+                    throw std::runtime_error("Structure has edge ids that disagree with one another");
+                }
+            }
+            for (std::size_t i=0; i<arrow_count; i++)
+            {
+                if (arrow_vertex_ids[i] != glm::vec<2,Tid,glm::defaultp>(arrow_vertex_id_from[i], arrow_vertex_id_to[i]) ||
+                    arrow_face_ids[i]   != glm::vec<2,Tid,glm::defaultp>(arrow_face_id_a[i],      arrow_face_id_b[i]))
+                {
+                    throw std::runtime_error("Structure has arrow ids that disagree with one another");
+                }
+            }
+            if (vertex_neighbor_offsets[0] != 0 || std::size_t(vertex_neighbor_offsets[vertex_count]) != arrow_count)
+            {
+                throw std::runtime_error("Structure has neighbor offsets that do not span its arrows");
+            }
+            for (std::size_t i=0; i<vertex_count; i++)
+            {
+                if (vertex_neighbor_offsets[i+1] < vertex_neighbor_offsets[i] || 
+                    vertex_neighbor_counts[i] != vertex_neighbor_offsets[i+1] - vertex_neighbor_offsets[i])
+                {
+                    throw std::runtime_error("Structure has neighbor offsets that disagree with its neighbor counts");
+                }
+            }
+        }
+
+    public:
+        /*
+        Reads a structure that was previously stored using `write()`, see "series/binary.hpp".
+        Input is validated before it is used, so a file that is truncated or corrupted results in a `std::runtime_error`,
+        rather than a structure whose ids refer to elements that do not exist.
+        */
+        explicit Structure(series::BinaryReader& reader):
+            Structure(read_counts(reader))
+        {
+            for_each_series(*this, [&reader](auto& a){ 
+                const std::size_t expected_size = a.size();
+                reader.read(a); 
+                if (a.size() != expected_size)
+                {
+                    throw std::runtime_error("Structure does not have the expected number of elements");
+                }
+            });
+            validate();
+        }
+
+        void write(series::BinaryWriter& writer) const
+        {
+            writer.write(std::array<std::uint64_t,3>{vertex_count, face_count, edge_count});
+            for_each_series(*this, [&writer](const auto& a){ writer.write(a); });
+        }
+
+        explicit Structure(const std::size_t vertex_count, const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces):
+            Structure(vertex_count, faces, SortedArrowConstruction())
+        {
+        }
+
+        explicit Structure(const std::size_t vertex_count, const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces, const SortedArrowConstruction tag):
+            Structure(vertex_count, faces.size(), 0)
+        {
+            store_faces(faces);
+
+            // Step 1: store every side of every face as a key that packs its vertex ids, smallest id first, 
+            //  then sort the keys so that sides of the same edge are adjacent, 
+            //  and edges are ordered the same way as they would be for `HashedArrowConstruction`
+            const std::uint64_t V = vertex_count;
+            std::vector<std::uint64_t> side_keys;
+            std::vector<Tid>           side_face_ids;
+            side_keys    .reserve(3*face_count);
+            side_face_ids.reserve(3*face_count);
+            for (std::size_t i=0; i<face_vertex_ids.size(); i++)
+            {
+                const glm::vec<3,Tid,glm::defaultp> face = face_vertex_ids[i];
+                const Tid sides[3][2] = {{face.x, face.y}, {face.y, face.z}, {face.z, face.x}};
+                for (std::size_t j=0; j<3; j++)
+                {
+                    const std::uint64_t a = std::min(sides[j][0], sides[j][1]);
+                    const std::uint64_t b = std::max(sides[j][0], sides[j][1]);
+                    assert(b < V);
+                    if (a != b)
+                    {
+                        side_keys    .push_back(a*V + b);
+                        side_face_ids.push_back(Tid(i));
+                    }
+                }
+            }
+            sort_keys(side_keys, side_face_ids, V*V);
+            // ^^^ NOTE: since face ids are inserted in order and the sort is stable, 
+            // the faces that share an edge will be listed in ascending order
+
+            // Step 2: each run of equal keys represents an edge, and each edge is represented by two arrows, 
+            //  the arrow that departs from the smallest vertex id comes first
+            std::size_t run_count = 0;
+            for (std::size_t i=0; i<side_keys.size(); i++)
+            {
+                run_count += i == 0 || side_keys[i] != side_keys[i-1];
+            }
+            edge_vertex_ids .vector().reserve(run_count);
+            edge_face_ids   .vector().reserve(run_count);
+            arrow_vertex_ids.vector().reserve(2*run_count);
+            arrow_face_ids  .vector().reserve(2*run_count);
+            for (std::size_t i=0, j=0; i<side_keys.size(); i=j)
+            {
+                for (j=i; j<side_keys.size() && side_keys[j] == side_keys[i]; j++) {}
+                const Tid a = Tid(side_keys[i] / V);
+                const Tid b = Tid(side_keys[i] % V);
+                const glm::vec<2,Tid,glm::defaultp> face_ids = j-i == 2? 
+                    glm::vec<2,Tid,glm::defaultp>(side_face_ids[i], side_face_ids[i+1]) : glm::vec<2,Tid,glm::defaultp>(0);
+                edge_vertex_ids .vector().emplace_back(a, b);
+                edge_face_ids   .vector().push_back(face_ids);
+                arrow_vertex_ids.vector().emplace_back(a, b);
+                arrow_vertex_ids.vector().emplace_back(b, a);
+                arrow_face_ids  .vector().push_back(face_ids);
+                arrow_face_ids  .vector().push_back(face_ids);
+            }
+
+            resize_edges_and_arrows();
+            store_edge_and_arrow_components();
+        }
+
+        explicit Structure(const std::size_t vertex_count, const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces, const HashedArrowConstruction tag):
+            Structure(vertex_count, faces.size(), 0)
+        {
+            store_faces(faces);
 
             // Step 1: generate arrows from faces
             std::unordered_set<glm::vec<2,Tid,glm::defaultp>> arrow_vertex_ids_set;
@@ -173,22 +514,7 @@ namespace rasters
                 [](glm::vec<2,Tid,glm::defaultp> a){return a.y > a.x;}
             );
 
-            edge_count = edge_vertex_ids.size();
-
-            edge_vertex_id_a       .vector().resize(edge_count);
-            edge_vertex_id_b       .vector().resize(edge_count);
-            edge_face_ids          .vector().resize(edge_count);
-            edge_face_id_a         .vector().resize(edge_count);
-            edge_face_id_b         .vector().resize(edge_count);
-            
-            arrow_count = arrow_vertex_ids.size();
-
-            arrow_vertex_id_from   .vector().resize(2*edge_count);
-            arrow_vertex_id_to     .vector().resize(2*edge_count);
-            arrow_face_ids         .vector().resize(2*edge_count);
-            arrow_face_id_a        .vector().resize(2*edge_count);
-            arrow_face_id_b        .vector().resize(2*edge_count);
-
+            resize_edges_and_arrows();
 
             // generate arrow_face_ids and edge_face_ids
             std::unordered_set<Tid> face_ids_set;
@@ -209,18 +535,7 @@ namespace rasters
                 }
             }
 
-            get_x   (edge_vertex_ids,                      edge_vertex_id_a);
-            get_y   (edge_vertex_ids,                      edge_vertex_id_b);
-            get_x   (edge_face_ids,                        edge_face_id_a  );
-            get_y   (edge_face_ids,                        edge_face_id_b  );
-
-            get_x   (arrow_vertex_ids,                        arrow_vertex_id_from); 
-            get_y   (arrow_vertex_ids,                        arrow_vertex_id_to );
-            get_x   (arrow_face_ids,                          arrow_face_id_a    );
-            get_y   (arrow_face_ids,                          arrow_face_id_b    );
-
-            fill    (vertex_neighbor_counts, Tid(0));
-            aggregate_into(arrow_vertex_id_from, [](Tid a){ return a+1; }, vertex_neighbor_counts);
+            store_edge_and_arrow_components();
         }
     };
 }
\ No newline at end of file
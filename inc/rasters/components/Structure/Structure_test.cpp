@@ -1,5 +1,9 @@
 
 
+// std libraries
+#include <array>      // std::array
+#include <algorithm>  // std::sort
+
 // 3rd party libraries
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include "catch/catch.hpp"
@@ -23,7 +27,9 @@ TEST_CASE( "Structure correctness", "[Structure]" ) {
         CHECK(diamond_structure.flattened_face_vertex_ids.size() == 12);
 
         CHECK(diamond_structure.vertex_count == 5);
-        // CHECK(diamond_structure.vertex_neighbor_ids.size() == 5);
+        CHECK(diamond_structure.vertex_neighbor_offsets.size() == 6);
+        CHECK(diamond_structure.vertex_neighbor_ids.size() == 16);
+        CHECK(diamond_structure.vertex_neighbor_arrow_ids.size() == 16);
         CHECK(diamond_structure.vertex_neighbor_counts.size() == 5);
         // CHECK(diamond_structure.vertex_average_area.size() == );
 
@@ -59,7 +65,9 @@ TEST_CASE( "Structure nontriviality", "[Structure]" ) {
     SECTION("Structure attributes must contain nonzero elements"){
         CHECK(series::sum(series::abs(tetrahedron_structure.flattened_face_vertex_ids)) > 0.01f);
 
-        // CHECK(series::sum(series::abs(tetrahedron_structure.vertex_neighbor_ids)) > 0.01f);
+        CHECK(series::sum(series::abs(tetrahedron_structure.vertex_neighbor_offsets)) > 0.01f);
+        CHECK(series::sum(series::abs(tetrahedron_structure.vertex_neighbor_ids)) > 0.01f);
+        CHECK(series::sum(series::abs(tetrahedron_structure.vertex_neighbor_arrow_ids)) > 0.01f);
         CHECK(series::sum(series::abs(tetrahedron_structure.vertex_neighbor_counts)) > 0.01f);
 
         CHECK(series::sum(series::abs(series::get_x(tetrahedron_structure.face_vertex_ids))) > 0.01f);
@@ -84,3 +92,61 @@ TEST_CASE( "Structure nontriviality", "[Structure]" ) {
 
     }
 }
+
+TEST_CASE( "Structure vertex neighbor consistency", "[Structure]" ) {
+    SECTION("Structure must list the neighbors of each vertex in ascending order, alongside the arrows that lead to them"){
+        bool is_consistent = true;
+        for (std::size_t i = 0; i < diamond_structure.vertex_count; ++i)
+        {
+            is_consistent = is_consistent && 
+                diamond_structure.vertex_neighbor_offsets[i+1] - diamond_structure.vertex_neighbor_offsets[i] == 
+                diamond_structure.vertex_neighbor_counts[i];
+            for (std::size_t j = diamond_structure.vertex_neighbor_offsets[i]; j < diamond_structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                unsigned int arrow_id = diamond_structure.vertex_neighbor_arrow_ids[j];
+                is_consistent = is_consistent && 
+                    diamond_structure.arrow_vertex_id_from[arrow_id] == i &&
+                    diamond_structure.arrow_vertex_id_to[arrow_id] == diamond_structure.vertex_neighbor_ids[j] &&
+                    (j == diamond_structure.vertex_neighbor_offsets[i] || diamond_structure.vertex_neighbor_ids[j-1] < diamond_structure.vertex_neighbor_ids[j]);
+            }
+        }
+        CHECK(is_consistent);
+        CHECK(diamond_structure.vertex_neighbor_ids[diamond_structure.vertex_neighbor_offsets[0]] == 1u);
+        CHECK(diamond_structure.vertex_neighbor_offsets[5] == 16u);
+    }
+}
+
+TEST_CASE( "Structure construction consistency", "[Structure]" ) {
+    meshes::mesh icosphere_mesh(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    icosphere_mesh = meshes::subdivide(icosphere_mesh);
+    icosphere_mesh = meshes::subdivide(icosphere_mesh);
+    Structure sorted_structure(icosphere_mesh.vertices.size(), icosphere_mesh.faces, SortedArrowConstruction());
+    Structure hashed_structure(icosphere_mesh.vertices.size(), icosphere_mesh.faces, HashedArrowConstruction());
+
+    // NOTE: arrows that share an edge, and faces that share an arrow, may be listed in either order when hashing
+    auto get_arrows = [](const Structure<unsigned int>& structure) {
+        std::vector<std::array<unsigned int,4>> arrows;
+        for (std::size_t i = 0; i < structure.arrow_count; ++i)
+        {
+            arrows.push_back({
+                structure.arrow_vertex_id_from[i], 
+                structure.arrow_vertex_id_to[i], 
+                std::min(structure.arrow_face_id_a[i], structure.arrow_face_id_b[i]), 
+                std::max(structure.arrow_face_id_a[i], structure.arrow_face_id_b[i])
+            });
+        }
+        std::sort(arrows.begin(), arrows.end());
+        return arrows;
+    };
+
+    SECTION("Structure must produce the same edges, arrows, and faces regardless of how it was constructed"){
+        CHECK(sorted_structure.edge_count == hashed_structure.edge_count);
+        CHECK(sorted_structure.arrow_count == hashed_structure.arrow_count);
+        CHECK(sorted_structure.edge_vertex_id_a == hashed_structure.edge_vertex_id_a);
+        CHECK(sorted_structure.edge_vertex_id_b == hashed_structure.edge_vertex_id_b);
+        CHECK(sorted_structure.vertex_neighbor_counts == hashed_structure.vertex_neighbor_counts);
+        CHECK(get_arrows(sorted_structure) == get_arrows(hashed_structure));
+        CHECK(sorted_structure.vertex_neighbor_offsets == hashed_structure.vertex_neighbor_offsets);
+        CHECK(sorted_structure.vertex_neighbor_ids == hashed_structure.vertex_neighbor_ids);
+    }
+}
@@ -1,3 +1,4 @@
 #include "./SpheroidVoronoi/SpheroidVoronoi_test.hpp"
+#include "./SpheroidVoronoi/CompactSpheroidVoronoi_test.hpp"
 #include "./Structure/Structure_test.cpp"
 #include "./Metrics/Metrics_test.cpp"
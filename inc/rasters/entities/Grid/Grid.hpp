@@ -2,7 +2,8 @@
 
 
 // std libraries
-#include <memory>
+#include <memory>     // std::shared_ptr
+#include <stdexcept>  // std::runtime_error
 
 // 3rd party libraries
 #include <glm/vec3.hpp>               // *vec3
@@ -10,6 +11,8 @@
 // in-house libraries
 #include <series/types.hpp>
 #include <series/glm/types.hpp>
+#include <series/binary.hpp>      // BinaryReader, BinaryWriter
+#include <series/execution.hpp>   // sequenced, parallel, etc.
 
 #include <rasters/components/Metrics/Metrics.hpp>
 #include <rasters/components/Structure/Structure.hpp>
@@ -56,6 +59,8 @@ namespace rasters
 	We instead use shared pointers to alleviate issues we may have with sharing grid component references across many objects,
 	and leverage the exising encapsulation requirements (mentioned above) to further regulate where shared pointers go.
 	The shared pointers are never exposed to code outside the grid classes.
+	Components are `const` once they are constructed, so grids that share a component can never observe each other modifying it,
+	and caches can recognize a component by its address, see "SpheroidGrid/InterpolationCache.hpp".
 	The grid then becomes a small object filled only with smart pointers, 
 	and since we've found this property is useful when creating rasters, 
 	we further go on the offensive to guarantee that the footprint of a Grid class will never exceed 24 bytes.
@@ -64,23 +69,55 @@ namespace rasters
     template<typename Tid=std::uint16_t, typename Tfloat=float>
 	struct Grid
 	{
-		std::shared_ptr<Structure<Tid>> structure;
-		std::shared_ptr<Metrics<Tid,Tfloat>> metrics;
+		std::shared_ptr<const Structure<Tid>> structure;
+		std::shared_ptr<const Metrics<Tid,Tfloat>> metrics;
 
         using size_type = Tid;
         using value_type = Tfloat;
         
 		Grid(
 			const series::Series<glm::vec<3,Tfloat,glm::defaultp>>& vertices, 
-			const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces
+			const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces,
+			const unsigned int metric_attributes = rasters::metric_attributes::all
+		):
+			Grid(series::sequenced, vertices, faces, metric_attributes)
+		{}
+		/*
+		Components that support execution policies are built according to `policy`, see "series/execution.hpp".
+		*/
+		template<typename Tpolicy, std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+		Grid(
+			const Tpolicy policy,
+			const series::Series<glm::vec<3,Tfloat,glm::defaultp>>& vertices, 
+			const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces,
+			const unsigned int metric_attributes = rasters::metric_attributes::all
 		):
 			structure(std::make_shared<Structure<Tid>>(vertices.size(), faces)),
-			metrics(std::make_shared<Metrics<Tid,Tfloat>>(vertices, *structure))
+			metrics(std::make_shared<Metrics<Tid,Tfloat>>(policy, vertices, *structure, metric_attributes))
 		{}
+		/*
+		Reads a grid that was previously stored using `write()`, see "binary.hpp".
+		*/
+		explicit Grid(series::BinaryReader& reader):
+			structure(std::make_shared<Structure<Tid>>(reader)),
+			metrics(std::make_shared<Metrics<Tid,Tfloat>>(reader))
+		{
+			if (metrics->vertex_positions.size() != structure->vertex_count ||
+				metrics->face_midpoints.size()   != structure->face_count ||
+				metrics->edge_midpoints.size()   != structure->edge_count)
+			{
+				throw std::runtime_error("Grid has metrics that do not match its structure");
+			}
+		}
 		Grid(const Grid<Tid,Tfloat>& grid):
 			structure(grid.structure),
 			metrics(grid.metrics)
 		{}
+		void write(series::BinaryWriter& writer) const
+		{
+			structure->write(writer);
+			metrics->write(writer);
+		}
 		const std::size_t cell_count(mapping mapping_type) const
 		{
 			return mapping_type == mapping::cell? this->structure->vertex_count : this->structure->arrow_count;
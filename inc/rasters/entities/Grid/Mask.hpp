@@ -0,0 +1,241 @@
+#pragma once
+
+// C libraries
+#include <assert.h>     /* assert */
+
+// std libraries
+#include <algorithm>    // std::fill
+#include <bitset>       // std::bitset
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <type_traits>  // std::false_type, std::true_type, std::is_base_of
+#include <vector>       // std::vector
+
+// in-house libraries
+#include <series/execution.hpp>
+
+#include "Raster.hpp"
+
+namespace rasters
+{
+
+	/*
+	`count_bits()` returns the number of bits that are set within a word, 
+	and `count_trailing_zeros()` returns the index of the lowest bit that is set within a nonzero word.
+	They use the instructions of the host where the compiler exposes them, and `std::bitset` otherwise.
+	*/
+	inline std::size_t count_bits(const std::uint64_t word)
+	{
+	#if defined(__GNUC__)
+		return __builtin_popcountll(word);
+	#else
+		return std::bitset<64>(word).count();
+	#endif
+	}
+	inline std::size_t count_trailing_zeros(const std::uint64_t word)
+	{
+		assert(word != 0);
+	#if defined(__GNUC__)
+		return __builtin_ctzll(word);
+	#else
+		return std::bitset<64>(~word & (word - 1)).count();
+	#endif
+	}
+
+	/*
+	`Mask` maps each cell in a grid to a boolean, like `Raster<bool,Tgrid>`,
+	but it stores its values explicitly as 64 bit words, where cell `i` is stored as bit `i%64` of word `i/64`.
+	`Raster<bool,Tgrid>` is backed by `std::vector<bool>`, whose proxy references must be resolved one element at a time,
+	whereas the functions of "Mask.hpp" operate on a whole word at a time:
+	boolean algebra visits each word once with loops that the compiler can vectorize,
+	and `count()` is a sum of population counts, see `count_bits()`.
+	See "morphologic.hpp" for morphology on masks.
+
+	Bits of the last word that do not correspond to a cell are always zero,
+	so that words can be compared and counted without treating the last word as a special case.
+	*/
+	template<typename Tgrid>
+	struct Mask
+	{
+		typedef std::uint64_t word_type;
+		static constexpr std::size_t WORD_BIT_COUNT = 64;
+
+		Tgrid grid;
+		std::vector<word_type> words;
+
+		explicit Mask(const Tgrid& grid, const bool value = false):
+			grid(grid),
+			words((grid.cell_count(mapping::cell) + WORD_BIT_COUNT - 1) / WORD_BIT_COUNT, value? ~word_type(0) : word_type(0)),
+			bit_count(grid.cell_count(mapping::cell))
+		{
+			clear_padding();
+		}
+		explicit Mask(const Raster<bool,Tgrid>& a):
+			Mask(a.grid)
+		{
+			for (std::size_t i = 0; i < a.size(); ++i)
+			{
+				words[i / WORD_BIT_COUNT] |= word_type(a[i]) << (i % WORD_BIT_COUNT);
+			}
+		}
+
+		inline std::size_t size() const       { return bit_count; }
+		inline std::size_t word_count() const { return words.size(); }
+
+		inline bool operator[](const std::size_t i) const
+		{
+			assert(i < bit_count);
+			return (words[i / WORD_BIT_COUNT] >> (i % WORD_BIT_COUNT)) & word_type(1);
+		}
+		inline void set(const std::size_t i, const bool value)
+		{
+			assert(i < bit_count);
+			const word_type bit = word_type(1) << (i % WORD_BIT_COUNT);
+			words[i / WORD_BIT_COUNT] = value? words[i / WORD_BIT_COUNT] | bit : words[i / WORD_BIT_COUNT] & ~bit;
+		}
+		// stores the value of each cell in `out`
+		void store(Raster<bool,Tgrid>& out) const
+		{
+			assert(out.size() == bit_count);
+			for (std::size_t i = 0; i < bit_count; ++i)
+			{
+				out[i] = (*this)[i];
+			}
+		}
+
+		// sets bits of the last word that do not correspond to a cell to zero
+		inline void clear_padding()
+		{
+			const std::size_t remainder = bit_count % WORD_BIT_COUNT;
+			if (remainder > 0)
+			{
+				words.back() &= (word_type(1) << remainder) - 1;
+			}
+		}
+
+	private:
+		std::size_t bit_count;
+	};
+
+	/*
+	`is_mask<T>` is true for any type that maps each cell to a boolean, i.e. `Mask` or `Raster<bool>` and its derivatives,
+	so that morphology can be written once for either, see "morphologic.hpp".
+	*/
+	template<typename T>
+	struct is_Mask : std::false_type {};
+	template<typename Tgrid>
+	struct is_Mask<Mask<Tgrid>> : std::true_type {};
+	template<typename T>
+	constexpr bool is_mask = is_Mask<T>::value || std::is_base_of<series::Series<bool>, T>::value;
+
+	template<typename Tgrid>
+	Mask<Tgrid> make_Mask(const Tgrid& grid, const bool value = false)
+	{
+		return Mask<Tgrid>(grid, value);
+	}
+
+	// returns the number of cells that are set, i.e. the equivalent of `series::sum()` for `Raster<bool>`
+	template<typename Tgrid>
+	std::size_t count(const Mask<Tgrid>& a)
+	{
+		std::size_t out = 0;
+		for (const typename Mask<Tgrid>::word_type word : a.words)
+		{
+			out += count_bits(word);
+		}
+		return out;
+	}
+
+	template<typename Tgrid>
+	bool equal(const Mask<Tgrid>& a, const Mask<Tgrid>& b)
+	{
+		return a.words == b.words;
+	}
+
+	template<typename Tgrid>
+	void copy(Mask<Tgrid>& out, const Mask<Tgrid>& a)
+	{
+		assert(out.word_count() == a.word_count());
+		out.words = a.words;
+	}
+
+	template<typename Tgrid>
+	void fill(Mask<Tgrid>& out, const bool value)
+	{
+		std::fill(out.words.begin(), out.words.end(), value? ~typename Mask<Tgrid>::word_type(0) : typename Mask<Tgrid>::word_type(0));
+		out.clear_padding();
+	}
+
+	/*
+	`unite()`, `intersect()`, `differ()`, and `negate()` mirror the functions of "series/morphologic.hpp",
+	and are run word by word according to `policy`, see "series/execution.hpp".
+	*/
+	template<typename Tpolicy, typename Tgrid, typename F,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void store_words(const Tpolicy policy, const F f, const Mask<Tgrid>& a, const Mask<Tgrid>& b, Mask<Tgrid>& out)
+	{
+		assert(a.word_count() == out.word_count());
+		assert(b.word_count() == out.word_count());
+		typedef typename Mask<Tgrid>::word_type word_type;
+		const word_type* a_words = a.words.data();
+		const word_type* b_words = b.words.data();
+		word_type* out_words = out.words.data();
+		series::for_each_id(policy, out.word_count(), [&](const std::size_t i) {
+			out_words[i] = f(a_words[i], b_words[i]);
+		});
+	}
+
+	template<typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void unite(const Tpolicy policy, const Mask<Tgrid>& a, const Mask<Tgrid>& b, Mask<Tgrid>& out)
+	{
+		typedef typename Mask<Tgrid>::word_type word_type;
+		store_words(policy, [](const word_type ai, const word_type bi){ return ai | bi; }, a, b, out);
+	}
+	template<typename Tgrid>
+	void unite(const Mask<Tgrid>& a, const Mask<Tgrid>& b, Mask<Tgrid>& out)
+	{
+		unite(series::sequenced, a, b, out);
+	}
+
+	template<typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void intersect(const Tpolicy policy, const Mask<Tgrid>& a, const Mask<Tgrid>& b, Mask<Tgrid>& out)
+	{
+		typedef typename Mask<Tgrid>::word_type word_type;
+		store_words(policy, [](const word_type ai, const word_type bi){ return ai & bi; }, a, b, out);
+	}
+	template<typename Tgrid>
+	void intersect(const Mask<Tgrid>& a, const Mask<Tgrid>& b, Mask<Tgrid>& out)
+	{
+		intersect(series::sequenced, a, b, out);
+	}
+
+	template<typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void differ(const Tpolicy policy, const Mask<Tgrid>& a, const Mask<Tgrid>& b, Mask<Tgrid>& out)
+	{
+		typedef typename Mask<Tgrid>::word_type word_type;
+		store_words(policy, [](const word_type ai, const word_type bi){ return ai & ~bi; }, a, b, out);
+	}
+	template<typename Tgrid>
+	void differ(const Mask<Tgrid>& a, const Mask<Tgrid>& b, Mask<Tgrid>& out)
+	{
+		differ(series::sequenced, a, b, out);
+	}
+
+	template<typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void negate(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out)
+	{
+		typedef typename Mask<Tgrid>::word_type word_type;
+		store_words(policy, [](const word_type ai, const word_type){ return ~ai; }, a, a, out);
+		out.clear_padding();
+	}
+	template<typename Tgrid>
+	void negate(const Mask<Tgrid>& a, Mask<Tgrid>& out)
+	{
+		negate(series::sequenced, a, out);
+	}
+
+}
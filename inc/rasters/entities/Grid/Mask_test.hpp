@@ -0,0 +1,165 @@
+
+// std libraries
+#include <bitset>    // std::bitset
+#include <random>    // std::mt19937
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch/catch.hpp"
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/types.hpp>  
+#include <series/morphologic.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+
+#include "Grid.hpp"
+#include "Raster.hpp"
+#include "Mask.hpp"
+#include "morphologic.hpp"
+
+// returns whether `a` and `b` store the same value for each cell
+template<typename Tgrid>
+bool is_match(const rasters::Mask<Tgrid>& a, const rasters::Raster<bool,Tgrid>& b)
+{
+    rasters::Raster<bool,Tgrid> a_raster(a.grid);
+    a.store(a_raster);
+    bool out = a_raster.size() == b.size();
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        out = out && a_raster[i] == b[i];
+    }
+    return out;
+}
+
+TEST_CASE( "Mask consistency", "[rasters]" ) {
+    // 642 vertices, so that the last word is partially filled
+    const meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 3, true);
+    const rasters::Grid<uint,float> grid(icosphere.vertices, icosphere.faces);
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    auto noise = rasters::make_Raster<bool>(grid);
+    auto region = rasters::make_Raster<bool>(grid);
+    for (std::size_t i = 0; i < noise.size(); ++i)
+    {
+        noise[i] = uniform(generator) < 0.5f;
+        region[i] = glm::dot(grid.metrics->vertex_positions[i], glm::vec3(1,2,3)) > 0.5f;
+    }
+    const rasters::Mask<rasters::Grid<uint,float>> noise_mask(noise);
+    const rasters::Mask<rasters::Grid<uint,float>> region_mask(region);
+    auto expected = rasters::make_Raster<bool>(grid);
+    auto out = rasters::make_Mask(grid);
+
+    SECTION("Mask must store the same values as the Raster it is constructed from"){
+        CHECK(is_match(noise_mask, noise));
+        std::size_t expected_count = 0;
+        for (std::size_t i = 0; i < noise.size(); ++i)
+        {
+            expected_count += noise[i];
+        }
+        CHECK(rasters::count(noise_mask) == expected_count);
+    }
+    SECTION("Mask boolean algebra must produce the same output as Raster<bool> boolean algebra"){
+        series::unite(noise, region, expected);
+        rasters::unite(noise_mask, region_mask, out);
+        CHECK(is_match(out, expected));
+        series::intersect(noise, region, expected);
+        rasters::intersect(noise_mask, region_mask, out);
+        CHECK(is_match(out, expected));
+        series::differ(noise, region, expected);
+        rasters::differ(noise_mask, region_mask, out);
+        CHECK(is_match(out, expected));
+        series::negate(noise, expected);
+        rasters::negate(noise_mask, out);
+        CHECK(is_match(out, expected));
+        CHECK(rasters::count(out) == noise.size() - rasters::count(noise_mask));
+    }
+    SECTION("Mask morphology must produce the same output as Raster<bool> morphology"){
+        for (const auto& pair : {std::make_pair(&noise, &noise_mask), std::make_pair(&region, &region_mask)})
+        {
+            const auto& a = *pair.first;
+            const auto& a_mask = *pair.second;
+            rasters::dilate(a, expected);
+            rasters::dilate(a_mask, out);
+            CHECK(is_match(out, expected));
+            rasters::erode(a, expected);
+            rasters::erode(a_mask, out);
+            CHECK(is_match(out, expected));
+            rasters::dilate(a, expected, 3);
+            rasters::dilate(a_mask, out, 3);
+            CHECK(is_match(out, expected));
+            rasters::erode(a, expected, 2);
+            rasters::erode(a_mask, out, 2);
+            CHECK(is_match(out, expected));
+            rasters::opening(a, expected, 2);
+            rasters::opening(a_mask, out, 2);
+            CHECK(is_match(out, expected));
+            rasters::closing(a, expected, 2);
+            rasters::closing(a_mask, out, 2);
+            CHECK(is_match(out, expected));
+            rasters::margin(a, expected, 2);
+            rasters::margin(a_mask, out, 2);
+            CHECK(is_match(out, expected));
+            rasters::padding(a, expected, 2);
+            rasters::padding(a_mask, out, 2);
+            CHECK(is_match(out, expected));
+            rasters::white_top_hat(a, expected);
+            rasters::white_top_hat(a_mask, out);
+            CHECK(is_match(out, expected));
+            rasters::black_top_hat(a, expected);
+            rasters::black_top_hat(a_mask, out);
+            CHECK(is_match(out, expected));
+        }
+    }
+    SECTION("Mask morphology must produce the same output regardless of policy"){
+        auto parallel_out = rasters::make_Mask(grid);
+        rasters::dilate(noise_mask, out);
+        rasters::dilate(series::ParallelPolicy(4, 2), noise_mask, parallel_out);
+        CHECK(rasters::equal(out, parallel_out));
+        rasters::erode(noise_mask, out);
+        rasters::erode(series::ParallelPolicy(4, 2), noise_mask, parallel_out);
+        CHECK(rasters::equal(out, parallel_out));
+        for (uint radius = 0; radius <= 3; ++radius)
+        {
+            rasters::dilate(noise_mask, out, radius);
+            rasters::dilate(series::ParallelPolicy(4, 2), noise_mask, parallel_out, radius);
+            CHECK(rasters::equal(out, parallel_out));
+            rasters::erode(noise_mask, out, radius);
+            rasters::erode(series::ParallelPolicy(4, 2), noise_mask, parallel_out, radius);
+            CHECK(rasters::equal(out, parallel_out));
+        }
+        rasters::opening(region_mask, out);
+        rasters::opening(series::ParallelPolicy(4, 2), region_mask, parallel_out);
+        CHECK(rasters::equal(out, parallel_out));
+        rasters::opening(region_mask, out, 2);
+        rasters::opening(series::ParallelPolicy(4, 2), region_mask, parallel_out, 2);
+        CHECK(rasters::equal(out, parallel_out));
+        rasters::closing(region_mask, out);
+        rasters::closing(series::ParallelPolicy(4, 2), region_mask, parallel_out);
+        CHECK(rasters::equal(out, parallel_out));
+        rasters::closing(region_mask, out, 2);
+        rasters::closing(series::ParallelPolicy(4, 2), region_mask, parallel_out, 2);
+        CHECK(rasters::equal(out, parallel_out));
+    }
+}
+
+TEST_CASE( "Mask bit counting", "[rasters]" ) {
+    std::mt19937 generator(3);
+    SECTION("count_bits() and count_trailing_zeros() must match std::bitset for any word"){
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            const std::uint64_t word = (std::uint64_t(generator()) << 32 | generator()) >> (i % 64);
+            CHECK(rasters::count_bits(word) == std::bitset<64>(word).count());
+            if (word != 0)
+            {
+                std::size_t trailing_zeros = 0;
+                while (((word >> trailing_zeros) & 1) == 0) { ++trailing_zeros; }
+                CHECK(rasters::count_trailing_zeros(word) == trailing_zeros);
+            }
+        }
+        CHECK(rasters::count_bits(~std::uint64_t(0)) == 64);
+        CHECK(rasters::count_trailing_zeros(std::uint64_t(1) << 63) == 63);
+    }
+}
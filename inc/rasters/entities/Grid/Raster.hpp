@@ -3,6 +3,7 @@
 
 // std libraries
 #include <memory>
+#include <type_traits>   // std::enable_if_t, std::is_base_of
 
 // 3rd party libraries
 #include <glm/vec3.hpp>               // *vec3
@@ -86,6 +87,15 @@ namespace rasters
 			}
 		}
 
+		// expression assignment, see series/expression.hpp
+		template <typename Texpression, std::enable_if_t<std::is_base_of<series::AbstractExpression, Texpression>::value, int> = 0>
+		Raster<T,Tgrid,Tmap>& operator=(const Texpression& a)
+		{
+			assert(a.size() == this->size());
+			series::Series<T>::operator=(a);
+			return *this;
+		}
+
 
 	};
 	
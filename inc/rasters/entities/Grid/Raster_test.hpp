@@ -6,6 +6,9 @@
 
 #define GLM_FORCE_PURE      // disable SIMD support for glm so we can work with webassembly
 
+#include <series/operators.hpp>  
+#include <series/expression.hpp>  
+
 #include "Raster.hpp"  
 
 using namespace rasters;
@@ -17,4 +20,20 @@ TEST_CASE( "Raster consistency", "[rasters]" ) {
         CHECK(a.size() == a.grid.cell_count(rasters::mapping::cell) );
         CHECK(b.size() == b.grid.cell_count(rasters::mapping::arrow) );
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Raster expression assignment", "[rasters]" ) {
+    auto a = make_Raster<float>(tetrahedron_grid);
+    auto b = make_Raster<float>(tetrahedron_grid);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = float(i);
+        b[i] = float(i*i);
+    }
+    SECTION("Assigning an expression to a Raster must produce the same values as eager operators, and retain the grid"){
+        auto c = make_Raster<float>(tetrahedron_grid);
+        c = series::lazy(a) * 2.0f + b;
+        CHECK(c == a * 2.0f + b);
+        CHECK(c.size() == c.grid.cell_count(rasters::mapping::cell));
+    }
+}
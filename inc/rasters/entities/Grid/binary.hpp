@@ -0,0 +1,85 @@
+#pragma once
+
+// std libraries
+#include <array>        // std::array
+#include <cstdint>      // std::uint32_t
+#include <cstring>      // std::memcmp
+#include <fstream>      // std::ofstream
+#include <stdexcept>    // std::runtime_error
+#include <string>       // std::string
+
+// in-house libraries
+#include <series/binary.hpp>  // BinaryReader, BinaryWriter, MappedFile
+
+#include "Grid.hpp"
+
+namespace rasters
+{
+	/*
+	"binary.hpp" stores grids in files so that they can be loaded at startup instead of being rebuilt from a mesh.
+
+	A file starts with a header that identifies the format, its version, the kind of grid that it stores,
+	and the sizes of the id and floating point types of the grid.
+	The header is followed by the components of the grid, see "series/binary.hpp" for how they are laid out.
+	`load()` maps the file into memory and copies each component out of the mapping without parsing it.
+	Components own their series, so the mapping is released once the grid is loaded.
+	This means loading still allocates and copies the full size of the file, and each process that loads a grid holds its own copy,
+	but it avoids the far larger cost of rebuilding the structure, metrics, and lookups from a mesh.
+	Loading fails with an exception if the header does not match the grid that is requested,
+	or if the components are not consistent with one another, such as an id that refers to a vertex that does not exist.
+	The version must be incremented whenever the layout of a component changes.
+	*/
+
+	constexpr std::uint32_t grid_file_version = 2;
+
+	/*
+	`grid_file_kind` identifies the type of grid that is stored within a file.
+	*/
+	template<typename Tgrid>
+	struct grid_file_kind {};
+	template<typename Tid, typename Tfloat>
+	struct grid_file_kind<Grid<Tid,Tfloat>> { static constexpr std::uint32_t value = 1; };
+
+	template<typename Tgrid>
+	void save(const std::string& path, const Tgrid& grid)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			throw std::runtime_error("could not open " + path);
+		}
+		series::BinaryWriter writer(file);
+		writer.write(std::array<char,8>{'R','A','S','T','E','R','S','\0'});
+		writer.write(std::array<std::uint32_t,4>{
+			grid_file_version, 
+			grid_file_kind<Tgrid>::value, 
+			std::uint32_t(sizeof(typename Tgrid::size_type)), 
+			std::uint32_t(sizeof(typename Tgrid::value_type))
+		});
+		grid.write(writer);
+	}
+
+	template<typename Tgrid>
+	Tgrid load(const std::string& path)
+	{
+		const series::MappedFile file(path);
+		series::BinaryReader reader = file.reader();
+		const std::array<char,8> magic = reader.read<std::array<char,8>>();
+		if (std::memcmp(magic.data(), "RASTERS", 8) != 0)
+		{
+			throw std::runtime_error(path + " is not a grid file");
+		}
+		const std::array<std::uint32_t,4> header = reader.read<std::array<std::uint32_t,4>>();
+		if (header[0] != grid_file_version)
+		{
+			throw std::runtime_error(path + " was stored using an unsupported version of the grid file format");
+		}
+		if (header[1] != grid_file_kind<Tgrid>::value || 
+			header[2] != sizeof(typename Tgrid::size_type) || 
+			header[3] != sizeof(typename Tgrid::value_type))
+		{
+			throw std::runtime_error(path + " does not store the type of grid that was requested");
+		}
+		return Tgrid(reader);
+	}
+}
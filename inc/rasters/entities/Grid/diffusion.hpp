@@ -0,0 +1,157 @@
+#pragma once
+
+// std libraries
+#include <cstddef>      // std::size_t
+#include <type_traits>  // std::enable_if_t
+
+// in-house libraries
+#include <series/execution.hpp>
+#include <series/conjugate_gradient.hpp>
+
+#include "Raster.hpp"
+
+/*
+"diffusion.hpp" solves diffusion implicitly, so that diffusion can be stepped with timesteps far beyond the stability limit of
+an explicit step using `laplacian()` from "vector_calculus.hpp".
+A backward Euler step of `∂x/∂t = α∇²x` over a timestep `Δt` requires solving:
+
+    (I - cL) x = b,    where c = αΔt
+
+`L` is the laplacian of "vector_calculus.hpp", and `b` is the field at the start of the timestep.
+`L` is not symmetric since each row is divided by the dual area of its vertex, `Aᵢ`,
+but multiplying both sides by `Aᵢ` produces an equivalent system that is symmetric positive definite:
+
+    Aᵢxᵢ - c ∑ⱼ wᵢⱼ(xⱼ - xᵢ) = Aᵢbᵢ,    where wᵢⱼ = dual length / length of the arrow from i to j
+
+This is the system that is solved by `series::conjugate_gradient()`, see "series/conjugate_gradient.hpp".
+The system never needs to be assembled, since each row is calculated from `Metrics` as it is needed.
+The symmetric form also conserves the total of `Aᵢxᵢ`, so no mass is lost to diffusion regardless of timestep.
+*/
+
+namespace rasters
+{
+    /*
+    `implicit_diffusion_operator()` stores the left hand side of the symmetric system for `x` in `out`,
+    i.e. `Aᵢxᵢ - c ∑ⱼ wᵢⱼ(xⱼ - xᵢ)`.
+    */
+    template<typename Tpolicy, typename T, typename Tgrid,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void implicit_diffusion_operator(
+        const Tpolicy policy,
+        const Raster<T, Tgrid>& x,
+        const T coefficient,
+        Raster<T, Tgrid>& out
+    ) {
+        const auto& metrics = *x.grid.metrics;
+        const auto& structure = *x.grid.structure;
+        series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+            T flow(0);
+            for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                flow += (x[structure.vertex_neighbor_ids[j]] - x[i]) * metrics.arrow_dual_lengths[arrow_id] / metrics.arrow_lengths[arrow_id];
+            }
+            out[i] = metrics.vertex_dual_areas[i] * x[i] - coefficient * flow;
+        });
+    }
+    template<typename T, typename Tgrid>
+    void implicit_diffusion_operator(
+        const Raster<T, Tgrid>& x,
+        const T coefficient,
+        Raster<T, Tgrid>& out
+    ) {
+        implicit_diffusion_operator(series::sequenced, x, coefficient, out);
+    }
+
+    /*
+    `implicit_diffusion_diagonal()` stores the diagonal of the symmetric system in `out`, i.e. `Aᵢ + c ∑ⱼ wᵢⱼ`.
+    It is used for Jacobi preconditioning and smoothing.
+    */
+    template<typename Tpolicy, typename T, typename Tgrid,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void implicit_diffusion_diagonal(
+        const Tpolicy policy,
+        const T coefficient,
+        Raster<T, Tgrid>& out
+    ) {
+        const auto& metrics = *out.grid.metrics;
+        const auto& structure = *out.grid.structure;
+        series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+            T weight(0);
+            for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                weight += metrics.arrow_dual_lengths[arrow_id] / metrics.arrow_lengths[arrow_id];
+            }
+            out[i] = metrics.vertex_dual_areas[i] + coefficient * weight;
+        });
+    }
+    template<typename T, typename Tgrid>
+    void implicit_diffusion_diagonal(
+        const T coefficient,
+        Raster<T, Tgrid>& out
+    ) {
+        implicit_diffusion_diagonal(series::sequenced, coefficient, out);
+    }
+
+    /*
+    `implicit_diffusion()` stores in `out` the result of diffusing `field` over a single backward Euler step,
+    where `coefficient` is the product of diffusivity and timestep.
+    `field` is used as the initial guess, so small timesteps converge within few iterations.
+
+    `precondition(r, z)` must store an approximation of the solution to the symmetric system for `r` in `z`,
+    where both are rasters on the grid of `field`, and `r` is scaled by dual area as described above.
+    This allows a multigrid cycle to be used in place of the default Jacobi preconditioner.
+    */
+    template<typename Tpolicy, typename T, typename Tgrid, typename Tprecondition,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    series::ConjugateGradientResult implicit_diffusion(
+        const Tpolicy policy,
+        const Raster<T, Tgrid>& field,
+        const T coefficient,
+        Raster<T, Tgrid>& out,
+        const Tprecondition& precondition,
+        const double tolerance,
+        const std::size_t max_iterations
+    ) {
+        const auto& metrics = *field.grid.metrics;
+        Raster<T, Tgrid> b(field.grid);
+        series::for_each_id(policy, field.size(), [&](const std::size_t i) {
+            b[i] = metrics.vertex_dual_areas[i] * field[i];
+            out[i] = field[i];
+        });
+        return series::conjugate_gradient(policy,
+            [&](const Raster<T, Tgrid>& x, Raster<T, Tgrid>& Ax) { implicit_diffusion_operator(policy, x, coefficient, Ax); },
+            precondition, b, out, tolerance, max_iterations);
+    }
+
+    template<typename Tpolicy, typename T, typename Tgrid,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    series::ConjugateGradientResult implicit_diffusion(
+        const Tpolicy policy,
+        const Raster<T, Tgrid>& field,
+        const T coefficient,
+        Raster<T, Tgrid>& out,
+        const double tolerance = 1e-5,
+        const std::size_t max_iterations = 1000
+    ) {
+        Raster<T, Tgrid> diagonal(field.grid);
+        implicit_diffusion_diagonal(policy, coefficient, diagonal);
+        return implicit_diffusion(policy, field, coefficient, out,
+            [&](const Raster<T, Tgrid>& r, Raster<T, Tgrid>& z) {
+                series::for_each_id(policy, r.size(), [&](const std::size_t i) { z[i] = r[i] / diagonal[i]; });
+            },
+            tolerance, max_iterations);
+    }
+
+    template<typename T, typename Tgrid>
+    series::ConjugateGradientResult implicit_diffusion(
+        const Raster<T, Tgrid>& field,
+        const T coefficient,
+        Raster<T, Tgrid>& out,
+        const double tolerance = 1e-5,
+        const std::size_t max_iterations = 1000
+    ) {
+        return implicit_diffusion(series::sequenced, field, coefficient, out, tolerance, max_iterations);
+    }
+}
@@ -0,0 +1,110 @@
+
+// std libraries
+#include <algorithm> // std::max
+#include <cmath>     // std::abs
+#include <random>    // std::mt19937
+
+// 3rd party libraries
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch/catch.hpp"
+
+#define GLM_FORCE_PURE     // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>             // *vec3
+
+// in-house libraries
+#include <series/types.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+#include <series/glm/random.hpp>      // get_elias_noise
+
+#include <meshes/mesh.hpp>
+
+#include "Grid.hpp"
+#include "Raster.hpp"
+#include "vector_calculus.hpp"
+#include "diffusion.hpp"
+
+// returns the sum of a raster weighted by the dual area of each vertex
+template<typename Traster>
+double get_total(const Traster& a)
+{
+    double total = 0;
+    for (unsigned int i = 0; i < a.size(); ++i)
+    {
+        total += a[i] * a.grid.metrics->vertex_dual_areas[i];
+    }
+    return total;
+}
+
+TEST_CASE( "Grid implicit_diffusion() correctness", "[rasters]" ) {
+    const meshes::mesh icosphere = meshes::subdivide(meshes::subdivide(meshes::subdivide(meshes::icosahedron)));
+    const rasters::Grid<uint,float> grid(icosphere.vertices, icosphere.faces);
+    std::mt19937 generator(2);
+    auto field = rasters::make_Raster<float>(grid);
+    series::get_elias_noise(grid.metrics->vertex_positions, generator, field);
+    auto out = rasters::make_Raster<float>(grid);
+
+    SECTION("implicit_diffusion() must produce output that satisfies a backward Euler step of diffusion"){
+        const float coefficient = 0.01f;
+        const auto result = rasters::implicit_diffusion(field, coefficient, out, 1e-6);
+        auto laplacian_out = rasters::make_Raster<float>(grid);
+        rasters::laplacian(out, laplacian_out);
+        float max_error = 0;
+        float max_magnitude = 0;
+        for (unsigned int i = 0; i < out.size(); ++i)
+        {
+            max_error = std::max(max_error, std::abs(out[i] - coefficient * laplacian_out[i] - field[i]));
+            max_magnitude = std::max(max_magnitude, std::abs(field[i]));
+        }
+        CHECK(result.converged);
+        CHECK(max_error / max_magnitude < 1e-3f);
+    }
+    SECTION("implicit_diffusion() must conserve the total of a field"){
+        rasters::implicit_diffusion(field, 1.0f, out, 1e-6);
+        CHECK(get_total(out) == Approx(get_total(field)).epsilon(1e-4));
+    }
+    SECTION("implicit_diffusion() must remain stable for timesteps far beyond the limit of explicit diffusion"){
+        const auto result = rasters::implicit_diffusion(field, 100.0f, out, 1e-6);
+        float field_max = field[0];
+        float field_min = field[0];
+        float out_max = out[0];
+        float out_min = out[0];
+        for (unsigned int i = 0; i < out.size(); ++i)
+        {
+            field_max = std::max(field_max, field[i]);
+            field_min = std::min(field_min, field[i]);
+            out_max = std::max(out_max, out[i]);
+            out_min = std::min(out_min, out[i]);
+        }
+        CHECK(result.converged);
+        CHECK(out_max <= field_max);
+        CHECK(out_min >= field_min);
+        CHECK(out_max - out_min < 0.1f * (field_max - field_min));
+    }
+    SECTION("implicit_diffusion() must produce the same output regardless of policy"){
+        auto parallel_out = rasters::make_Raster<float>(grid);
+        const auto result = rasters::implicit_diffusion(field, 0.1f, out, 1e-6);
+        const auto parallel_result = rasters::implicit_diffusion(series::ParallelPolicy(4, 16), field, 0.1f, parallel_out, 1e-6);
+        float max_difference = 0;
+        for (unsigned int i = 0; i < out.size(); ++i)
+        {
+            max_difference = std::max(max_difference, std::abs(out[i] - parallel_out[i]));
+        }
+        CHECK(result.iteration_count == parallel_result.iteration_count);
+        CHECK(max_difference < 1e-4f);
+    }
+    SECTION("implicit_diffusion() must accept any symmetric positive definite preconditioner"){
+        auto unpreconditioned_out = rasters::make_Raster<float>(grid);
+        const auto identity = [](const rasters::Raster<float, rasters::Grid<uint,float>>& r, rasters::Raster<float, rasters::Grid<uint,float>>& z) {
+            for (unsigned int i = 0; i < r.size(); ++i) { z[i] = r[i]; }
+        };
+        rasters::implicit_diffusion(series::sequenced, field, 1.0f, out, 1e-6, 1000);
+        const auto result = rasters::implicit_diffusion(series::sequenced, field, 1.0f, unpreconditioned_out, identity, 1e-6, 1000);
+        float max_difference = 0;
+        for (unsigned int i = 0; i < out.size(); ++i)
+        {
+            max_difference = std::max(max_difference, std::abs(out[i] - unpreconditioned_out[i]));
+        }
+        CHECK(result.converged);
+        CHECK(max_difference < 1e-3f);
+    }
+}
@@ -0,0 +1,376 @@
+#pragma once
+
+// std libraries
+#include <algorithm>    // std::min
+#include <cmath>        // std::sqrt
+#include <cstddef>      // std::size_t
+#include <functional>   // std::greater
+#include <limits>       // std::numeric_limits
+#include <queue>        // std::priority_queue
+#include <type_traits>  // std::enable_if_t
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+
+// 3rd party libraries
+#include <glm/geometric.hpp>          // dot
+
+// in-house libraries
+#include <series/execution.hpp>
+
+#include "Raster.hpp"
+
+/*
+"distance.hpp" contains distance transforms, which find the distance from each vertex to the nearest vertex of a region.
+A distance transform costs a single pass over the grid regardless of how far distances extend,
+so morphology with large radii can be expressed as a threshold on a distance transform, see "morphologic.hpp".
+
+The region is given by any boolean raster `a` that supports `a.grid` and `a[i]`, such as `Raster<bool>` or `Mask`,
+and is the set of vertices where `a[i] == value`, so that distances can be found either to a region or to its complement.
+Distances are only found between vertices:
+values that do not correspond to a vertex in rasters of derived grids are set as though they are unreachable.
+*/
+
+namespace rasters
+{
+	/*
+	`get_hop_distances()` stores in `out` the fewest number of arrows that must be crossed to reach the region from each vertex,
+	or the largest representable value if the region cannot be reached.
+	It is a breadth first search that starts from every vertex of the region at once.
+	Dilation by `radius` as implemented in "morphologic.hpp" is the set of vertices whose hop distance is at most `radius`.
+	*/
+	template <typename Tmask, typename T, typename Tgrid>
+	void get_hop_distances(const Tmask& a, Raster<T,Tgrid>& out, const bool value = true)
+	{
+		typedef typename Tgrid::size_type Tid;
+		const auto& structure = *a.grid.structure;
+		const T unreachable = std::numeric_limits<T>::max();
+		std::vector<Tid> frontier;
+		std::vector<Tid> next_frontier;
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			const bool is_source = i < structure.vertex_count && a[i] == value;
+			out[i] = is_source? T(0) : unreachable;
+			if (is_source) { frontier.push_back(i); }
+		}
+		for (T distance = 1; !frontier.empty(); ++distance)
+		{
+			next_frontier.clear();
+			for (const Tid i : frontier)
+			{
+				for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+				{
+					const Tid neighbor_id = structure.vertex_neighbor_ids[j];
+					if (out[neighbor_id] == unreachable)
+					{
+						out[neighbor_id] = distance;
+						next_frontier.push_back(neighbor_id);
+					}
+				}
+			}
+			frontier.swap(next_frontier);
+		}
+	}
+
+	/*
+	`get_geodesic_distances()` stores in `out` the length of the shortest path along arrows from each vertex to the region,
+	or infinity if the region cannot be reached.
+	It is Dijkstra's algorithm over `Metrics::arrow_lengths`, starting from every vertex of the region at once.
+	Paths are restricted to arrows, so on a sphere they overestimate great circle distances by a few percent,
+	but unlike hop distances they do not depend on how evenly the vertices of the grid are spaced.
+	*/
+	template <typename Tmask, typename T, typename Tgrid>
+	void get_geodesic_distances(const Tmask& a, Raster<T,Tgrid>& out, const bool value = true)
+	{
+		typedef typename Tgrid::size_type Tid;
+		typedef std::pair<T,Tid> Tentry;
+		const auto& structure = *a.grid.structure;
+		const auto& metrics = *a.grid.metrics;
+		std::priority_queue<Tentry, std::vector<Tentry>, std::greater<Tentry>> queue;
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			const bool is_source = i < structure.vertex_count && a[i] == value;
+			out[i] = is_source? T(0) : std::numeric_limits<T>::infinity();
+			if (is_source) { queue.emplace(T(0), i); }
+		}
+		while (!queue.empty())
+		{
+			const Tentry entry = queue.top();
+			queue.pop();
+			const Tid i = entry.second;
+			if (entry.first > out[i]) { continue; } // a shorter path to the vertex has already been visited
+			for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+			{
+				const Tid neighbor_id = structure.vertex_neighbor_ids[j];
+				const T distance = entry.first + metrics.arrow_lengths[structure.vertex_neighbor_arrow_ids[j]];
+				if (distance < out[neighbor_id])
+				{
+					out[neighbor_id] = distance;
+					queue.emplace(distance, neighbor_id);
+				}
+			}
+		}
+	}
+
+	/*
+	`get_marching_update()` returns the smallest distance of vertex `i` that is consistent with the distances of its neighbors,
+	where `get_distance(j)` returns the distance of neighbor `j`, or infinity if it is not yet known.
+	Within each face around `i`, distances are assumed to vary linearly, with a gradient whose magnitude is 1,
+	which is the discretization of the eikonal equation used by fast marching on triangulated surfaces (Kimmel and Sethian, 1998).
+	This allows a wavefront to cross a face at any angle, rather than only along arrows.
+	If the wavefront would not arrive at `i` from within a face, the face is crossed along one of its arrows instead.
+	*/
+	template <typename T, typename Tgrid, typename F>
+	T get_marching_update(const Tgrid& grid, const F get_distance, const std::size_t i)
+	{
+		const auto& structure = *grid.structure;
+		const auto& metrics = *grid.metrics;
+		const auto& xi = metrics.vertex_positions[i];
+		T out_i = std::numeric_limits<T>::infinity();
+		for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+		{
+			const std::size_t neighbor_id = structure.vertex_neighbor_ids[j];
+			const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+			const T tj = get_distance(neighbor_id);
+			out_i = std::min(out_i, tj + metrics.arrow_lengths[arrow_id]);
+			for (const std::size_t face_id : {structure.arrow_face_id_a[arrow_id], structure.arrow_face_id_b[arrow_id]})
+			{
+				const auto face = structure.face_vertex_ids[face_id];
+				const std::size_t face_id_sum = std::size_t(face.x) + std::size_t(face.y) + std::size_t(face.z);
+				const bool is_adjacent = (face.x == i || face.y == i || face.z == i) &&
+					(face.x == neighbor_id || face.y == neighbor_id || face.z == neighbor_id);
+				if (!is_adjacent) { continue; } // the arrow lies on the edge of a grid that does not enclose a surface
+				const std::size_t k = face_id_sum - i - neighbor_id;
+				const T tk = get_distance(k);
+				if (!(tj < std::numeric_limits<T>::infinity() && tk < std::numeric_limits<T>::infinity())) { continue; }
+				const auto a = metrics.vertex_positions[neighbor_id] - xi;
+				const auto b = metrics.vertex_positions[k] - xi;
+				const T aa = glm::dot(a,a);
+				const T ab = glm::dot(a,b);
+				const T bb = glm::dot(b,b);
+				const T determinant = aa*bb - ab*ab;
+				// solve for the distance `t` at `i` where the gradient of distance within the face has a magnitude of 1
+				const T A = aa + bb - 2*ab;
+				const T B = (bb-ab)*tj + (aa-ab)*tk;
+				const T C = bb*tj*tj - 2*ab*tj*tk + aa*tk*tk - determinant;
+				const T discriminant = B*B - A*C;
+				if (!(determinant > T(0) && A > T(0) && discriminant >= T(0))) { continue; }
+				const T t = (B + std::sqrt(discriminant)) / A;
+				// the wavefront arrives from within the face only if the gradient points out of the face at `i`
+				const bool is_upwind =
+					t >= tj && t >= tk &&
+					bb*(tj-t) - ab*(tk-t) <= T(0) &&
+					aa*(tk-t) - ab*(tj-t) <= T(0);
+				if (is_upwind)
+				{
+					out_i = std::min(out_i, t);
+				}
+			}
+		}
+		return out_i;
+	}
+
+	/*
+	`get_fast_marching_distances()` behaves as `get_geodesic_distances()`, but uses `get_marching_update()`,
+	so that paths may cross faces instead of being restricted to arrows.
+	On a sphere this brings distances close to great circle distances,
+	and removes the bias towards the directions of arrows that is present in both hop distances and geodesic distances.
+	Distances are only found up to `max_distance`, so that the cost of finding distances within a narrow band of the region
+	only depends on the number of vertices within the band. Vertices outside the band are set to infinity.
+	*/
+	template <typename Tmask, typename T, typename Tgrid>
+	void get_fast_marching_distances(
+		const Tmask& a,
+		Raster<T,Tgrid>& out,
+		const bool value = true,
+		const T max_distance = std::numeric_limits<T>::infinity()
+	) {
+		typedef typename Tgrid::size_type Tid;
+		typedef std::pair<T,Tid> Tentry;
+		const auto& structure = *a.grid.structure;
+		std::vector<bool> is_known(structure.vertex_count, false);
+		// only distances that are final may be used, since updates from distances that are later lowered may be too small
+		const auto get_known_distance = [&](const std::size_t j) { return is_known[j]? out[j] : std::numeric_limits<T>::infinity(); };
+		std::priority_queue<Tentry, std::vector<Tentry>, std::greater<Tentry>> queue;
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			const bool is_source = i < structure.vertex_count && a[i] == value;
+			out[i] = is_source? T(0) : std::numeric_limits<T>::infinity();
+			if (is_source) { queue.emplace(T(0), i); }
+		}
+		while (!queue.empty())
+		{
+			const Tentry entry = queue.top();
+			queue.pop();
+			const Tid i = entry.second;
+			if (is_known[i] || entry.first > out[i]) { continue; } // a shorter path to the vertex has already been visited
+			if (entry.first > max_distance) { break; }
+			is_known[i] = true;
+			for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+			{
+				const Tid neighbor_id = structure.vertex_neighbor_ids[j];
+				if (is_known[neighbor_id]) { continue; }
+				const T distance = get_marching_update<T>(a.grid, get_known_distance, neighbor_id);
+				if (distance < out[neighbor_id])
+				{
+					out[neighbor_id] = distance;
+					queue.emplace(distance, neighbor_id);
+				}
+			}
+		}
+		for (std::size_t i = 0; i < structure.vertex_count; ++i)
+		{
+			if (!is_known[i]) { out[i] = std::numeric_limits<T>::infinity(); }
+		}
+	}
+
+	/*
+	`get_marching_steps()` returns for each vertex the smallest amount by which `get_marching_update()` can exceed the distance of a neighbor.
+	This is the smallest projection of an arrow onto a direction within a face that lies within the angle of the face at the vertex,
+	which is zero if the angle is not acute, or the length of the arrow if the arrow borders no face.
+	A single face that is not acute only lowers the steps of vertices at its obtuse corner, rather than those of the whole grid.
+	*/
+	template <typename Tgrid>
+	std::vector<typename Tgrid::value_type> get_marching_steps(const Tgrid& grid)
+	{
+		typedef typename Tgrid::value_type T;
+		const auto& structure = *grid.structure;
+		const auto& metrics = *grid.metrics;
+		std::vector<T> out(structure.vertex_count, std::numeric_limits<T>::infinity());
+		for (std::size_t i = 0; i < structure.vertex_count; ++i)
+		{
+			for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+			{
+				out[i] = std::min(out[i], T(metrics.arrow_lengths[structure.vertex_neighbor_arrow_ids[j]]));
+			}
+		}
+		for (std::size_t i = 0; i < structure.face_count; ++i)
+		{
+			const auto face = structure.face_vertex_ids[i];
+			const std::size_t ids[3] = {face.x, face.y, face.z};
+			for (std::size_t j = 0; j < 3; ++j)
+			{
+				const auto a = metrics.vertex_positions[ids[(j+1)%3]] - metrics.vertex_positions[ids[j]];
+				const auto b = metrics.vertex_positions[ids[(j+2)%3]] - metrics.vertex_positions[ids[j]];
+				const T a_length = glm::length(a);
+				const T b_length = glm::length(b);
+				const T cosine = glm::dot(a,b) / (a_length * b_length);
+				out[ids[j]] = std::min(out[ids[j]], std::max(T(0), std::min(a_length, b_length) * cosine));
+			}
+		}
+		return out;
+	}
+
+	/*
+	The policy overload of `get_fast_marching_distances()` finds the same distances, 
+	but accepts many vertices at once so that their neighbors can be updated according to `policy`.
+	Fast marching accepts the vertex with the smallest tentative distance, `d`, since no other vertex can lower it.
+	Any update to a vertex `i` exceeds the distances of the neighbors it is found from by at least `get_marching_steps()[i]`,
+	so no other vertex can lower the distance of `i` if it is within that step of `d`, 
+	and each iteration accepts every such vertex at once.
+	This is the "Δ-stepping" used to parallelize Dijkstra's algorithm, for steps that guarantee the same result as fast marching.
+	Tentative distances are kept in buckets whose width is the mean step, and only the lowest bucket that is not empty is searched,
+	so the cost of each iteration depends on the size of the band rather than the number of tentative distances.
+	*/
+	template <typename Tpolicy, typename Tmask, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void get_fast_marching_distances(
+		const Tpolicy policy,
+		const Tmask& a,
+		Raster<T,Tgrid>& out,
+		const bool value = true,
+		const T max_distance = std::numeric_limits<T>::infinity()
+	) {
+		typedef typename Tgrid::size_type Tid;
+		const auto& structure = *a.grid.structure;
+		const std::vector<T> steps = get_marching_steps(a.grid);
+		T step_sum(0);
+		std::size_t step_count(0);
+		for (const T step : steps)
+		{
+			if (T(0) < step && step < std::numeric_limits<T>::infinity()) { step_sum += step; ++step_count; }
+		}
+		const T bucket_width = step_count > 0? step_sum / step_count : T(1);
+		const auto get_bucket_id = [&](const T distance) { return std::size_t(distance / bucket_width); };
+		std::vector<bool> is_known(structure.vertex_count, false);
+		std::vector<bool> is_candidate(structure.vertex_count, false);
+		const auto get_known_distance = [&](const std::size_t j) { return is_known[j]? out[j] : std::numeric_limits<T>::infinity(); };
+		// entries of a vertex in buckets other than `bucket_ids[i]` are stale, and are skipped
+		std::vector<std::vector<Tid>> buckets(1);
+		std::vector<std::size_t> bucket_ids(structure.vertex_count, 0);
+		std::vector<Tid> band;
+		std::vector<Tid> candidates;
+		std::vector<T> updates;
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			const bool is_source = i < structure.vertex_count && a[i] == value;
+			out[i] = is_source? T(0) : std::numeric_limits<T>::infinity();
+			if (is_source) { buckets[0].push_back(i); }
+		}
+		for (std::size_t bucket_id = 0; bucket_id < buckets.size(); )
+		{
+			std::vector<Tid>& bucket = buckets[bucket_id];
+			T min_distance = std::numeric_limits<T>::infinity();
+			std::size_t bucket_size = 0;
+			for (const Tid i : bucket)
+			{
+				if (!is_known[i] && bucket_ids[i] == bucket_id)
+				{
+					bucket[bucket_size++] = i;
+					min_distance = std::min(min_distance, out[i]);
+				}
+			}
+			bucket.resize(bucket_size);
+			if (bucket.empty()) { ++bucket_id; continue; }
+			if (min_distance > max_distance) { break; }
+			band.clear();
+			bucket_size = 0;
+			for (const Tid i : bucket)
+			{
+				if (out[i] <= std::min(min_distance + steps[i], max_distance)) { band.push_back(i); }
+				else { bucket[bucket_size++] = i; }
+			}
+			bucket.resize(bucket_size);
+			for (const Tid i : band)
+			{
+				is_known[i] = true;
+			}
+			candidates.clear();
+			for (const Tid i : band)
+			{
+				for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+				{
+					const Tid neighbor_id = structure.vertex_neighbor_ids[j];
+					if (!is_known[neighbor_id] && !is_candidate[neighbor_id])
+					{
+						is_candidate[neighbor_id] = true;
+						candidates.push_back(neighbor_id);
+					}
+				}
+			}
+			updates.resize(candidates.size());
+			series::for_each_id(policy, candidates.size(), [&](const std::size_t j) {
+				updates[j] = get_marching_update<T>(a.grid, get_known_distance, candidates[j]);
+			});
+			// NOTE: `bucket` may be invalidated below, since `buckets` may grow
+			for (std::size_t j = 0; j < candidates.size(); ++j)
+			{
+				const Tid i = candidates[j];
+				is_candidate[i] = false;
+				if (!(updates[j] < out[i])) { continue; }
+				// updates never lie below `min_distance`, but the bucket is clamped in case of rounding
+				const std::size_t new_bucket_id = std::max(bucket_id, get_bucket_id(updates[j]));
+				if (out[i] == std::numeric_limits<T>::infinity() || new_bucket_id != bucket_ids[i])
+				{
+					if (new_bucket_id >= buckets.size()) { buckets.resize(new_bucket_id + 1); }
+					buckets[new_bucket_id].push_back(i);
+					bucket_ids[i] = new_bucket_id;
+				}
+				out[i] = updates[j];
+			}
+		}
+		for (std::size_t i = 0; i < structure.vertex_count; ++i)
+		{
+			if (!is_known[i]) { out[i] = std::numeric_limits<T>::infinity(); }
+		}
+	}
+}
@@ -0,0 +1,250 @@
+
+// std libraries
+#include <cmath>     // std::acos
+#include <limits>    // std::numeric_limits
+#include <random>    // std::mt19937
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch/catch.hpp"
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+#include <glm/geometric.hpp>          // dot
+
+#include <series/types.hpp>  
+#include <series/morphologic.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+
+#include "Grid.hpp"
+#include "Raster.hpp"
+#include "Mask.hpp"
+#include "distance.hpp"
+#include "morphologic.hpp"
+
+TEST_CASE( "Grid distance transform correctness", "[rasters]" ) {
+    const meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 4, true);
+    const rasters::Grid<uint,float> grid(icosphere.vertices, icosphere.faces);
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    const glm::vec3 pole = glm::normalize(glm::vec3(1,2,3));
+    const float cap_angle = 0.5f;
+    auto noise = rasters::make_Raster<bool>(grid);
+    auto cap = rasters::make_Raster<bool>(grid);
+    for (std::size_t i = 0; i < noise.size(); ++i)
+    {
+        noise[i] = uniform(generator) < 0.02f;
+        cap[i] = glm::dot(grid.metrics->vertex_positions[i], pole) > std::cos(cap_angle);
+    }
+    auto expected = rasters::make_Raster<bool>(grid);
+    auto out = rasters::make_Raster<bool>(grid);
+
+    SECTION("dilate() and erode() with a radius must produce the same output as repeated calls without a radius"){
+        for (const auto* a : {&noise, &cap})
+        {
+            for (uint radius = 0; radius < 6; ++radius)
+            {
+                auto dilated = *a;
+                auto eroded = *a;
+                for (uint i = 0; i < radius; ++i)
+                {
+                    rasters::dilate(dilated, expected);
+                    dilated = expected;
+                    rasters::erode(eroded, expected);
+                    eroded = expected;
+                }
+                rasters::dilate(*a, out, radius);
+                CHECK(series::equal(out, dilated));
+                rasters::erode(*a, out, radius);
+                CHECK(series::equal(out, eroded));
+            }
+        }
+    }
+    SECTION("get_hop_distances() must return the smallest radius of dilation that reaches each vertex"){
+        auto distances = rasters::make_Raster<uint>(grid);
+        rasters::get_hop_distances(noise, distances);
+        int error_count = 0;
+        for (uint radius = 0; radius < 6; ++radius)
+        {
+            rasters::dilate(noise, out, radius);
+            for (std::size_t i = 0; i < out.size(); ++i)
+            {
+                error_count += out[i] != (distances[i] <= radius);
+            }
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("get_geodesic_distances() must approximate great circle distances on a sphere"){
+        auto distances = rasters::make_Raster<float>(grid);
+        rasters::get_geodesic_distances(cap, distances);
+        const float max_arrow_length = *std::max_element(grid.metrics->arrow_lengths.begin(), grid.metrics->arrow_lengths.end());
+        int error_count = 0;
+        for (std::size_t i = 0; i < distances.size(); ++i)
+        {
+            const float angle = std::acos(std::min(1.0f, glm::dot(grid.metrics->vertex_positions[i], pole)));
+            const float exact = std::max(0.0f, angle - cap_angle);
+            error_count += distances[i] < exact - max_arrow_length || distances[i] > 1.2f * exact + max_arrow_length;
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("get_fast_marching_distances() must approximate great circle distances more closely than get_geodesic_distances()"){
+        auto geodesic = rasters::make_Raster<float>(grid);
+        auto marching = rasters::make_Raster<float>(grid);
+        rasters::get_geodesic_distances(cap, geodesic);
+        rasters::get_fast_marching_distances(cap, marching);
+        double geodesic_error = 0.0;
+        double marching_error = 0.0;
+        int error_count = 0;
+        for (std::size_t i = 0; i < marching.size(); ++i)
+        {
+            const float angle = std::acos(std::min(1.0f, glm::dot(grid.metrics->vertex_positions[i], pole)));
+            const float exact = std::max(0.0f, angle - cap_angle);
+            geodesic_error += std::abs(geodesic[i] - exact);
+            marching_error += std::abs(marching[i] - exact);
+            error_count += marching[i] > geodesic[i] + 1e-5f;
+        }
+        CHECK(error_count == 0);
+        CHECK(marching_error < 0.5 * geodesic_error);
+    }
+    SECTION("get_fast_marching_distances() must produce the same output regardless of policy"){
+        auto out1 = rasters::make_Raster<float>(grid);
+        auto out2 = rasters::make_Raster<float>(grid);
+        for (const auto* a : {&noise, &cap})
+        {
+            rasters::get_fast_marching_distances(*a, out1);
+            rasters::get_fast_marching_distances(series::ParallelPolicy(4, 2), *a, out2);
+            int error_count = 0;
+            for (std::size_t i = 0; i < out1.size(); ++i)
+            {
+                error_count += std::abs(out1[i] - out2[i]) > 1e-4f;
+            }
+            CHECK(error_count == 0);
+        }
+    }
+    SECTION("get_fast_marching_distances() must only find distances within the narrow band that is requested"){
+        auto full = rasters::make_Raster<float>(grid);
+        auto band = rasters::make_Raster<float>(grid);
+        auto parallel_band = rasters::make_Raster<float>(grid);
+        const float max_distance = 0.2f;
+        rasters::get_fast_marching_distances(cap, full);
+        rasters::get_fast_marching_distances(cap, band, true, max_distance);
+        rasters::get_fast_marching_distances(series::sequenced, cap, parallel_band, true, max_distance);
+        int error_count = 0;
+        for (std::size_t i = 0; i < full.size(); ++i)
+        {
+            const float expected = full[i] <= max_distance? full[i] : std::numeric_limits<float>::infinity();
+            error_count += band[i] != expected;
+            error_count += full[i] < max_distance - 1e-4f && std::abs(parallel_band[i] - full[i]) > 1e-4f;
+            error_count += full[i] > max_distance + 1e-4f && parallel_band[i] != std::numeric_limits<float>::infinity();
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("get_geodesic_distances() must return infinity where the region cannot be reached"){
+        auto empty = rasters::make_Raster<bool>(grid);
+        auto distances = rasters::make_Raster<float>(grid);
+        rasters::get_geodesic_distances(empty, distances);
+        CHECK(distances[0] == std::numeric_limits<float>::infinity());
+    }
+    SECTION("geodesic morphology must produce the same output for Raster<bool> and Mask"){
+        const rasters::Mask<rasters::Grid<uint,float>> noise_mask(noise);
+        auto out_mask = rasters::make_Mask(grid);
+        auto out_raster = rasters::make_Raster<bool>(grid);
+        int error_count = 0;
+        rasters::geodesic_dilate(noise, out, 0.3f);
+        rasters::geodesic_dilate(noise_mask, out_mask, 0.3f);
+        out_mask.store(out_raster);
+        error_count += !series::equal(out, out_raster);
+        rasters::geodesic_erode(noise, out, 0.1f);
+        rasters::geodesic_erode(noise_mask, out_mask, 0.1f);
+        out_mask.store(out_raster);
+        error_count += !series::equal(out, out_raster);
+        rasters::geodesic_black_top_hat(noise, out, 0.1f);
+        rasters::geodesic_black_top_hat(noise_mask, out_mask, 0.1f);
+        out_mask.store(out_raster);
+        error_count += !series::equal(out, out_raster);
+        CHECK(error_count == 0);
+    }
+    SECTION("geodesic morphology must behave as morphology with a disk of the given distance"){
+        auto distances = rasters::make_Raster<float>(grid);
+        rasters::geodesic_dilate(cap, out, 0.0f, distances);
+        CHECK(series::equal(out, cap));
+        rasters::geodesic_dilate(cap, out, 10.0f, distances);
+        CHECK(series::equal(out, series::bools(out.size(), true)));
+        rasters::geodesic_erode(cap, out, 10.0f, distances);
+        CHECK(series::equal(out, series::bools(out.size(), false)));
+        // a spherical cap is unchanged by opening and closing with a disk that is smaller than it
+        rasters::geodesic_opening(cap, out, 0.2f, distances);
+        CHECK(series::equal(out, cap));
+        rasters::geodesic_closing(cap, out, 0.2f, distances);
+        CHECK(series::equal(out, cap));
+        // isolated points are removed by an opening, so the black top hat restores them
+        rasters::geodesic_black_top_hat(noise, out, 0.1f, distances);
+        int error_count = 0;
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            error_count += out[i] && !noise[i];
+        }
+        CHECK(error_count == 0);
+    }
+}
+
+TEST_CASE( "Grid fast marching on faces that are not acute", "[rasters]" ) {
+    // a sheared planar grid, where one angle of every face is obtuse
+    const std::size_t N = 8;
+    const float shear = 1.6f;
+    series::vec3s vertices(N*N);
+    series::uvec3s faces(2*(N-1)*(N-1));
+    for (std::size_t y = 0; y < N; ++y)
+    {
+        for (std::size_t x = 0; x < N; ++x)
+        {
+            vertices[y*N+x] = glm::vec3(x + shear * y, y, 0);
+        }
+    }
+    for (std::size_t y = 0; y+1 < N; ++y)
+    {
+        for (std::size_t x = 0; x+1 < N; ++x)
+        {
+            faces[2*(y*(N-1)+x)]   = glm::uvec3(y*N+x,   y*N+x+1,     (y+1)*N+x);
+            faces[2*(y*(N-1)+x)+1] = glm::uvec3(y*N+x+1, (y+1)*N+x+1, (y+1)*N+x);
+        }
+    }
+    const rasters::Grid<uint,float> grid(vertices, faces);
+    auto corner = rasters::make_Raster<bool>(grid);
+    auto edge = rasters::make_Raster<bool>(grid);
+    for (std::size_t i = 0; i < corner.size(); ++i)
+    {
+        corner[i] = i == 0;
+        edge[i] = i % N == 0;
+    }
+    SECTION("get_marching_steps() must only be zero at vertices with angles that are not acute"){
+        const std::vector<float> steps = rasters::get_marching_steps(grid);
+        int zero_count = 0;
+        for (const float step : steps)
+        {
+            zero_count += step == 0.0f;
+        }
+        CHECK(0 < zero_count);
+        CHECK(zero_count < int(steps.size()));
+        CHECK(steps[0] > 0.0f); // vertex 0 only borders the acute angle of a single face
+    }
+    SECTION("get_fast_marching_distances() must produce the same output regardless of policy"){
+        auto out1 = rasters::make_Raster<float>(grid);
+        auto out2 = rasters::make_Raster<float>(grid);
+        for (const auto* a : {&corner, &edge})
+        {
+            for (const float max_distance : {std::numeric_limits<float>::infinity(), 3.0f})
+            {
+                rasters::get_fast_marching_distances(*a, out1, true, max_distance);
+                rasters::get_fast_marching_distances(series::ParallelPolicy(4, 1), *a, out2, true, max_distance);
+                int error_count = 0;
+                for (std::size_t i = 0; i < out1.size(); ++i)
+                {
+                    error_count += !(out1[i] == out2[i] || std::abs(out1[i] - out2[i]) <= 1e-4f);
+                }
+                CHECK(error_count == 0);
+            }
+        }
+    }
+}
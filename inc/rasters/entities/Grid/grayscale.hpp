@@ -0,0 +1,397 @@
+#pragma once
+
+// C libraries
+#include <assert.h>     /* assert */
+
+// std libraries
+#include <cstddef>      // std::size_t
+#include <limits>       // std::numeric_limits
+#include <type_traits>  // std::enable_if_t
+#include <vector>       // std::vector
+
+// in-house libraries
+#include <series/execution.hpp>
+
+#include "Raster.hpp"
+
+/*
+"grayscale.hpp" extends the morphology of "morphologic.hpp" to rasters of any ordered type, such as elevation or age.
+`dilate()` stores the maximum of each vertex and its neighbors, and `erode()` stores the minimum,
+so that for rasters of booleans they behave as `dilate()` and `erode()` do in "morphologic.hpp".
+The remaining operations are composed from these in the same way as they are for booleans.
+
+Each step visits the neighbors of every vertex once and only writes to the output of that vertex,
+so vertices can be distributed according to `policy`, see "series/execution.hpp".
+Operations with a `radius` alternate between `out` and `scratch` rather than allocating a raster for each step,
+and top hats calculate their difference while running their last step, rather than in a separate pass.
+Overloads without a `policy` that have a counterpart in "morphologic.hpp" exclude rasters of booleans,
+so that those are always handled by "morphologic.hpp", whose `radius` overloads do not depend on `radius` in cost.
+*/
+
+namespace rasters
+{
+	/*
+	`store_neighborhood()` stores `g(i, x)` in `out` for each vertex `i`,
+	where `x` is the result of combining the value of `a` at `i` with the values of its neighbors using `f`.
+	Values that do not correspond to a vertex are not modified.
+	*/
+	template <typename Tpolicy, typename T, typename Tgrid, typename F, typename G,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void store_neighborhood(const Tpolicy policy, const F f, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const G g)
+	{
+		assert(&a != &out);
+		const auto& structure = *a.grid.structure;
+		series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+			T out_i = a[i];
+			for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+			{
+				out_i = f(out_i, a[structure.vertex_neighbor_ids[j]]);
+			}
+			out[i] = g(i, out_i);
+		}, series::write_alignment<T>);
+	}
+
+	/*
+	`iterate_neighborhood()` runs `radius` steps of `store_neighborhood()` for `f`, starting from `a`, and stores the result in `out`.
+	Steps alternate between `out` and `scratch`, starting with whichever causes the last step to be stored in `out`,
+	so the result only needs to be copied if `a` and `out` are the same raster.
+	Values that do not correspond to a vertex are set to `empty`, as they would be for an empty neighborhood.
+	*/
+	template <typename Tpolicy, typename T, typename Tgrid, typename F,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void iterate_neighborhood(const Tpolicy policy, const F f, const T empty, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		assert(&scratch != &a && &scratch != &out);
+		Raster<T,Tgrid>* buffers[2] = {&out, &scratch};
+		std::size_t k = &a == &out? 1 : (radius+1) % 2;
+		const Raster<T,Tgrid>* in = &a;
+		for (uint i = 0; i < radius; ++i, k = 1-k)
+		{
+			store_neighborhood(policy, f, *in, *buffers[k], [](const std::size_t, const T x){ return x; });
+			in = buffers[k];
+		}
+		if (in != &out)
+		{
+			series::for_each_id(policy, out.size(), [&](const std::size_t i) { out[i] = (*in)[i]; }, series::write_alignment<T>);
+		}
+		for (std::size_t i = a.grid.structure->vertex_count; i < out.size(); ++i)
+		{
+			out[i] = empty;
+		}
+	}
+
+	template <typename T>
+	struct Maximum
+	{
+		inline T operator()(const T a, const T b) const { return a < b? b : a; }
+	};
+	template <typename T>
+	struct Minimum
+	{
+		inline T operator()(const T a, const T b) const { return b < a? b : a; }
+	};
+
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void dilate(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		iterate_neighborhood(policy, Maximum<T>(), std::numeric_limits<T>::lowest(), a, out, radius, scratch);
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void dilate(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		Raster<T,Tgrid> scratch(a.grid);
+		dilate(policy, a, out, radius, scratch);
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void dilate(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		Raster<T,Tgrid> scratch(a.grid);
+		dilate(policy, a, out, 1, scratch);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void dilate(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		dilate(series::sequenced, a, out, radius, scratch);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void dilate(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		dilate(series::sequenced, a, out, radius);
+	}
+	template <typename T, typename Tgrid>
+	void dilate(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		dilate(series::sequenced, a, out);
+	}
+
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void erode(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		iterate_neighborhood(policy, Minimum<T>(), std::numeric_limits<T>::max(), a, out, radius, scratch);
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void erode(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		Raster<T,Tgrid> scratch(a.grid);
+		erode(policy, a, out, radius, scratch);
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void erode(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		Raster<T,Tgrid> scratch(a.grid);
+		erode(policy, a, out, 1, scratch);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void erode(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		erode(series::sequenced, a, out, radius, scratch);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void erode(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		erode(series::sequenced, a, out, radius);
+	}
+	template <typename T, typename Tgrid>
+	void erode(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		erode(series::sequenced, a, out);
+	}
+
+	/*
+	The multi radius variants of `dilate()` and `erode()` store the result for `radii[i]` in `out[i]`,
+	where `radii` must be in ascending order.
+	Each result continues from the last, so the cost is that of a single call for the largest radius.
+	*/
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void dilate(const Tpolicy policy, const Raster<T,Tgrid>& a, std::vector<Raster<T,Tgrid>>& out, const std::vector<uint>& radii)
+	{
+		assert(out.size() == radii.size());
+		Raster<T,Tgrid> scratch(a.grid);
+		for (std::size_t i = 0; i < radii.size(); ++i)
+		{
+			assert(i == 0 || radii[i-1] <= radii[i]);
+			dilate(policy, i == 0? a : out[i-1], out[i], i == 0? radii[i] : radii[i] - radii[i-1], scratch);
+		}
+	}
+	template <typename T, typename Tgrid>
+	void dilate(const Raster<T,Tgrid>& a, std::vector<Raster<T,Tgrid>>& out, const std::vector<uint>& radii)
+	{
+		dilate(series::sequenced, a, out, radii);
+	}
+
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void erode(const Tpolicy policy, const Raster<T,Tgrid>& a, std::vector<Raster<T,Tgrid>>& out, const std::vector<uint>& radii)
+	{
+		assert(out.size() == radii.size());
+		Raster<T,Tgrid> scratch(a.grid);
+		for (std::size_t i = 0; i < radii.size(); ++i)
+		{
+			assert(i == 0 || radii[i-1] <= radii[i]);
+			erode(policy, i == 0? a : out[i-1], out[i], i == 0? radii[i] : radii[i] - radii[i-1], scratch);
+		}
+	}
+	template <typename T, typename Tgrid>
+	void erode(const Raster<T,Tgrid>& a, std::vector<Raster<T,Tgrid>>& out, const std::vector<uint>& radii)
+	{
+		erode(series::sequenced, a, out, radii);
+	}
+
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void opening(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		erode ( policy, a,   out, radius, scratch );
+		dilate( policy, out, out, radius, scratch );
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void opening(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		Raster<T,Tgrid> scratch(a.grid);
+		opening(policy, a, out, radius, scratch);
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void opening(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		opening(policy, a, out, 1);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void opening(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		opening(series::sequenced, a, out, radius, scratch);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void opening(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		opening(series::sequenced, a, out, radius);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void opening(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		opening(series::sequenced, a, out);
+	}
+
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void closing(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		dilate( policy, a,   out, radius, scratch );
+		erode ( policy, out, out, radius, scratch );
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void closing(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		Raster<T,Tgrid> scratch(a.grid);
+		closing(policy, a, out, radius, scratch);
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void closing(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		closing(policy, a, out, 1);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void closing(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		closing(series::sequenced, a, out, radius, scratch);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void closing(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		closing(series::sequenced, a, out, radius);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void closing(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		closing(series::sequenced, a, out);
+	}
+
+	/*
+	As in "morphologic.hpp", `white_top_hat()` stores `closing(a) - a` and `black_top_hat()` stores `a - opening(a)`,
+	so both are never negative. `a` and `out` must be different rasters.
+	Values that do not correspond to a vertex are set to zero.
+	*/
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void white_top_hat(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		assert(&a != &out);
+		dilate( policy, a, scratch, radius, out );
+		if (radius > 0)
+		{
+			erode( policy, scratch, scratch, radius-1, out );
+			store_neighborhood(policy, Minimum<T>(), scratch, out, [&](const std::size_t i, const T x){ return x - a[i]; });
+		}
+		else
+		{
+			series::for_each_id(policy, out.size(), [&](const std::size_t i) { out[i] = scratch[i] - a[i]; }, series::write_alignment<T>);
+		}
+		for (std::size_t i = a.grid.structure->vertex_count; i < out.size(); ++i)
+		{
+			out[i] = T(0);
+		}
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void white_top_hat(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		Raster<T,Tgrid> scratch(a.grid);
+		white_top_hat(policy, a, out, radius, scratch);
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void white_top_hat(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		white_top_hat(policy, a, out, 1);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void white_top_hat(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		white_top_hat(series::sequenced, a, out, radius, scratch);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void white_top_hat(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		white_top_hat(series::sequenced, a, out, radius);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void white_top_hat(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		white_top_hat(series::sequenced, a, out);
+	}
+
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void black_top_hat(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		assert(&a != &out);
+		erode( policy, a, scratch, radius, out );
+		if (radius > 0)
+		{
+			dilate( policy, scratch, scratch, radius-1, out );
+			store_neighborhood(policy, Maximum<T>(), scratch, out, [&](const std::size_t i, const T x){ return a[i] - x; });
+		}
+		else
+		{
+			series::for_each_id(policy, out.size(), [&](const std::size_t i) { out[i] = a[i] - scratch[i]; }, series::write_alignment<T>);
+		}
+		for (std::size_t i = a.grid.structure->vertex_count; i < out.size(); ++i)
+		{
+			out[i] = T(0);
+		}
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void black_top_hat(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		Raster<T,Tgrid> scratch(a.grid);
+		black_top_hat(policy, a, out, radius, scratch);
+	}
+	template <typename Tpolicy, typename T, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void black_top_hat(const Tpolicy policy, const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		black_top_hat(policy, a, out, 1);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void black_top_hat(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius, Raster<T,Tgrid>& scratch)
+	{
+		black_top_hat(series::sequenced, a, out, radius, scratch);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void black_top_hat(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out, const uint radius)
+	{
+		black_top_hat(series::sequenced, a, out, radius);
+	}
+	template <typename T, typename Tgrid,
+		std::enable_if_t<!std::is_same<T,bool>::value, int> = 0>
+	void black_top_hat(const Raster<T,Tgrid>& a, Raster<T,Tgrid>& out)
+	{
+		black_top_hat(series::sequenced, a, out);
+	}
+}
@@ -0,0 +1,177 @@
+
+// std libraries
+#include <algorithm> // std::max
+#include <random>    // std::mt19937
+#include <vector>    // std::vector
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch/catch.hpp"
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/types.hpp>  
+#include <series/morphologic.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+
+#include "Grid.hpp"
+#include "Raster.hpp"
+#include "morphologic.hpp"
+#include "grayscale.hpp"
+
+// returns the maximum of `a` over each vertex and its neighbors, calculated without the functions of "grayscale.hpp"
+template<typename T, typename Tgrid>
+rasters::Raster<T,Tgrid> get_neighborhood_maximum(const rasters::Raster<T,Tgrid>& a)
+{
+    rasters::Raster<T,Tgrid> out(a.grid);
+    const auto& structure = *a.grid.structure;
+    for (std::size_t i = 0; i < structure.vertex_count; ++i)
+    {
+        out[i] = a[i];
+        for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+        {
+            out[i] = std::max(out[i], a[structure.vertex_neighbor_ids[j]]);
+        }
+    }
+    return out;
+}
+
+TEST_CASE( "Grid grayscale morphology correctness", "[rasters]" ) {
+    const meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 3, true);
+    const rasters::Grid<uint,float> grid(icosphere.vertices, icosphere.faces);
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    auto a = rasters::make_Raster<float>(grid);
+    auto negated = rasters::make_Raster<float>(grid);
+    auto bools = rasters::make_Raster<bool>(grid);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = uniform(generator);
+        negated[i] = -a[i];
+        bools[i] = a[i] < 0.1f;
+    }
+    auto out = rasters::make_Raster<float>(grid);
+    auto expected = rasters::make_Raster<float>(grid);
+    auto scratch = rasters::make_Raster<float>(grid);
+
+    SECTION("dilate() must store the maximum of each neighborhood"){
+        rasters::dilate(a, out);
+        CHECK(series::equal(out, get_neighborhood_maximum(a)));
+    }
+    SECTION("erode() must be the negation of dilate() for the negation of the input"){
+        rasters::erode(a, out, 3);
+        rasters::dilate(negated, expected, 3);
+        int error_count = 0;
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            error_count += out[i] != -expected[i];
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("dilate() and erode() with a radius must produce the same output as repeated calls without a radius"){
+        for (uint radius = 0; radius < 5; ++radius)
+        {
+            auto dilated = a;
+            auto eroded = a;
+            for (uint i = 0; i < radius; ++i)
+            {
+                rasters::dilate(dilated, expected);
+                dilated = expected;
+                rasters::erode(eroded, expected);
+                eroded = expected;
+            }
+            rasters::dilate(a, out, radius, scratch);
+            CHECK(series::equal(out, dilated));
+            rasters::erode(a, out, radius, scratch);
+            CHECK(series::equal(out, eroded));
+            // the input may also be used as output
+            out = a;
+            rasters::dilate(out, out, radius, scratch);
+            CHECK(series::equal(out, dilated));
+        }
+    }
+    SECTION("multi radius dilate() and erode() must produce the same output as separate calls for each radius"){
+        const std::vector<uint> radii {0, 1, 1, 4};
+        std::vector<rasters::Raster<float,rasters::Grid<uint,float>>> outs(radii.size(), out);
+        rasters::dilate(a, outs, radii);
+        for (std::size_t i = 0; i < radii.size(); ++i)
+        {
+            rasters::dilate(a, expected, radii[i]);
+            CHECK(series::equal(outs[i], expected));
+        }
+        rasters::erode(a, outs, radii);
+        for (std::size_t i = 0; i < radii.size(); ++i)
+        {
+            rasters::erode(a, expected, radii[i]);
+            CHECK(series::equal(outs[i], expected));
+        }
+    }
+    SECTION("grayscale morphology must produce the same output as boolean morphology for rasters of booleans"){
+        auto bool_out = rasters::make_Raster<bool>(grid);
+        auto bool_expected = rasters::make_Raster<bool>(grid);
+        rasters::dilate(series::sequenced, bools, bool_out, 2);
+        rasters::dilate(bools, bool_expected, 2);
+        CHECK(series::equal(bool_out, bool_expected));
+        rasters::opening(series::sequenced, bools, bool_out, 2);
+        rasters::opening(bools, bool_expected, 2);
+        CHECK(series::equal(bool_out, bool_expected));
+        rasters::closing(series::sequenced, bools, bool_out, 2);
+        rasters::closing(bools, bool_expected, 2);
+        CHECK(series::equal(bool_out, bool_expected));
+    }
+    SECTION("opening() and closing() must be idempotent and bound the input"){
+        int error_count = 0;
+        rasters::opening(a, out, 2);
+        rasters::opening(out, expected, 2);
+        CHECK(series::equal(out, expected));
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            error_count += out[i] > a[i];
+        }
+        rasters::closing(a, out, 2);
+        rasters::closing(out, expected, 2);
+        CHECK(series::equal(out, expected));
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            error_count += out[i] < a[i];
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("top hats must produce the same output as their unfused definitions"){
+        for (uint radius = 0; radius < 4; ++radius)
+        {
+            int error_count = 0;
+            rasters::white_top_hat(a, out, radius, scratch);
+            rasters::closing(a, expected, radius);
+            for (std::size_t i = 0; i < out.size(); ++i)
+            {
+                error_count += out[i] != expected[i] - a[i] || out[i] < 0.0f;
+            }
+            rasters::black_top_hat(a, out, radius, scratch);
+            rasters::opening(a, expected, radius);
+            for (std::size_t i = 0; i < out.size(); ++i)
+            {
+                error_count += out[i] != a[i] - expected[i] || out[i] < 0.0f;
+            }
+            CHECK(error_count == 0);
+        }
+    }
+    SECTION("grayscale morphology must produce the same output regardless of policy"){
+        const series::ParallelPolicy policy(4, 2);
+        auto parallel_out = rasters::make_Raster<float>(grid);
+        rasters::dilate(a, out, 3);
+        rasters::dilate(policy, a, parallel_out, 3);
+        CHECK(series::equal(out, parallel_out));
+        rasters::erode(a, out, 3);
+        rasters::erode(policy, a, parallel_out, 3);
+        CHECK(series::equal(out, parallel_out));
+        rasters::white_top_hat(a, out, 2);
+        rasters::white_top_hat(policy, a, parallel_out, 2);
+        CHECK(series::equal(out, parallel_out));
+        rasters::black_top_hat(a, out, 2);
+        rasters::black_top_hat(policy, a, parallel_out, 2);
+        CHECK(series::equal(out, parallel_out));
+    }
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+// std libraries
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t
+#include <limits>       // std::numeric_limits
+#include <type_traits>  // std::enable_if_t
+#include <utility>      // std::swap
+#include <vector>       // std::vector
+
+// 3rd party libraries
+#include <glm/vec3.hpp>               // *vec3
+
+// in-house libraries
+#include <series/execution.hpp>
+
+#include "Raster.hpp"
+
+/*
+"labeling.hpp" identifies connected regions of a boolean raster, such as plates or continents.
+Vertices are connected if they share an edge and both belong to the region,
+where the region is the set of vertices where `a[i] == value` for any boolean raster `a` that supports `a.grid` and `a[i]`,
+such as `Raster<bool>` or `Mask`.
+
+Components are found by union-find over the edges of `Structure`, rather than a flood fill,
+since edges can be united in any order, and can therefore be distributed according to `policy`, see "series/execution.hpp".
+Each union links the root with the larger id to the root with the smaller id,
+so the root of each component is always its smallest vertex id, regardless of the order in which edges are visited.
+Components are numbered in order of their smallest vertex id, so labels do not depend on `policy` either.
+*/
+
+namespace rasters
+{
+	/*
+	`Components` stores attributes of each component that is found by `label()`,
+	where attributes of the component with label `i` are stored at index `i`.
+	`centroids` are the average of `Metrics::vertex_positions` weighted by `Metrics::vertex_areas`,
+	so for a grid on a sphere they lie below the surface, and must be normalized to find the point on the sphere.
+	Components without area, such as those that only border degenerate faces, use the unweighted average instead.
+	*/
+	template<typename Tfloat>
+	struct Components
+	{
+		std::vector<std::size_t> counts;
+		std::vector<Tfloat> areas;
+		std::vector<glm::vec<3,Tfloat,glm::defaultp>> centroids;
+
+		inline std::size_t size() const { return counts.size(); }
+	};
+
+	/*
+	`find_root()` and `unite_roots()` implement a union-find that may be used by several threads at once.
+	Links are only ever replaced with links to ancestors, so a thread that reads a stale link still finds the right root,
+	and a root is only linked by a compare and swap that fails if another thread linked the root first.
+	*/
+	template<typename Tid>
+	Tid find_root(std::vector<std::atomic<Tid>>& parents, Tid i)
+	{
+		Tid parent = parents[i].load(std::memory_order_relaxed);
+		while (parent != i)
+		{
+			const Tid grandparent = parents[parent].load(std::memory_order_relaxed);
+			if (grandparent == parent) { return parent; }
+			// path halving: skip a generation so that later searches are shorter
+			parents[i].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+			i = grandparent;
+			parent = parents[i].load(std::memory_order_relaxed);
+		}
+		return i;
+	}
+	template<typename Tid>
+	void unite_roots(std::vector<std::atomic<Tid>>& parents, Tid a, Tid b)
+	{
+		while (true)
+		{
+			a = find_root(parents, a);
+			b = find_root(parents, b);
+			if (a == b) { return; }
+			if (a < b) { std::swap(a, b); }
+			Tid expected = a;
+			if (parents[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) { return; }
+		}
+	}
+
+	/*
+	`label()` stores in `out` the label of the component that contains each vertex of the region,
+	or the largest representable value for vertices outside the region and values that do not correspond to a vertex,
+	and returns the attributes of each component. Attributes are accumulated in the same pass that assigns labels.
+	*/
+	template <typename Tpolicy, typename Tmask, typename Tlabel, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	Components<typename Tgrid::value_type> label(const Tpolicy policy, const Tmask& a, Raster<Tlabel,Tgrid>& out, const bool value = true)
+	{
+		typedef typename Tgrid::size_type Tid;
+		typedef typename Tgrid::value_type Tfloat;
+		const auto& structure = *a.grid.structure;
+		const auto& metrics = *a.grid.metrics;
+		const Tlabel unlabeled = std::numeric_limits<Tlabel>::max();
+		std::vector<std::atomic<Tid>> parents(structure.vertex_count);
+		// roots are stored separately from `out`, since `Tlabel` may not be able to represent every vertex id
+		std::vector<Tid> roots(structure.vertex_count);
+		series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+			parents[i].store(Tid(i), std::memory_order_relaxed);
+		});
+		series::for_each_id(policy, structure.edge_count, [&](const std::size_t i) {
+			const Tid vertex_a = structure.edge_vertex_id_a[i];
+			const Tid vertex_b = structure.edge_vertex_id_b[i];
+			if (a[vertex_a] == value && a[vertex_b] == value)
+			{
+				unite_roots(parents, vertex_a, vertex_b);
+			}
+		});
+		// every root is now final, so roots can be found without modifying links
+		series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+			Tid root = Tid(i);
+			for (Tid parent = parents[root].load(std::memory_order_relaxed); parent != root; parent = parents[root].load(std::memory_order_relaxed))
+			{
+				root = parent;
+			}
+			roots[i] = root;
+		});
+		// since the root of a component is its smallest vertex id, it is labeled before any other vertex in the component,
+		// so `roots` can be overwritten with the label of each vertex as it is visited
+		Components<Tfloat> components;
+		for (std::size_t i = 0; i < structure.vertex_count; ++i)
+		{
+			if (a[i] != value)
+			{
+				out[i] = unlabeled;
+				continue;
+			}
+			if (roots[i] == i)
+			{
+				roots[i] = components.size();
+				components.counts.push_back(0);
+				components.areas.push_back(Tfloat(0));
+				components.centroids.emplace_back(Tfloat(0));
+			}
+			else
+			{
+				roots[i] = roots[roots[i]];
+			}
+			const Tid label_i = roots[i];
+			const Tfloat area = metrics.vertex_areas[i];
+			out[i] = label_i;
+			components.counts[label_i] += 1;
+			components.areas[label_i] += area;
+			components.centroids[label_i] += area * metrics.vertex_positions[i];
+		}
+		bool has_empty_area = false;
+		for (std::size_t i = 0; i < components.size(); ++i)
+		{
+			if (components.areas[i] > Tfloat(0)) { components.centroids[i] /= components.areas[i]; }
+			else { has_empty_area = true; }
+		}
+		if (has_empty_area)
+		{
+			for (std::size_t i = 0; i < structure.vertex_count; ++i)
+			{
+				if (a[i] == value && !(components.areas[roots[i]] > Tfloat(0)))
+				{
+					components.centroids[roots[i]] += metrics.vertex_positions[i] / Tfloat(components.counts[roots[i]]);
+				}
+			}
+		}
+		for (std::size_t i = structure.vertex_count; i < out.size(); ++i)
+		{
+			out[i] = unlabeled;
+		}
+		return components;
+	}
+	template <typename Tmask, typename Tlabel, typename Tgrid>
+	Components<typename Tgrid::value_type> label(const Tmask& a, Raster<Tlabel,Tgrid>& out, const bool value = true)
+	{
+		return label(series::sequenced, a, out, value);
+	}
+}
@@ -0,0 +1,161 @@
+
+// std libraries
+#include <algorithm> // std::fill
+#include <cmath>     // std::cos
+#include <cstdint>   // std::uint8_t
+#include <limits>    // std::numeric_limits
+#include <random>    // std::mt19937
+#include <vector>    // std::vector
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch/catch.hpp"
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+#include <glm/geometric.hpp>          // dot
+
+#include <series/types.hpp>  
+#include <series/morphologic.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+
+#include "Grid.hpp"
+#include "Raster.hpp"
+#include "Mask.hpp"
+#include "labeling.hpp"
+
+// returns labels of connected regions of `a` found by flood fill, numbered in order of their smallest vertex id
+template<typename Tgrid>
+rasters::Raster<uint,Tgrid> get_flood_fill_labels(const rasters::Raster<bool,Tgrid>& a)
+{
+    const auto& structure = *a.grid.structure;
+    rasters::Raster<uint,Tgrid> out(a.grid);
+    std::fill(out.begin(), out.end(), std::numeric_limits<uint>::max());
+    uint label_count = 0;
+    for (std::size_t i = 0; i < structure.vertex_count; ++i)
+    {
+        if (!a[i] || out[i] != std::numeric_limits<uint>::max()) { continue; }
+        std::vector<std::size_t> stack {i};
+        out[i] = label_count;
+        while (!stack.empty())
+        {
+            const std::size_t j = stack.back();
+            stack.pop_back();
+            for (std::size_t k = structure.vertex_neighbor_offsets[j]; k < structure.vertex_neighbor_offsets[j+1]; ++k)
+            {
+                const std::size_t neighbor_id = structure.vertex_neighbor_ids[k];
+                if (a[neighbor_id] && out[neighbor_id] == std::numeric_limits<uint>::max())
+                {
+                    out[neighbor_id] = label_count;
+                    stack.push_back(neighbor_id);
+                }
+            }
+        }
+        ++label_count;
+    }
+    return out;
+}
+
+TEST_CASE( "Grid labeling correctness", "[rasters]" ) {
+    const meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 4, true);
+    const rasters::Grid<uint,float> grid(icosphere.vertices, icosphere.faces);
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    const glm::vec3 pole = glm::normalize(glm::vec3(1,2,3));
+    auto noise = rasters::make_Raster<bool>(grid);
+    auto caps = rasters::make_Raster<bool>(grid);
+    for (std::size_t i = 0; i < noise.size(); ++i)
+    {
+        noise[i] = uniform(generator) < 0.4f;
+        caps[i] = std::abs(glm::dot(grid.metrics->vertex_positions[i], pole)) > std::cos(0.5f);
+    }
+    auto out = rasters::make_Raster<uint>(grid);
+
+    SECTION("label() must produce the same labels as a flood fill"){
+        for (const auto* a : {&noise, &caps})
+        {
+            rasters::label(*a, out);
+            CHECK(series::equal(out, get_flood_fill_labels(*a)));
+        }
+    }
+    SECTION("label() must produce the same output regardless of policy"){
+        auto parallel_out = rasters::make_Raster<uint>(grid);
+        const auto components = rasters::label(noise, out);
+        const auto parallel_components = rasters::label(series::ParallelPolicy(4, 2), noise, parallel_out);
+        CHECK(series::equal(out, parallel_out));
+        CHECK(components.counts == parallel_components.counts);
+        CHECK(components.areas == parallel_components.areas);
+    }
+    SECTION("label() must produce the same output for Raster<bool> and Mask"){
+        auto mask_out = rasters::make_Raster<uint>(grid);
+        rasters::label(noise, out, false);
+        rasters::label(rasters::Mask<rasters::Grid<uint,float>>(noise), mask_out, false);
+        CHECK(series::equal(out, mask_out));
+        auto complement = rasters::make_Raster<bool>(grid);
+        series::negate(noise, complement);
+        CHECK(series::equal(out, get_flood_fill_labels(complement)));
+    }
+    SECTION("label() must return the counts, areas, and centroids of each component"){
+        const auto components = rasters::label(caps, out);
+        REQUIRE(components.size() == 2);
+        std::size_t region_count = 0;
+        for (std::size_t i = 0; i < caps.size(); ++i)
+        {
+            region_count += caps[i];
+        }
+        CHECK(components.counts[0] + components.counts[1] == region_count);
+        CHECK(components.areas[0] == Approx(components.areas[1]).epsilon(0.05));
+        // the caps are centered on opposite poles
+        CHECK(std::abs(glm::dot(glm::normalize(components.centroids[0]), pole)) == Approx(1.0f).epsilon(0.01));
+        CHECK(glm::dot(glm::normalize(components.centroids[0]), glm::normalize(components.centroids[1])) == Approx(-1.0f).epsilon(0.01));
+    }
+    SECTION("label() must produce the same labels for label types that cannot represent every vertex id"){
+        // the smallest vertex id of each component, and therefore its root, exceeds the range of `std::uint8_t`
+        auto late_caps = rasters::make_Raster<bool>(grid);
+        for (std::size_t i = 0; i < caps.size(); ++i)
+        {
+            late_caps[i] = caps[i] && i >= 1000;
+        }
+        const auto expected = get_flood_fill_labels(late_caps);
+        auto narrow_out = rasters::make_Raster<std::uint8_t>(grid);
+        auto float_out = rasters::make_Raster<float>(grid);
+        const auto components = rasters::label(late_caps, narrow_out);
+        rasters::label(late_caps, float_out);
+        REQUIRE(0 < components.size());
+        REQUIRE(components.size() < std::numeric_limits<std::uint8_t>::max());
+        int error_count = 0;
+        for (std::size_t i = 0; i < caps.size(); ++i)
+        {
+            const bool is_labeled = expected[i] != std::numeric_limits<uint>::max();
+            error_count += narrow_out[i] != (is_labeled? std::uint8_t(expected[i]) : std::numeric_limits<std::uint8_t>::max());
+            error_count += float_out[i] != (is_labeled? float(expected[i]) : std::numeric_limits<float>::max());
+        }
+        CHECK(error_count == 0);
+    }
+}
+
+TEST_CASE( "Grid labeling of components without area", "[rasters]" ) {
+    // every vertex lies on a line, so every face is degenerate and every vertex area is zero
+    const rasters::Grid<uint,float> grid(
+        series::vec3s({
+            glm::vec3(0, 0, 0),
+            glm::vec3(1, 0, 0),
+            glm::vec3(2, 0, 0)
+        }),
+        series::uvec3s({
+            glm::uvec3(0,1,2)
+        })
+    );
+    auto full = rasters::make_Raster<bool>(grid);
+    std::fill(full.begin(), full.end(), true);
+    auto out = rasters::make_Raster<uint>(grid);
+    SECTION("label() must return the unweighted centroid of components without area"){
+        const auto components = rasters::label(full, out);
+        REQUIRE(components.size() == 1);
+        CHECK(components.areas[0] == 0.0f);
+        CHECK(components.centroids[0].x == Approx(1.0f));
+        CHECK(components.centroids[0].y == Approx(0.0f));
+        CHECK(components.centroids[0].z == Approx(0.0f));
+    }
+}
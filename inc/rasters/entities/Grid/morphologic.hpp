@@ -1,237 +1,574 @@
 #pragma once
 
+// std libraries
+#include <type_traits>  // std::enable_if_t
+#include <utility>      // std::swap
+#include <vector>       // std::vector
+
+#include <series/execution.hpp>
+
 #include "../Grid/Raster.hpp"
+#include "Mask.hpp"
+#include "distance.hpp"
 
 namespace rasters
 {
+	namespace
+	{
+		template <typename Tgrid>
+		inline void set_cell(Raster<bool,Tgrid>& out, const std::size_t i, const bool value) { out[i] = value; }
+		template <typename Tgrid>
+		inline void set_cell(Mask<Tgrid>& out, const std::size_t i, const bool value) { out.set(i, value); }
+	}
+
+	/*
+	`flood()` sets each vertex of `out` that lies within `radius` arrows of a vertex whose value is `value` to `value`.
+	This is equivalent to `radius` iterations of `dilate()` (if `value` is true) or `erode()` (if `value` is false),
+	but it is a breadth first search that only visits each vertex once, so its cost does not depend on `radius`.
+	NOTE: rasters of derived grids may store more than one value per vertex, 
+	values that do not correspond to a vertex are left as they would be for an empty neighborhood
+	*/
+	template <typename Tmask>
+	void flood(Tmask& out, const uint radius, const bool value)
+	{
+		typedef typename decltype(Tmask::grid)::size_type Tid;
+		const auto& structure = *out.grid.structure;
+		if (radius == 0) { return; }
+		std::vector<Tid> frontier;
+		std::vector<Tid> next_frontier;
+		for (std::size_t i = 0; i < structure.vertex_count; ++i)
+		{
+			if (out[i] == value) { frontier.push_back(i); }
+		}
+		for (uint step = 0; step < radius && !frontier.empty(); ++step)
+		{
+			next_frontier.clear();
+			for (const Tid i : frontier)
+			{
+				for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+				{
+					const Tid neighbor_id = structure.vertex_neighbor_ids[j];
+					if (out[neighbor_id] != value)
+					{
+						set_cell(out, neighbor_id, value);
+						next_frontier.push_back(neighbor_id);
+					}
+				}
+			}
+			frontier.swap(next_frontier);
+		}
+		// an empty neighborhood leaves `!value`, since `dilate()` is false and `erode()` is true where nothing is adjacent
+		for (std::size_t i = structure.vertex_count; i < out.size(); ++i)
+		{
+			set_cell(out, i, !value);
+		}
+	}
 
 	template <typename Tgrid>
 	void dilate(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
 	{
-		fill( out, false );
-		for (unsigned int i = 0; i < a.grid.structure->arrow_vertex_id_from.size(); ++i)
+		const auto& offsets = a.grid.structure->vertex_neighbor_offsets;
+		const auto& neighbor_ids = a.grid.structure->vertex_neighbor_ids;
+		for (unsigned int i = 0; i < a.grid.structure->vertex_count; ++i)
+		{
+			bool out_i = a[i];
+			for (unsigned int j = offsets[i]; j < offsets[i+1]; ++j)
+			{
+				out_i = out_i || a[neighbor_ids[j]];
+			}
+			out[i] = out_i;
+		}
+		// NOTE: rasters of derived grids may store more than one value per vertex, 
+		// values that do not correspond to a vertex are left as they would be for an empty neighborhood
+		for (std::size_t i = a.grid.structure->vertex_count; i < out.size(); ++i)
 		{
-			out[a.grid.structure->arrow_vertex_id_from[i]] = 
-				out[a.grid.structure->arrow_vertex_id_from[i]] || 
-				a  [a.grid.structure->arrow_vertex_id_from[i]] || 
-				a  [a.grid.structure->arrow_vertex_id_to[i]];
+			out[i] = false;
 		}
 	}
 	template <typename Tgrid>
-	void dilate(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius, Raster<bool,Tgrid>& scratch)
+	void erode(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
 	{
-		Raster<bool,Tgrid>* temp_in  = &out;
-		Raster<bool,Tgrid>* temp_out = &scratch;
-		Raster<bool,Tgrid>* temp_swap= &out;
-		assert(radius >= 0);
-		if (radius == 0 && &out != &a)
-		{
-			copy(out, a);
-		} 
-		else 
+		const auto& offsets = a.grid.structure->vertex_neighbor_offsets;
+		const auto& neighbor_ids = a.grid.structure->vertex_neighbor_ids;
+		for (unsigned int i = 0; i < a.grid.structure->vertex_count; ++i)
 		{
-			copy(*temp_in, a);
-			for (uint i = 0; i < radius; ++i)
+			bool out_i = a[i];
+			for (unsigned int j = offsets[i]; j < offsets[i+1]; ++j)
 			{
-				temp_swap = temp_out;
-				temp_out  = temp_in;
-				temp_in   = temp_swap;
-				dilate(*temp_in, *temp_out);
+				out_i = out_i && a[neighbor_ids[j]];
 			}
-			if (radius % 2 == 0)
+			out[i] = out_i;
+		}
+		// NOTE: rasters of derived grids may store more than one value per vertex, 
+		// values that do not correspond to a vertex are left as they would be for an empty neighborhood
+		for (std::size_t i = a.grid.structure->vertex_count; i < out.size(); ++i)
+		{
+			out[i] = true;
+		}
+	}
+	/*
+	The functions below are single steps of `dilate()` and `erode()` for `Mask`, see "Mask.hpp".
+	They visit one word of output at a time, so words can be distributed according to `policy`.
+	Only the bits that could change are visited within each word:
+	dilation only visits cells that are not already set, and stops at the first neighbor that is set,
+	and erosion does the reverse, so dilation skips words that lie inside a region, and erosion skips words that lie outside.
+	*/
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void dilate(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out)
+	{
+		typedef typename Mask<Tgrid>::word_type word_type;
+		constexpr std::size_t W = Mask<Tgrid>::WORD_BIT_COUNT;
+		assert(&a != &out);
+		const auto& offsets = a.grid.structure->vertex_neighbor_offsets;
+		const auto& neighbor_ids = a.grid.structure->vertex_neighbor_ids;
+		const std::size_t vertex_count = a.grid.structure->vertex_count;
+		series::for_each_id(policy, a.word_count(), [&](const std::size_t k) {
+			const std::size_t begin = k * W;
+			// NOTE: masks of derived grids may store more than one value per vertex, 
+			// values that do not correspond to a vertex are left as they would be for an empty neighborhood
+			const word_type vertex_bits = begin >= vertex_count? word_type(0) 
+				: vertex_count - begin >= W? ~word_type(0) : (word_type(1) << (vertex_count - begin)) - 1;
+			word_type out_k = a.words[k] & vertex_bits;
+			for (word_type remaining = ~out_k & vertex_bits; remaining != 0; remaining &= remaining - 1)
 			{
-				copy(out, *temp_out);
+				const std::size_t bit = count_trailing_zeros(remaining);
+				const std::size_t i = begin + bit;
+				for (std::size_t j = offsets[i]; j < offsets[i+1]; ++j)
+				{
+					if (a[neighbor_ids[j]])
+					{
+						out_k |= word_type(1) << bit;
+						break;
+					}
+				}
 			}
-		}
+			out.words[k] = out_k;
+		});
 	}
 	template <typename Tgrid>
-	void dilate(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius)
+	void dilate(const Mask<Tgrid>& a, Mask<Tgrid>& out)
 	{
-		Raster<bool,Tgrid> scratch(a.grid);
-		dilate(a, out, radius, scratch);
+		dilate(series::sequenced, a, out);
+	}
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void erode(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out)
+	{
+		typedef typename Mask<Tgrid>::word_type word_type;
+		constexpr std::size_t W = Mask<Tgrid>::WORD_BIT_COUNT;
+		assert(&a != &out);
+		const auto& offsets = a.grid.structure->vertex_neighbor_offsets;
+		const auto& neighbor_ids = a.grid.structure->vertex_neighbor_ids;
+		const std::size_t vertex_count = a.grid.structure->vertex_count;
+		series::for_each_id(policy, a.word_count(), [&](const std::size_t k) {
+			const std::size_t begin = k * W;
+			const word_type vertex_bits = begin >= vertex_count? word_type(0) 
+				: vertex_count - begin >= W? ~word_type(0) : (word_type(1) << (vertex_count - begin)) - 1;
+			// NOTE: masks of derived grids may store more than one value per vertex, 
+			// values that do not correspond to a vertex are left as they would be for an empty neighborhood
+			word_type out_k = a.words[k] | ~vertex_bits;
+			for (word_type remaining = out_k & vertex_bits; remaining != 0; remaining &= remaining - 1)
+			{
+				const std::size_t bit = count_trailing_zeros(remaining);
+				const std::size_t i = begin + bit;
+				for (std::size_t j = offsets[i]; j < offsets[i+1]; ++j)
+				{
+					if (!a[neighbor_ids[j]])
+					{
+						out_k &= ~(word_type(1) << bit);
+						break;
+					}
+				}
+			}
+			out.words[k] = out_k;
+		});
+		out.clear_padding();
 	}
-
 	template <typename Tgrid>
-	void erode(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
+	void erode(const Mask<Tgrid>& a, Mask<Tgrid>& out)
 	{
-		fill(out, true);
-		for (unsigned int i = 0; i < a.grid.structure->arrow_vertex_id_from.size(); ++i)
+		erode(series::sequenced, a, out);
+	}
+	/*
+	The overloads of `dilate()` and `erode()` below that accept both `policy` and `radius` repeat single steps
+	that are each distributed according to `policy`, rather than calling `flood()`, which must run in sequence.
+	Their cost grows with `radius`, but each step is parallel, so they are preferable for small radii on large grids.
+	`a` and `out` must be different masks.
+	*/
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void dilate(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, uint radius, Mask<Tgrid>& scratch)
+	{
+		assert(&a != &out);
+		// the buffers are chosen so that the last step writes to `out`
+		const Mask<Tgrid>* temp_in = &a;
+		Mask<Tgrid>* temp_out  = radius % 2 == 1? &out : &scratch;
+		Mask<Tgrid>* temp_next = radius % 2 == 1? &scratch : &out;
+		if (radius == 0)
+		{
+			copy(out, a);
+		}
+		for (uint i = 0; i < radius; ++i)
 		{
-			out[a.grid.structure->arrow_vertex_id_from[i]] = 
-				out[a.grid.structure->arrow_vertex_id_from[i]] && 
-				a  [a.grid.structure->arrow_vertex_id_from[i]] && 
-				a  [a.grid.structure->arrow_vertex_id_to[i]];
+			dilate(policy, *temp_in, *temp_out);
+			temp_in = temp_out;
+			std::swap(temp_out, temp_next);
 		}
 	}
-	template <typename Tgrid>
-	void erode(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius, Raster<bool,Tgrid>& scratch)
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void dilate(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, uint radius)
+	{
+		Mask<Tgrid> scratch(a.grid);
+		dilate(policy, a, out, radius, scratch);
+	}
+
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void erode(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, uint radius, Mask<Tgrid>& scratch)
 	{
-		Raster<bool,Tgrid>* temp_in  = &out;
-		Raster<bool,Tgrid>* temp_out = &scratch;
-		Raster<bool,Tgrid>* temp_swap= &out;
-		assert(radius >= 0);
-		if (radius == 0 && &out != &a)
+		assert(&a != &out);
+		// the buffers are chosen so that the last step writes to `out`
+		const Mask<Tgrid>* temp_in = &a;
+		Mask<Tgrid>* temp_out  = radius % 2 == 1? &out : &scratch;
+		Mask<Tgrid>* temp_next = radius % 2 == 1? &scratch : &out;
+		if (radius == 0)
 		{
 			copy(out, a);
-		} 
-		else 
+		}
+		for (uint i = 0; i < radius; ++i)
 		{
-			copy(*temp_in, a);
-			for (uint i = 0; i < radius; ++i)
-			{
-				temp_swap = temp_out;
-				temp_out  = temp_in;
-				temp_in   = temp_swap;
-				erode(*temp_in, *temp_out);
-			}
-			if (radius % 2 == 0)
-			{
-				copy(out, *temp_out);
-			}
+			erode(policy, *temp_in, *temp_out);
+			temp_in = temp_out;
+			std::swap(temp_out, temp_next);
 		}
 	}
-	template <typename Tgrid>
-	void erode(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius)
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void erode(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, uint radius)
 	{
-		Raster<bool,Tgrid> scratch(a.grid);
-		erode(a, out, radius, scratch);
+		Mask<Tgrid> scratch(a.grid);
+		erode(policy, a, out, radius, scratch);
 	}
 
-	template <typename Tgrid>
-	void opening(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, Raster<bool,Tgrid>& scratch)
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void opening(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, Mask<Tgrid>& scratch)
+	{
+		erode ( policy, a,       scratch );
+		dilate( policy, scratch, out      );
+	}
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void opening(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out)
+	{
+		Mask<Tgrid> scratch(a.grid);
+		opening(policy, a, out, scratch);
+	}
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void opening(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, uint radius, Mask<Tgrid>& scratch1, Mask<Tgrid>& scratch2 )
+	{
+		erode ( policy, a,        scratch1, radius, scratch2 );
+		dilate( policy, scratch1, out,      radius, scratch2 );
+	}
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void opening(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, uint radius)
+	{
+		Mask<Tgrid> scratch1(a.grid);
+		Mask<Tgrid> scratch2(a.grid);
+		opening(policy, a, out, radius, scratch1, scratch2);
+	}
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void closing(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, Mask<Tgrid>& scratch)
+	{
+		dilate( policy, a,       scratch  );
+		erode ( policy, scratch, out      );
+	}
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void closing(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out)
+	{
+		Mask<Tgrid> scratch(a.grid);
+		closing(policy, a, out, scratch);
+	}
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void closing(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, uint radius, Mask<Tgrid>& scratch1, Mask<Tgrid>& scratch2 )
+	{
+		dilate( policy, a,        scratch1, radius, scratch2 );
+		erode ( policy, scratch1, out,      radius, scratch2 );
+	}
+	template <typename Tpolicy, typename Tgrid,
+		std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+	void closing(const Tpolicy policy, const Mask<Tgrid>& a, Mask<Tgrid>& out, uint radius)
+	{
+		Mask<Tgrid> scratch1(a.grid);
+		Mask<Tgrid> scratch2(a.grid);
+		closing(policy, a, out, radius, scratch1, scratch2);
+	}
+	/*
+	The functions below are written once for both `Raster<bool>` and `Mask`, like the geodesic functions further below.
+	Overloads of `dilate()` and `erode()` that accept a `radius` but no `policy` call `flood()`, so their cost does not depend on `radius`.
+	NOTE: `scratch` is no longer used since `dilate()` and `erode()` are implemented using `flood()`, it is kept for backwards compatibility
+	*/
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void dilate(const Tmask& a, Tmask& out, uint radius, Tmask& scratch)
+	{
+		dilate(a, out, radius);
+	}
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void dilate(const Tmask& a, Tmask& out, uint radius)
+	{
+		if (&out != &a)
+		{
+			copy(out, a);
+		}
+		flood(out, radius, true);
+	}
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void erode(const Tmask& a, Tmask& out, uint radius, Tmask& scratch)
+	{
+		erode(a, out, radius);
+	}
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void erode(const Tmask& a, Tmask& out, uint radius)
+	{
+		if (&out != &a)
+		{
+			copy(out, a);
+		}
+		flood(out, radius, false);
+	}
+
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void opening(const Tmask& a, Tmask& out, Tmask& scratch)
 	{
 		erode ( a,       scratch );
 		dilate( scratch, out      );
 	}
-	template <typename Tgrid>
-	void opening(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void opening(const Tmask& a, Tmask& out)
 	{
-		Raster<bool,Tgrid> scratch(a.grid);
+		Tmask scratch(a.grid);
 		opening(a, out, scratch);
 	}
-	template <typename Tgrid>
-	void opening(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius, Raster<bool,Tgrid>& scratch1, Raster<bool,Tgrid>& scratch2 )
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void opening(const Tmask& a, Tmask& out, uint radius, Tmask& scratch1, Tmask& scratch2 )
 	{
 		erode ( a,        scratch1, radius, scratch2 );
 		dilate( scratch1, out,      radius, scratch2 );
 	}
-	template <typename Tgrid>
-	void opening(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void opening(const Tmask& a, Tmask& out, uint radius)
 	{
-		Raster<bool,Tgrid> scratch1(a.grid);
-		Raster<bool,Tgrid> scratch2(a.grid);
+		Tmask scratch1(a.grid);
+		Tmask scratch2(a.grid);
 		opening(a, out, radius, scratch1, scratch2);
 	}
 
-	template <typename Tgrid>
-	void closing(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, Raster<bool,Tgrid>& scratch)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void closing(const Tmask& a, Tmask& out, Tmask& scratch)
 	{
 		dilate( a,       scratch  );
 		erode ( scratch, out      );
 	}
-	template <typename Tgrid>
-	void closing(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void closing(const Tmask& a, Tmask& out)
 	{
-		Raster<bool,Tgrid> scratch(a.grid);
+		Tmask scratch(a.grid);
 		closing(a, out, scratch);
 	}
-	template <typename Tgrid>
-	void closing(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius, Raster<bool,Tgrid>& scratch1, Raster<bool,Tgrid>& scratch2 )
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void closing(const Tmask& a, Tmask& out, uint radius, Tmask& scratch1, Tmask& scratch2 )
 	{
 		dilate( a,        scratch1, radius, scratch2 );
 		erode ( scratch1, out,      radius, scratch2 );
 	}
-	template <typename Tgrid>
-	void closing(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void closing(const Tmask& a, Tmask& out, uint radius)
 	{
-		Raster<bool,Tgrid> scratch1(a.grid);
-		Raster<bool,Tgrid> scratch2(a.grid);
+		Tmask scratch1(a.grid);
+		Tmask scratch2(a.grid);
 		closing(a, out, radius, scratch1, scratch2);
 	}
 
-	template <typename Tgrid>
-	void white_top_hat(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void white_top_hat(const Tmask& a, Tmask& out)
 	{
 		closing( a, out );
 		differ ( out,  a, out );
 	}
-	template <typename Tgrid>
-	void white_top_hat(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius, Raster<bool,Tgrid>& scratch1, Raster<bool,Tgrid>& scratch2)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void white_top_hat(const Tmask& a, Tmask& out, uint radius, Tmask& scratch1, Tmask& scratch2)
 	{
 		closing( a, out, radius, scratch1, scratch2 );
 		differ ( out,  a, out                             );
 	}
-	template <typename Tgrid>
-	void white_top_hat(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void white_top_hat(const Tmask& a, Tmask& out, uint radius)
 	{
-		Raster<bool,Tgrid> scratch1(a.grid);
-		Raster<bool,Tgrid> scratch2(a.grid);
+		Tmask scratch1(a.grid);
+		Tmask scratch2(a.grid);
 		white_top_hat(a, out, radius, scratch1, scratch2);
 	}
 
-	template <typename Tgrid>
-	void black_top_hat(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void black_top_hat(const Tmask& a, Tmask& out)
 	{
 		opening( a, out );
 		differ ( a,  out, out );
 	}
-	template <typename Tgrid>
-	void black_top_hat(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius, Raster<bool,Tgrid>& scratch1, Raster<bool,Tgrid>& scratch2)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void black_top_hat(const Tmask& a, Tmask& out, uint radius, Tmask& scratch1, Tmask& scratch2)
 	{
 		opening( a, out, radius, scratch1, scratch2 );
 		differ ( a,  out, out                             );
 	}
-	template <typename Tgrid>
-	void black_top_hat(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void black_top_hat(const Tmask& a, Tmask& out, uint radius)
 	{
-		Raster<bool,Tgrid> scratch1(a.grid);
-		Raster<bool,Tgrid> scratch2(a.grid);
+		Tmask scratch1(a.grid);
+		Tmask scratch2(a.grid);
 		black_top_hat(a, out, radius, scratch1, scratch2);
 	}
 
-
 	// NOTE: this is not a standard concept in math morphology
 	// It is meant to represent the difference between a figure and its dilation
 	// Its name eludes to the "margin" concept within the html box model
-	template <typename Tgrid>
-	void margin(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void margin(const Tmask& a, Tmask& out)
 	{
 		dilate( a, out );
 		differ( out,  a, out );
 	}
-	template <typename Tgrid>
-	void margin(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius, Raster<bool,Tgrid>& scratch)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void margin(const Tmask& a, Tmask& out, uint radius, Tmask& scratch)
 	{
 		dilate( a, out, radius, scratch );
 		differ( out,  a, out                  );
 	}
-	template <typename Tgrid>
-	void margin(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void margin(const Tmask& a, Tmask& out, uint radius)
 	{
-		Raster<bool,Tgrid> scratch(a.grid);
+		Tmask scratch(a.grid);
 		margin(a, out, radius, scratch);
 	}
-	
+
 	// NOTE: this is not a standard concept in math morphology
 	// It is meant to represent the difference between a figure and its erosion
 	// Its name eludes to the "padding" concept within the html box model
-	template <typename Tgrid>
-	void padding(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void padding(const Tmask& a, Tmask& out)
 	{
 		erode  ( a, out );
 		differ ( a,  out, out );
 	}
-	template <typename Tgrid>
-	void padding(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius, Raster<bool,Tgrid>& scratch)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void padding(const Tmask& a, Tmask& out, uint radius, Tmask& scratch)
 	{
 		erode  ( a, out, radius, scratch );
 		differ ( a,  out, out                  );
 	}
-	template <typename Tgrid>
-	void padding(const Raster<bool,Tgrid>& a, Raster<bool,Tgrid>& out, uint radius)
+	template <typename Tmask, std::enable_if_t<is_mask<Tmask>, int> = 0>
+	void padding(const Tmask& a, Tmask& out, uint radius)
 	{
-		Raster<bool,Tgrid> scratch(a.grid);
+		Tmask scratch(a.grid);
 		padding(a, out, radius, scratch);
 	}
 
+	/*
+	The functions below perform morphology where the structuring element is a geodesic disk of radius `distance`,
+	as measured along arrows by `get_geodesic_distances()`, see "distance.hpp".
+	Dilation and erosion are thresholds on a single distance transform, so their cost does not depend on `distance`,
+	and unlike the `radius` of `dilate()` and `erode()`, `distance` does not depend on how evenly the vertices of the grid are spaced.
+	They accept either `Raster<bool>` or `Mask`, and `distances` is scratch space for the distance transform.
+	*/
+	template <typename Tmask, typename T, typename Tgrid>
+	void geodesic_dilate(const Tmask& a, Tmask& out, const T distance, Raster<T,Tgrid>& distances)
+	{
+		get_geodesic_distances(a, distances, true);
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			set_cell(out, i, distances[i] <= distance);
+		}
+	}
+	template <typename Tmask>
+	void geodesic_dilate(const Tmask& a, Tmask& out, const typename decltype(Tmask::grid)::value_type distance)
+	{
+		auto distances = make_Raster<typename decltype(Tmask::grid)::value_type>(a.grid);
+		geodesic_dilate(a, out, distance, distances);
+	}
+
+	template <typename Tmask, typename T, typename Tgrid>
+	void geodesic_erode(const Tmask& a, Tmask& out, const T distance, Raster<T,Tgrid>& distances)
+	{
+		get_geodesic_distances(a, distances, false);
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			set_cell(out, i, distances[i] > distance);
+		}
+	}
+	template <typename Tmask>
+	void geodesic_erode(const Tmask& a, Tmask& out, const typename decltype(Tmask::grid)::value_type distance)
+	{
+		auto distances = make_Raster<typename decltype(Tmask::grid)::value_type>(a.grid);
+		geodesic_erode(a, out, distance, distances);
+	}
+
+	template <typename Tmask, typename T, typename Tgrid>
+	void geodesic_opening(const Tmask& a, Tmask& out, const T distance, Raster<T,Tgrid>& distances)
+	{
+		geodesic_erode ( a,   out, distance, distances );
+		geodesic_dilate( out, out, distance, distances );
+	}
+	template <typename Tmask>
+	void geodesic_opening(const Tmask& a, Tmask& out, const typename decltype(Tmask::grid)::value_type distance)
+	{
+		auto distances = make_Raster<typename decltype(Tmask::grid)::value_type>(a.grid);
+		geodesic_opening(a, out, distance, distances);
+	}
+
+	template <typename Tmask, typename T, typename Tgrid>
+	void geodesic_closing(const Tmask& a, Tmask& out, const T distance, Raster<T,Tgrid>& distances)
+	{
+		geodesic_dilate( a,   out, distance, distances );
+		geodesic_erode ( out, out, distance, distances );
+	}
+	template <typename Tmask>
+	void geodesic_closing(const Tmask& a, Tmask& out, const typename decltype(Tmask::grid)::value_type distance)
+	{
+		auto distances = make_Raster<typename decltype(Tmask::grid)::value_type>(a.grid);
+		geodesic_closing(a, out, distance, distances);
+	}
+
+	template <typename Tmask, typename T, typename Tgrid>
+	void geodesic_white_top_hat(const Tmask& a, Tmask& out, const T distance, Raster<T,Tgrid>& distances)
+	{
+		geodesic_closing( a, out, distance, distances );
+		differ          ( out,  a, out                );
+	}
+	template <typename Tmask>
+	void geodesic_white_top_hat(const Tmask& a, Tmask& out, const typename decltype(Tmask::grid)::value_type distance)
+	{
+		auto distances = make_Raster<typename decltype(Tmask::grid)::value_type>(a.grid);
+		geodesic_white_top_hat(a, out, distance, distances);
+	}
+
+	template <typename Tmask, typename T, typename Tgrid>
+	void geodesic_black_top_hat(const Tmask& a, Tmask& out, const T distance, Raster<T,Tgrid>& distances)
+	{
+		geodesic_opening( a, out, distance, distances );
+		differ          ( a,  out, out                );
+	}
+	template <typename Tmask>
+	void geodesic_black_top_hat(const Tmask& a, Tmask& out, const typename decltype(Tmask::grid)::value_type distance)
+	{
+		auto distances = make_Raster<typename decltype(Tmask::grid)::value_type>(a.grid);
+		geodesic_black_top_hat(a, out, distance, distances);
+	}
+
 }
\ No newline at end of file
@@ -41,6 +41,52 @@ TEST_CASE( "Raster dilation purity", "[rasters]" ) {
         CHECK(equal(out1, out2));
     }
 }
+TEST_CASE( "Raster dilation radius consistency", "[rasters]" ) {
+    auto top_only   =  make_Raster(diamond_grid, {false, false, true,  false, false });
+    auto expected   =  make_Raster(diamond_grid, {false, false, false, false, false });
+    auto out        =  make_Raster(diamond_grid, {false, false, false, false, false });
+    auto scratch    =  make_Raster(diamond_grid, {false, false, false, false, false });
+    SECTION("dilate(grid, top_only, 1, scratch) must generate the same output as dilate(grid, top_only)"){
+        dilate(top_only, expected);
+        dilate(top_only, out, 1, scratch);
+        CHECK(equal(out, expected));
+    }
+    SECTION("erode(grid, dilate(grid, top_only), 1, scratch) must generate the same output as erode(grid, dilate(grid, top_only))"){
+        dilate(top_only, scratch);
+        erode(scratch, expected);
+        erode(scratch, out, 1, top_only);
+        CHECK(equal(out, expected));
+    }
+    SECTION("dilate(grid, a, radius, scratch) must generate the same output as radius calls to dilate(grid, a) for odd and even radii"){
+        auto step_in    =  make_Raster(diamond_grid, {false, false, false, false, false });
+        for (uint radius = 1; radius <= 3; ++radius)
+        {
+            copy(step_in, top_only);
+            for (uint i = 0; i < radius; ++i)
+            {
+                dilate(step_in, expected);
+                copy(step_in, expected);
+            }
+            dilate(top_only, out, radius, scratch);
+            CHECK(equal(out, expected));
+        }
+    }
+    SECTION("erode(grid, a, radius, scratch) must generate the same output as radius calls to erode(grid, a) for odd and even radii"){
+        auto upper_half =  make_Raster(diamond_grid, {true,  true,  true,  true,  false });
+        auto step_in    =  make_Raster(diamond_grid, {false, false, false, false, false });
+        for (uint radius = 1; radius <= 3; ++radius)
+        {
+            copy(step_in, upper_half);
+            for (uint i = 0; i < radius; ++i)
+            {
+                erode(step_in, expected);
+                copy(step_in, expected);
+            }
+            erode(upper_half, out, radius, scratch);
+            CHECK(equal(out, expected));
+        }
+    }
+}
 TEST_CASE( "Raster dilation increasing", "[rasters]" ) {
     auto upper_half =  make_Raster(diamond_grid, {true,  true,  true,  true,  false });
     auto top_only   =  make_Raster(diamond_grid, {false, false, true,  false, false });
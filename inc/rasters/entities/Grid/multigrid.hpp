@@ -0,0 +1,285 @@
+#pragma once
+
+// C libraries
+#include <assert.h>     /* assert */
+
+// std libraries
+#include <cstddef>      // std::size_t
+#include <stdexcept>    // std::invalid_argument
+#include <type_traits>  // std::enable_if_t
+#include <vector>       // std::vector
+
+// 3rd party libraries
+#include <glm/vec3.hpp>       // *vec3
+#include <glm/geometric.hpp>  // glm::normalize, glm::distance
+
+// in-house libraries
+#include <series/execution.hpp>
+#include <series/sparse.hpp>
+#include <series/conjugate_gradient.hpp>
+
+#include "Raster.hpp"
+#include "diffusion.hpp"
+
+/*
+"multigrid.hpp" solves the implicit diffusion systems of "diffusion.hpp" using a hierarchy of nested grids.
+Iterative solvers like `series::conjugate_gradient()` only propagate information to neighboring vertices each iteration,
+so the number of iterations they need grows with the resolution of the grid.
+A multigrid cycle instead smooths out error that varies between neighbors on each grid,
+and passes the remaining error that varies smoothly down to a coarser grid, where it varies between neighbors once more.
+The cost of a cycle is proportional to the number of vertices on the finest grid,
+and the number of cycles needed to converge barely grows with resolution, so very large grids can be solved.
+*/
+
+namespace rasters
+{
+    /*
+    `get_prolongation_matrix()` returns the matrix that interpolates a raster from `coarse` onto `fine`,
+    where `fine` is a subdivision of `coarse` that preserves the ids of vertices in `coarse`, as done by `meshes::subdivide()`.
+    Vertices that `fine` shares with `coarse` are copied,
+    and each vertex that was added by subdivision takes the average of its two neighbors on `fine` that are shared with `coarse`,
+    which are the two ends of the edge that was split, so interpolation is linear along the edge.
+    Throws `std::invalid_argument` if `fine` is not a midpoint subdivision of `coarse`, 
+    i.e. if a vertex that was added does not have exactly two such neighbors, or does not lie at their midpoint.
+    The midpoint may have been projected onto the sphere whose radius is the average length of the two neighbors,
+    as done by `meshes::subdivide()` when `normalize_each_level` is set.
+    Positions are compared to within `tolerance` times the length of the edge that was split.
+    */
+    template<typename Tgrid>
+    series::SparseMatrix<typename Tgrid::value_type, typename Tgrid::size_type> get_prolongation_matrix(
+        const Tgrid& coarse,
+        const Tgrid& fine,
+        const typename Tgrid::value_type tolerance = 1e-3
+    ) {
+        typedef typename Tgrid::size_type Tid;
+        typedef typename Tgrid::value_type Tfloat;
+        typedef glm::vec<3,Tfloat,glm::defaultp> vec3;
+        const auto& structure = *fine.structure;
+        const auto& positions = fine.metrics->vertex_positions;
+        const std::size_t coarse_count = coarse.structure->vertex_count;
+        if (coarse_count >= structure.vertex_count)
+        {
+            throw std::invalid_argument("the fine grid of a prolongation must have more vertices than the coarse grid");
+        }
+        std::vector<std::size_t> row_offsets(1, 0);
+        std::vector<Tid> column_ids;
+        for (std::size_t i = 0; i < structure.vertex_count; ++i)
+        {
+            if (i < coarse_count)
+            {
+                column_ids.push_back(i);
+            }
+            else
+            {
+                for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+                {
+                    if (structure.vertex_neighbor_ids[j] < coarse_count)
+                    {
+                        column_ids.push_back(structure.vertex_neighbor_ids[j]);
+                    }
+                }
+                if (column_ids.size() - row_offsets.back() != 2)
+                {
+                    throw std::invalid_argument("a vertex of the fine grid of a prolongation does not have exactly two neighbors on the coarse grid");
+                }
+                const vec3 a = positions[column_ids[column_ids.size()-2]];
+                const vec3 b = positions[column_ids[column_ids.size()-1]];
+                const vec3 midpoint = (a + b) / Tfloat(2);
+                const vec3 projected_midpoint = glm::normalize(midpoint) * (glm::length(a) + glm::length(b)) / Tfloat(2);
+                const Tfloat max_distance = tolerance * glm::distance(a, b);
+                if (glm::distance(positions[i], midpoint) > max_distance && glm::distance(positions[i], projected_midpoint) > max_distance)
+                {
+                    throw std::invalid_argument("a vertex of the fine grid of a prolongation does not lie at the midpoint of its neighbors on the coarse grid");
+                }
+            }
+            row_offsets.push_back(column_ids.size());
+        }
+        series::SparseMatrix<Tfloat,Tid> out(structure.vertex_count, coarse_count, column_ids.size());
+        for (std::size_t i = 0; i < structure.vertex_count; ++i)
+        {
+            out.row_offsets[i+1] = row_offsets[i+1];
+            for (std::size_t j = row_offsets[i]; j < row_offsets[i+1]; ++j)
+            {
+                out.column_ids[j] = column_ids[j];
+                out.values[j] = Tfloat(1) / Tfloat(row_offsets[i+1] - row_offsets[i]);
+            }
+        }
+        return out;
+    }
+
+    /*
+    A `Multigrid` stores a hierarchy of nested grids, ordered from coarsest to finest,
+    along with the operators that transfer rasters between consecutive grids:
+    `prolongations[i]` interpolates from `grids[i]` to `grids[i+1]`,
+    and `restrictions[i]` is its transpose, which sums the residuals of the dual areas on `grids[i+1]` into `grids[i]`.
+    Since the systems of "diffusion.hpp" are scaled by dual area, the summed residuals are already scaled for the coarser grid,
+    so each coarser system can be calculated directly from the metrics of its own grid.
+
+    Rasters used during a cycle are stored within the `Multigrid` so that cycles do not allocate memory.
+    For this reason a `Multigrid` must not be used by multiple threads at once,
+    though each cycle is run according to the policy that is passed.
+    */
+    template<typename Tgrid>
+    class Multigrid
+    {
+        typedef typename Tgrid::size_type Tid;
+        typedef typename Tgrid::value_type Tfloat;
+        typedef Raster<Tfloat, Tgrid> Traster;
+
+        Tfloat coefficient;
+        std::vector<Traster> diagonals;
+        std::vector<Traster> solutions;
+        std::vector<Traster> rhs;
+        std::vector<Traster> residuals;
+
+        template<typename Tpolicy>
+        void smooth(const Tpolicy policy, const std::size_t level, const Traster& b, Traster& x)
+        {
+            const Traster& diagonal = diagonals[level];
+            Traster& residual = residuals[level];
+            for (std::size_t k = 0; k < smoothing_count; ++k)
+            {
+                implicit_diffusion_operator(policy, x, coefficient, residual);
+                series::for_each_id(policy, x.size(), [&](const std::size_t i) {
+                    x[i] += smoothing_weight * (b[i] - residual[i]) / diagonal[i];
+                });
+            }
+        }
+
+        template<typename Tpolicy>
+        void cycle(const Tpolicy policy, const std::size_t level, const Traster& b, Traster& x)
+        {
+            if (level == 0)
+            {
+                const Traster& diagonal = diagonals[0];
+                series::conjugate_gradient(policy,
+                    [&](const Traster& y, Traster& Ay) { implicit_diffusion_operator(policy, y, coefficient, Ay); },
+                    [&](const Traster& r, Traster& z) {
+                        series::for_each_id(policy, r.size(), [&](const std::size_t i) { z[i] = r[i] / diagonal[i]; });
+                    },
+                    b, x, coarsest_tolerance, grids[0].structure->vertex_count);
+                return;
+            }
+            smooth(policy, level, b, x);
+            Traster& residual = residuals[level];
+            implicit_diffusion_operator(policy, x, coefficient, residual);
+            series::for_each_id(policy, x.size(), [&](const std::size_t i) { residual[i] = b[i] - residual[i]; });
+            series::multiply(policy, restrictions[level-1], residual, rhs[level-1]);
+            Traster& correction = solutions[level-1];
+            series::for_each_id(policy, correction.size(), [&](const std::size_t i) { correction[i] = Tfloat(0); });
+            cycle(policy, level-1, rhs[level-1], correction);
+            series::multiply(policy, prolongations[level-1], correction, residual);
+            series::for_each_id(policy, x.size(), [&](const std::size_t i) { x[i] += residual[i]; });
+            smooth(policy, level, b, x);
+        }
+
+    public:
+        std::vector<Tgrid> grids;
+        std::vector<series::SparseMatrix<Tfloat,Tid>> prolongations;
+        std::vector<series::SparseMatrix<Tfloat,Tid>> restrictions;
+
+        // the number of damped Jacobi sweeps that are run on each grid both before and after visiting the coarser grid
+        std::size_t smoothing_count;
+        // the damping factor of each Jacobi sweep
+        Tfloat smoothing_weight;
+        // the relative tolerance to which the system on the coarsest grid is solved during a cycle
+        double coarsest_tolerance;
+
+        /*
+        `grids` must be ordered from coarsest to finest, where each grid is a subdivision of the last,
+        see `get_prolongation_matrix()`.
+        */
+        explicit Multigrid(
+            const std::vector<Tgrid>& grids,
+            const std::size_t smoothing_count = 2,
+            const Tfloat smoothing_weight = Tfloat(2)/Tfloat(3),
+            const double coarsest_tolerance = 1e-6
+        ):
+            coefficient(-1),
+            grids(grids),
+            smoothing_count(smoothing_count),
+            smoothing_weight(smoothing_weight),
+            coarsest_tolerance(coarsest_tolerance)
+        {
+            if (grids.empty())
+            {
+                throw std::invalid_argument("a multigrid hierarchy must have at least one grid");
+            }
+            for (std::size_t i = 0; i+1 < grids.size(); ++i)
+            {
+                prolongations.push_back(get_prolongation_matrix(grids[i], grids[i+1]));
+                restrictions.push_back(series::transpose(prolongations.back()));
+            }
+            for (const Tgrid& grid : grids)
+            {
+                diagonals.emplace_back(grid);
+                solutions.emplace_back(grid);
+                rhs.emplace_back(grid);
+                residuals.emplace_back(grid);
+            }
+        }
+
+        /*
+        `v_cycle()` improves `x` as a solution to the symmetric system of `implicit_diffusion_operator()`, `(A - cK) x = b`,
+        where `b` and `x` are rasters on the finest grid, and `c` is `coefficient`.
+        Each cycle is a symmetric operator on `b` when `x` is zero on input,
+        so that it can be used to precondition `series::conjugate_gradient()`.
+        */
+        template<typename Tpolicy,
+            std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+        void v_cycle(const Tpolicy policy, const Tfloat coefficient, const Traster& b, Traster& x)
+        {
+            if (coefficient != this->coefficient)
+            {
+                this->coefficient = coefficient;
+                for (Traster& diagonal : diagonals)
+                {
+                    implicit_diffusion_diagonal(policy, coefficient, diagonal);
+                }
+            }
+            cycle(policy, grids.size()-1, b, x);
+        }
+        void v_cycle(const Tfloat coefficient, const Traster& b, Traster& x)
+        {
+            v_cycle(series::sequenced, coefficient, b, x);
+        }
+    };
+
+    /*
+    `implicit_diffusion()` behaves as it does in "diffusion.hpp", but preconditions each iteration with a cycle of `multigrid`,
+    so that the number of iterations needed barely grows with the resolution of the grid.
+    `field` must be a raster on the finest grid of `multigrid`.
+    */
+    template<typename Tpolicy, typename Tgrid,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    series::ConjugateGradientResult implicit_diffusion(
+        const Tpolicy policy,
+        Multigrid<Tgrid>& multigrid,
+        const Raster<typename Tgrid::value_type, Tgrid>& field,
+        const typename Tgrid::value_type coefficient,
+        Raster<typename Tgrid::value_type, Tgrid>& out,
+        const double tolerance = 1e-5,
+        const std::size_t max_iterations = 100
+    ) {
+        typedef Raster<typename Tgrid::value_type, Tgrid> Traster;
+        assert(field.grid.structure == multigrid.grids.back().structure);
+        return implicit_diffusion(policy, field, coefficient, out,
+            [&](const Traster& r, Traster& z) {
+                series::for_each_id(policy, z.size(), [&](const std::size_t i) { z[i] = 0; });
+                multigrid.v_cycle(policy, coefficient, r, z);
+            },
+            tolerance, max_iterations);
+    }
+
+    template<typename Tgrid>
+    series::ConjugateGradientResult implicit_diffusion(
+        Multigrid<Tgrid>& multigrid,
+        const Raster<typename Tgrid::value_type, Tgrid>& field,
+        const typename Tgrid::value_type coefficient,
+        Raster<typename Tgrid::value_type, Tgrid>& out,
+        const double tolerance = 1e-5,
+        const std::size_t max_iterations = 100
+    ) {
+        return implicit_diffusion(series::sequenced, multigrid, field, coefficient, out, tolerance, max_iterations);
+    }
+}
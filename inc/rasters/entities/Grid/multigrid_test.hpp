@@ -0,0 +1,145 @@
+
+// std libraries
+#include <algorithm> // std::max
+#include <cmath>     // std::abs
+#include <random>    // std::mt19937
+#include <stdexcept> // std::invalid_argument
+#include <vector>    // std::vector
+
+// 3rd party libraries
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch/catch.hpp"
+
+#define GLM_FORCE_PURE     // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>             // *vec3
+
+// in-house libraries
+#include <series/types.hpp>  
+#include <series/sparse.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+#include <series/glm/random.hpp>      // get_elias_noise
+
+#include <meshes/mesh.hpp>
+
+#include "Grid.hpp"
+#include "Raster.hpp"
+#include "diffusion.hpp"
+#include "multigrid.hpp"
+
+// returns grids for an icosahedron and each of its first `level_count-1` subdivisions
+std::vector<rasters::Grid<uint,float>> get_subdivided_grids(const std::size_t level_count)
+{
+    std::vector<rasters::Grid<uint,float>> grids;
+    meshes::mesh icosphere = meshes::icosahedron;
+    for (std::size_t i = 0; i < level_count; ++i)
+    {
+        if (i > 0) { icosphere = meshes::subdivide(icosphere); }
+        grids.emplace_back(icosphere.vertices, icosphere.faces);
+    }
+    return grids;
+}
+
+TEST_CASE( "Multigrid get_prolongation_matrix() correctness", "[rasters]" ) {
+    const auto grids = get_subdivided_grids(3);
+    const auto& coarse = grids[1];
+    const auto& fine = grids[2];
+    const auto prolongation = rasters::get_prolongation_matrix(coarse, fine);
+    SECTION("get_prolongation_matrix() must interpolate a linear field exactly between the grids of a midpoint subdivision"){
+        auto coarse_field = rasters::make_Raster<float>(coarse);
+        auto expected = rasters::make_Raster<float>(fine);
+        auto out = rasters::make_Raster<float>(fine);
+        for (unsigned int i = 0; i < coarse_field.size(); ++i)
+        {
+            coarse_field[i] = glm::dot(coarse.metrics->vertex_positions[i], glm::vec3(1,2,3));
+        }
+        for (unsigned int i = 0; i < expected.size(); ++i)
+        {
+            expected[i] = glm::dot(fine.metrics->vertex_positions[i], glm::vec3(1,2,3));
+        }
+        series::multiply(prolongation, coarse_field, out);
+        float max_error = 0;
+        for (unsigned int i = 0; i < out.size(); ++i)
+        {
+            max_error = std::max(max_error, std::abs(out[i] - expected[i]));
+        }
+        CHECK(max_error < 1e-5f);
+    }
+    SECTION("get_prolongation_matrix() must give each vertex added by midpoint subdivision exactly two parents"){
+        int error_count = 0;
+        for (unsigned int i = coarse.structure->vertex_count; i < fine.structure->vertex_count; ++i)
+        {
+            error_count += prolongation.row_offsets[i+1] - prolongation.row_offsets[i] != 2;
+        }
+        CHECK(error_count == 0);
+    }
+    SECTION("get_prolongation_matrix() must reject grids that are not nested"){
+        CHECK_THROWS_AS(rasters::get_prolongation_matrix(fine, coarse), std::invalid_argument);
+    }
+    SECTION("get_prolongation_matrix() must accept midpoint subdivisions whose vertices are projected onto a sphere"){
+        const meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 2, true);
+        const meshes::mesh coarse_icosphere = meshes::subdivide(meshes::icosahedron, 1, true);
+        const rasters::Grid<uint,float> spheroid_coarse(coarse_icosphere.vertices, coarse_icosphere.faces);
+        const rasters::Grid<uint,float> spheroid_fine(icosphere.vertices, icosphere.faces);
+        CHECK_NOTHROW(rasters::get_prolongation_matrix(spheroid_coarse, spheroid_fine));
+    }
+    SECTION("get_prolongation_matrix() must reject grids whose added vertices do not lie at the midpoint of an edge"){
+        meshes::mesh displaced = meshes::subdivide(meshes::subdivide(meshes::icosahedron));
+        const std::size_t i = coarse.structure->vertex_count;
+        displaced.vertices[i] = displaced.vertices[i] * 0.5f;
+        const rasters::Grid<uint,float> displaced_fine(displaced.vertices, displaced.faces);
+        CHECK_THROWS_AS(rasters::get_prolongation_matrix(coarse, displaced_fine), std::invalid_argument);
+    }
+}
+
+TEST_CASE( "Multigrid implicit_diffusion() correctness", "[rasters]" ) {
+    const auto grids = get_subdivided_grids(5);
+    const auto& grid = grids.back();
+    rasters::Multigrid<rasters::Grid<uint,float>> multigrid(grids);
+    std::mt19937 generator(2);
+    auto field = rasters::make_Raster<float>(grid);
+    series::get_elias_noise(grid.metrics->vertex_positions, generator, field);
+    auto out = rasters::make_Raster<float>(grid);
+    auto expected = rasters::make_Raster<float>(grid);
+
+    SECTION("implicit_diffusion() must produce the same output with or without multigrid preconditioning"){
+        for (const float coefficient : {0.01f, 1.0f, 100.0f})
+        {
+            const auto result = rasters::implicit_diffusion(multigrid, field, coefficient, out, 1e-6);
+            rasters::implicit_diffusion(field, coefficient, expected, 1e-6);
+            float max_difference = 0;
+            float max_magnitude = 0;
+            for (unsigned int i = 0; i < out.size(); ++i)
+            {
+                max_difference = std::max(max_difference, std::abs(out[i] - expected[i]));
+                max_magnitude = std::max(max_magnitude, std::abs(expected[i]));
+            }
+            CHECK(result.converged);
+            CHECK(max_difference / max_magnitude < 1e-4f);
+        }
+    }
+    SECTION("implicit_diffusion() must converge in fewer iterations with multigrid preconditioning than with Jacobi preconditioning"){
+        const auto result = rasters::implicit_diffusion(multigrid, field, 1.0f, out, 1e-6);
+        const auto jacobi_result = rasters::implicit_diffusion(field, 1.0f, expected, 1e-6);
+        CHECK(result.iteration_count * 4 < jacobi_result.iteration_count);
+    }
+    SECTION("implicit_diffusion() must converge in a number of iterations that barely grows with resolution"){
+        const std::vector<rasters::Grid<uint,float>> coarse_grids(grids.begin(), grids.end()-2);
+        rasters::Multigrid<rasters::Grid<uint,float>> coarse_multigrid(coarse_grids);
+        auto coarse_field = rasters::make_Raster<float>(coarse_grids.back());
+        auto coarse_out = rasters::make_Raster<float>(coarse_grids.back());
+        series::get_elias_noise(coarse_grids.back().metrics->vertex_positions, generator, coarse_field);
+        const auto coarse_result = rasters::implicit_diffusion(coarse_multigrid, coarse_field, 1.0f, coarse_out, 1e-6);
+        const auto result = rasters::implicit_diffusion(multigrid, field, 1.0f, out, 1e-6);
+        CHECK(result.iteration_count <= coarse_result.iteration_count + 3);
+    }
+    SECTION("implicit_diffusion() must produce the same output regardless of policy"){
+        rasters::implicit_diffusion(multigrid, field, 1.0f, out, 1e-6);
+        rasters::implicit_diffusion(series::ParallelPolicy(4, 16), multigrid, field, 1.0f, expected, 1e-6);
+        float max_difference = 0;
+        for (unsigned int i = 0; i < out.size(); ++i)
+        {
+            max_difference = std::max(max_difference, std::abs(out[i] - expected[i]));
+        }
+        CHECK(max_difference < 1e-3f);
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+// 3rd party libraries
+#include <glm/vec3.hpp>               // *vec3
+
+// in-house libraries
+#include <series/types.hpp>
+#include <series/execution.hpp>
+#include <series/sparse.hpp>
+#include <series/glm/sparse.hpp>
+
+#include "Grid.hpp"
+
+/*
+"sparse.hpp" assembles the operators of "vector_calculus.hpp" as sparse matrices, see "series/sparse.hpp".
+A matrix only has to be assembled once per grid, after which it can be applied to any number of rasters using `series::multiply()`,
+including several rasters at once, or each layer of a `LayeredRaster`.
+Row `i` of a matrix has an entry for vertex `i` followed by an entry for each of its neighbors,
+in the same order as `Structure::vertex_neighbor_ids`, so the rows of each matrix share the same pattern.
+Rows are assembled according to `policy`, see "series/execution.hpp".
+Row offsets do not depend on the id type of the grid, so matrices of grids with `std::uint16_t` ids may have more than 65535 entries.
+*/
+
+namespace rasters
+{
+    template<typename T, typename Tid>
+    series::SparseMatrix<T,Tid> get_vertex_neighbor_matrix(const Structure<Tid>& structure)
+    {
+        series::SparseMatrix<T,Tid> out(structure.vertex_count, structure.vertex_count, structure.vertex_neighbor_ids.size() + structure.vertex_count);
+        for (std::size_t i = 0; i < structure.vertex_count; ++i)
+        {
+            out.row_offsets[i+1] = structure.vertex_neighbor_offsets[i+1] + i+1;
+        }
+        return out;
+    }
+
+    /*
+    `get_laplacian_matrix()` returns a matrix that calculates the same output as `laplacian()` for a scalar raster on `grid`.
+    */
+    template<typename Tpolicy, typename Tgrid,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    series::SparseMatrix<typename Tgrid::value_type, typename Tgrid::size_type> get_laplacian_matrix(
+        const Tpolicy policy,
+        const Tgrid& grid
+    ) {
+        typedef typename Tgrid::value_type Tfloat;
+        const auto& metrics = *grid.metrics;
+        const auto& structure = *grid.structure;
+        auto out = get_vertex_neighbor_matrix<Tfloat>(structure);
+        series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+            const std::size_t diagonal_id = out.row_offsets[i];
+            Tfloat diagonal(0);
+            for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                const Tfloat weight = metrics.arrow_dual_lengths[arrow_id] / metrics.arrow_lengths[arrow_id] / metrics.vertex_dual_areas[i]; // slope weighted by dual length
+                out.column_ids[j+i+1] = structure.vertex_neighbor_ids[j];
+                out.values[j+i+1] = weight;
+                diagonal -= weight;
+            }
+            out.column_ids[diagonal_id] = i;
+            out.values[diagonal_id] = diagonal;
+        });
+        return out;
+    }
+    template<typename Tgrid>
+    series::SparseMatrix<typename Tgrid::value_type, typename Tgrid::size_type> get_laplacian_matrix(const Tgrid& grid)
+    {
+        return get_laplacian_matrix(series::sequenced, grid);
+    }
+
+    /*
+    `get_gradient_matrix()` returns a matrix that calculates the same output as `gradient()` for a scalar raster on `grid`.
+    Entries of the matrix are vectors, so its product with a scalar raster is a vector raster.
+    */
+    template<typename Tpolicy, typename Tgrid,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    series::SparseMatrix<glm::vec<3,typename Tgrid::value_type,glm::defaultp>, typename Tgrid::size_type> get_gradient_matrix(
+        const Tpolicy policy,
+        const Tgrid& grid
+    ) {
+        typedef glm::vec<3,typename Tgrid::value_type,glm::defaultp> vec3;
+        const auto& metrics = *grid.metrics;
+        const auto& structure = *grid.structure;
+        auto out = get_vertex_neighbor_matrix<vec3>(structure);
+        series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+            const std::size_t diagonal_id = out.row_offsets[i];
+            vec3 diagonal(0);
+            for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                const vec3 weight = metrics.arrow_dual_normals[arrow_id] * metrics.arrow_dual_lengths[arrow_id] / metrics.vertex_dual_areas[i]; // flow across dual of the arrow
+                out.column_ids[j+i+1] = structure.vertex_neighbor_ids[j];
+                out.values[j+i+1] = weight;
+                diagonal -= weight;
+            }
+            out.column_ids[diagonal_id] = i;
+            out.values[diagonal_id] = diagonal;
+        });
+        return out;
+    }
+    template<typename Tgrid>
+    series::SparseMatrix<glm::vec<3,typename Tgrid::value_type,glm::defaultp>, typename Tgrid::size_type> get_gradient_matrix(const Tgrid& grid)
+    {
+        return get_gradient_matrix(series::sequenced, grid);
+    }
+
+    /*
+    `get_divergence_matrix()` returns a matrix that calculates the same output as `divergence()` for a vector raster on `grid`.
+    Its entries are the same as those of `get_gradient_matrix()`, since both find the flow across the dual of each arrow,
+    but its product with a vector raster takes the dot product of each entry, see "series/glm/sparse.hpp".
+    */
+    template<typename Tpolicy, typename Tgrid,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    series::SparseMatrix<glm::vec<3,typename Tgrid::value_type,glm::defaultp>, typename Tgrid::size_type> get_divergence_matrix(
+        const Tpolicy policy,
+        const Tgrid& grid
+    ) {
+        return get_gradient_matrix(policy, grid);
+    }
+    template<typename Tgrid>
+    series::SparseMatrix<glm::vec<3,typename Tgrid::value_type,glm::defaultp>, typename Tgrid::size_type> get_divergence_matrix(const Tgrid& grid)
+    {
+        return get_divergence_matrix(series::sequenced, grid);
+    }
+}
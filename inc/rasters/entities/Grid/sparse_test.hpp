@@ -0,0 +1,118 @@
+
+// std libraries
+#include <cmath>    // std::abs
+#include <cstdint>  // std::uint16_t
+#include <limits>   // std::numeric_limits
+#include <random>   // std::mt19937
+
+// 3rd party libraries
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch/catch.hpp"
+
+#define GLM_FORCE_PURE     // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>             // *vec3
+
+// in-house libraries
+#include <series/types.hpp>  
+#include <series/sparse.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+#include <series/glm/random.hpp>      // get_elias_noise
+
+#include <meshes/mesh.hpp>
+
+#include "Grid.hpp"
+#include "Raster.hpp"
+#include "vector_calculus.hpp"
+#include "sparse.hpp"
+
+// returns the largest difference between elements, relative to the largest element of `b`
+template<typename T>
+float get_relative_difference(const T& a, const T& b)
+{
+    float max_difference = 0;
+    float max_magnitude = 0;
+    for (unsigned int i = 0; i < a.size(); ++i)
+    {
+        max_difference = std::max(max_difference, glm::length(glm::vec3(a[i] - b[i])));
+        max_magnitude = std::max(max_magnitude, glm::length(glm::vec3(b[i])));
+    }
+    return max_difference / max_magnitude;
+}
+
+TEST_CASE( "Grid sparse matrix consistency", "[rasters]" ) {
+    const meshes::mesh icosphere = meshes::subdivide(meshes::subdivide(meshes::icosahedron));
+    const rasters::Grid<uint,float> grid(icosphere.vertices, icosphere.faces);
+    std::mt19937 generator(2);
+    auto a = rasters::make_Raster<float>(grid);
+    auto b = rasters::make_Raster<float>(grid);
+    series::get_elias_noise(grid.metrics->vertex_positions, generator, a);
+    series::get_elias_noise(grid.metrics->vertex_positions, generator, b);
+
+    SECTION("get_laplacian_matrix() must produce a matrix that calculates the same output as laplacian()"){
+        auto expected = rasters::make_Raster<float>(grid);
+        auto out = rasters::make_Raster<float>(grid);
+        rasters::laplacian(a, expected);
+        series::multiply(rasters::get_laplacian_matrix(grid), a, out);
+        CHECK(get_relative_difference(out, expected) < 1e-4f);
+    }
+    SECTION("get_gradient_matrix() must produce a matrix that calculates the same output as gradient()"){
+        auto expected = rasters::make_Raster<glm::vec3>(grid);
+        auto out = rasters::make_Raster<glm::vec3>(grid);
+        rasters::gradient(a, expected);
+        series::multiply(rasters::get_gradient_matrix(grid), a, out);
+        CHECK(get_relative_difference(out, expected) < 1e-4f);
+    }
+    SECTION("get_divergence_matrix() must produce a matrix that calculates the same output as divergence()"){
+        auto field = rasters::make_Raster<glm::vec3>(grid);
+        rasters::gradient(a, field);
+        auto expected = rasters::make_Raster<float>(grid);
+        auto out = rasters::make_Raster<float>(grid);
+        rasters::divergence(field, expected);
+        series::multiply(rasters::get_divergence_matrix(grid), field, out);
+        CHECK(get_relative_difference(out, expected) < 1e-4f);
+        series::multiply(series::ParallelPolicy(4, 16), rasters::get_divergence_matrix(grid), field, out);
+        CHECK(get_relative_difference(out, expected) < 1e-4f);
+    }
+    SECTION("Matrices must calculate the same output for interleaved right hand sides as they do for each right hand side"){
+        const auto laplacian_matrix = rasters::get_laplacian_matrix(series::ParallelPolicy(4, 16), grid);
+        series::floats interleaved(2*a.size());
+        for (unsigned int i = 0; i < a.size(); ++i)
+        {
+            interleaved[2*i]   = a[i];
+            interleaved[2*i+1] = b[i];
+        }
+        series::floats interleaved_out(2*a.size());
+        series::floats a_out(a.size());
+        series::floats b_out(b.size());
+        series::multiply(series::ParallelPolicy(4, 16), laplacian_matrix, interleaved, interleaved_out, 2);
+        series::multiply(laplacian_matrix, a, a_out);
+        series::multiply(laplacian_matrix, b, b_out);
+        int error_count = 0;
+        for (unsigned int i = 0; i < a.size(); ++i)
+        {
+            error_count += interleaved_out[2*i] != a_out[i] || interleaved_out[2*i+1] != b_out[i];
+        }
+        CHECK(error_count == 0);
+    }
+}
+
+TEST_CASE( "Grid sparse matrix with narrow ids", "[rasters]" ) {
+    // a level 5 icosphere has 10242 vertices and 61440 arrows, so its matrices have more entries than a std::uint16_t can count
+    const meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 5, true);
+    const series::Series<glm::vec<3,std::uint16_t,glm::defaultp>> faces(icosphere.faces);
+    const rasters::Grid<std::uint16_t,float> grid(icosphere.vertices, faces);
+    std::mt19937 generator(2);
+    auto a = rasters::make_Raster<float>(grid);
+    series::get_elias_noise(grid.metrics->vertex_positions, generator, a);
+
+    SECTION("get_laplacian_matrix() must count every entry and calculate the same output as laplacian()"){
+        const auto matrix = rasters::get_laplacian_matrix(grid);
+        CHECK(matrix.row_offsets.back() == grid.structure->arrow_count + grid.structure->vertex_count);
+        CHECK(matrix.nonzero_count() > std::numeric_limits<std::uint16_t>::max());
+        auto expected = rasters::make_Raster<float>(grid);
+        auto out = rasters::make_Raster<float>(grid);
+        rasters::laplacian(a, expected);
+        series::multiply(matrix, a, out);
+        CHECK(get_relative_difference(out, expected) < 1e-4f);
+    }
+}
@@ -2,3 +2,10 @@
 #include "./Raster_test.hpp"
 #include "./morphologic_test.hpp"
 #include "./Grid_test.hpp"
+#include "./sparse_test.hpp"
+#include "./diffusion_test.hpp"
+#include "./multigrid_test.hpp"
+#include "./Mask_test.hpp"
+#include "./distance_test.hpp"
+#include "./grayscale_test.hpp"
+#include "./labeling_test.hpp"
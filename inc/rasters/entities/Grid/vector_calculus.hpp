@@ -1,5 +1,6 @@
 #pragma once
 #include <series/arithmetic.hpp>
+#include <series/execution.hpp>
 #include <series/glm/geometric.hpp>
 #include "../Grid/Raster.hpp"
 
@@ -96,6 +97,97 @@ namespace rasters
     This polygon is part of the "dual" of the graph that's formed from the centroid and its neighbors.
     
     */
+    /*
+    The functions below gather the flow across the dual of each arrow directly into the vertex the arrow departs from,
+    using the neighbors that are listed for each vertex in `Structure::vertex_neighbor_*`.
+    They calculate the same result as the functions that accept arrow rasters as scratch space, 
+    but in a single pass, without having to store anything per arrow.
+    Each vertex only writes to its own output, so the loop can be run in parallel, see "series/execution.hpp".
+    */
+    template<typename Tpolicy, typename T, typename Tgrid, glm::qualifier Q, 
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void gradient(
+        const Tpolicy policy,
+        const Raster<T, Tgrid>& scalar_field, 
+        Raster<glm::vec<3,T,Q>, Tgrid>& out
+    ) {
+        const auto& metrics = *scalar_field.grid.metrics;
+        const auto& structure = *scalar_field.grid.structure;
+        series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+            glm::vec<3,T,Q> flow(0.f);
+            for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                const T differential = scalar_field[structure.vertex_neighbor_ids[j]] - scalar_field[i]; // differential across dual of the arrow
+                flow += differential * metrics.arrow_dual_normals[arrow_id] * metrics.arrow_dual_lengths[arrow_id]; // flow across dual of the arrow
+            }
+            out[i] = flow / metrics.vertex_dual_areas[i]; // gradient
+        });
+    }
+    template<typename T, typename Tgrid, glm::qualifier Q>
+    void gradient(
+        const Raster<T, Tgrid>& scalar_field, 
+        Raster<glm::vec<3,T,Q>, Tgrid>& out
+    ) {
+        rasters::gradient(series::sequenced, scalar_field, out);
+    }
+
+    template<typename Tpolicy, typename T, typename Tgrid, glm::qualifier Q, 
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void divergence(
+        const Tpolicy policy,
+        const Raster<glm::vec<3,T,Q>, Tgrid>& vector_field, 
+        Raster<T, Tgrid>& out
+    ) {
+        const auto& metrics = *vector_field.grid.metrics;
+        const auto& structure = *vector_field.grid.structure;
+        series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+            T flow(0.f);
+            for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                const glm::vec<3,T,Q> differential = vector_field[structure.vertex_neighbor_ids[j]] - vector_field[i]; // differential across dual of the arrow
+                flow += glm::dot(differential, metrics.arrow_dual_normals[arrow_id]) * metrics.arrow_dual_lengths[arrow_id]; // flow across dual of the arrow
+            }
+            out[i] = flow / metrics.vertex_dual_areas[i]; // divergence
+        });
+    }
+    template<typename T, typename Tgrid, glm::qualifier Q>
+    void divergence(
+        const Raster<glm::vec<3,T,Q>, Tgrid>& vector_field, 
+        Raster<T, Tgrid>& out
+    ) {
+        rasters::divergence(series::sequenced, vector_field, out);
+    }
+
+    template<typename Tpolicy, typename T, typename Tgrid, glm::qualifier Q, 
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void curl(
+        const Tpolicy policy,
+        const Raster<glm::vec<3,T,Q>, Tgrid>& vector_field, 
+        Raster<glm::vec<3,T,Q>, Tgrid>& out
+    ) {
+        const auto& metrics = *vector_field.grid.metrics;
+        const auto& structure = *vector_field.grid.structure;
+        series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+            glm::vec<3,T,Q> flow(0.f);
+            for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                const glm::vec<3,T,Q> differential = vector_field[structure.vertex_neighbor_ids[j]] - vector_field[i]; // differential across dual of the arrow
+                flow += glm::cross(differential, metrics.arrow_dual_normals[arrow_id]) * metrics.arrow_dual_lengths[arrow_id]; // flow across dual of the arrow
+            }
+            out[i] = flow / metrics.vertex_dual_areas[i]; // curl
+        });
+    }
+    template<typename T, typename Tgrid, glm::qualifier Q>
+    void curl(
+        const Raster<glm::vec<3,T,Q>, Tgrid>& vector_field, 
+        Raster<glm::vec<3,T,Q>, Tgrid>& out
+    ) {
+        rasters::curl(series::sequenced, vector_field, out);
+    }
+
     template<typename T, typename Tgrid, glm::qualifier Q>
     void gradient(
         const Raster<T, Tgrid>& scalar_field, 
@@ -123,10 +215,8 @@ namespace rasters
     {
         const auto metrics = scalar_field.grid.metrics;
         const auto structure = scalar_field.grid.structure;
-        Raster<T, Tgrid, mapping::arrow>         arrow_differential (scalar_field.grid);
-        Raster<glm::vec3, Tgrid, mapping::arrow> arrow_flow         (scalar_field.grid);
         Raster<glm::vec3, Tgrid> out                (scalar_field.grid);
-        rasters::gradient(scalar_field, out, arrow_differential, arrow_flow);
+        rasters::gradient(scalar_field, out);
         return out;
     }
 
@@ -157,10 +247,8 @@ namespace rasters
     {
         const auto metrics = vector_field.grid.metrics;
         const auto structure = vector_field.grid.structure;
-        Raster<glm::vec<3,T,Q>, Tgrid, mapping::arrow> arrow_differential (vector_field.grid);
-        Raster<T, Tgrid, mapping::arrow>               arrow_projection   (vector_field.grid);
         Raster<T, Tgrid>               out                (vector_field.grid);
-        rasters::divergence(vector_field, out, arrow_differential, arrow_projection);
+        rasters::divergence(vector_field, out);
         return out;
     }
 
@@ -191,10 +279,8 @@ namespace rasters
     {
         const auto metrics = vector_field.grid.metrics;
         const auto structure = vector_field.grid.structure;
-        Raster<glm::vec<3,T,Q>, Tgrid, mapping::arrow> arrow_differential (vector_field.grid);
-        Raster<glm::vec<3,T,Q>, Tgrid, mapping::arrow> arrow_rejection    (vector_field.grid);
         Raster<glm::vec<3,T,Q>, Tgrid> out                (vector_field.grid);
-        rasters::curl(vector_field, out, arrow_differential, arrow_rejection);
+        rasters::curl(vector_field, out);
         return out;
     }
     /*
@@ -216,6 +302,34 @@ namespace rasters
     weighted by the sections of the boundary shared between those neighbors, 
     and divided by the area that's enclosed by the boundary. 
     */
+    template<typename Tpolicy, typename T, typename Tgrid, 
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void laplacian(
+        const Tpolicy policy,
+        const Raster<T, Tgrid>& field, 
+        Raster<T, Tgrid>& out
+    ) {
+        const auto& metrics = *field.grid.metrics;
+        const auto& structure = *field.grid.structure;
+        series::for_each_id(policy, structure.vertex_count, [&](const std::size_t i) {
+            T flow(0.f);
+            for (std::size_t j = structure.vertex_neighbor_offsets[i]; j < structure.vertex_neighbor_offsets[i+1]; ++j)
+            {
+                const std::size_t arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                const T differential = field[structure.vertex_neighbor_ids[j]] - field[i]; // differential across dual of the arrow
+                flow += differential / metrics.arrow_lengths[arrow_id] * metrics.arrow_dual_lengths[arrow_id]; // slope weighted by dual length
+            }
+            out[i] = flow / metrics.vertex_dual_areas[i]; // laplacian
+        });
+    }
+    template<typename T, typename Tgrid>
+    void laplacian(
+        const Raster<T, Tgrid>& field, 
+        Raster<T, Tgrid>& out
+    ) {
+        rasters::laplacian(series::sequenced, field, out);
+    }
+
     template<typename T, typename Tgrid>
     void laplacian(
         const Raster<T, Tgrid>& scalar_field, 
@@ -241,9 +355,8 @@ namespace rasters
     {
         const auto metrics = scalar_field.grid.metrics;
         const auto structure = scalar_field.grid.structure;
-        Raster<T, Tgrid, mapping::arrow> arrow_scratch (scalar_field.grid);
         Raster<T, Tgrid> out           (scalar_field.grid);
-        rasters::laplacian(scalar_field, out, arrow_scratch);
+        rasters::laplacian(scalar_field, out);
         return out;
     }
 
@@ -273,9 +386,8 @@ namespace rasters
     {
         const auto metrics = vector_field.grid.metrics;
         const auto structure = vector_field.grid.structure;
-        Raster<glm::vec<L,T,Q>, Tgrid, mapping::arrow> arrow_scratch (vector_field.grid);
         Raster<glm::vec<L,T,Q>, Tgrid> out           (vector_field.grid);
-        rasters::laplacian(vector_field, out, arrow_scratch);
+        rasters::laplacian(vector_field, out);
         return out;
     }
 }
\ No newline at end of file
@@ -416,4 +416,58 @@ TEST_CASE( "Raster laplacian determinism", "[rasters]" ) {
 //     SECTION("laplacian(a) must generate the same output as div(grad(a))"){
 //         CHECK(series::equal(laplacian_a, div_grad_a));
 //     }
-// }
\ No newline at end of file
+// }
+TEST_CASE( "Raster vector calculus fused consistency", "[rasters]" ) {
+    auto a = make_Raster<float>(nonspheroid_icosahedron_grid, {1,2,3,4,5,6,7,8,9,10,11,12});
+    auto v = make_Raster<glm::vec3>(nonspheroid_icosahedron_grid);
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = glm::vec3(i, 2*i, 12-i);
+    }
+    auto arrow_floats1 = make_Raster<float,     rasters::mapping::arrow>(nonspheroid_icosahedron_grid);
+    auto arrow_floats2 = make_Raster<float,     rasters::mapping::arrow>(nonspheroid_icosahedron_grid);
+    auto arrow_vec3s1  = make_Raster<glm::vec3, rasters::mapping::arrow>(nonspheroid_icosahedron_grid);
+    auto arrow_vec3s2  = make_Raster<glm::vec3, rasters::mapping::arrow>(nonspheroid_icosahedron_grid);
+    auto floats1 = make_Raster<float>(nonspheroid_icosahedron_grid);
+    auto floats2 = make_Raster<float>(nonspheroid_icosahedron_grid);
+    auto floats3 = make_Raster<float>(nonspheroid_icosahedron_grid);
+    auto vec3s1  = make_Raster<glm::vec3>(nonspheroid_icosahedron_grid);
+    auto vec3s2  = make_Raster<glm::vec3>(nonspheroid_icosahedron_grid);
+    auto vec3s3  = make_Raster<glm::vec3>(nonspheroid_icosahedron_grid);
+    // the grid is far smaller than the default block size, so blocks of a single vertex are needed to run in parallel
+    const series::ParallelPolicy parallel(4, 1);
+
+    SECTION("gradient(a, out) must generate the same output as gradient(a, out, scratch1, scratch2)"){
+        gradient(a, vec3s1, arrow_floats1, arrow_vec3s1);
+        gradient(a, vec3s2);
+        gradient(parallel, a, vec3s3);
+        CHECK(series::equal(vec3s1, vec3s2, 1e-4f));
+        CHECK(series::equal(vec3s2, vec3s3));
+    }
+    SECTION("divergence(a, out) must generate the same output as divergence(a, out, scratch1, scratch2)"){
+        divergence(v, floats1, arrow_vec3s1, arrow_floats1);
+        divergence(v, floats2);
+        divergence(parallel, v, floats3);
+        CHECK(series::equal(floats1, floats2, 1e-4f));
+        CHECK(series::equal(floats2, floats3));
+    }
+    SECTION("curl(a, out) must generate the same output as curl(a, out, scratch1, scratch2)"){
+        curl(v, vec3s1, arrow_vec3s1, arrow_vec3s2);
+        curl(v, vec3s2);
+        curl(parallel, v, vec3s3);
+        CHECK(series::equal(vec3s1, vec3s2, 1e-4f));
+        CHECK(series::equal(vec3s2, vec3s3));
+    }
+    SECTION("laplacian(a, out) must generate the same output as laplacian(a, out, scratch)"){
+        laplacian(a, floats1, arrow_floats1);
+        laplacian(a, floats2);
+        laplacian(parallel, a, floats3);
+        CHECK(series::equal(floats1, floats2, 1e-4f));
+        CHECK(series::equal(floats2, floats3));
+        laplacian(v, vec3s1, arrow_vec3s1);
+        laplacian(v, vec3s2);
+        laplacian(parallel, v, vec3s3);
+        CHECK(series::equal(vec3s1, vec3s2, 1e-4f));
+        CHECK(series::equal(vec3s2, vec3s3));
+    }
+}
@@ -91,6 +91,14 @@ namespace rasters
 			}
 		}
 
+		// expression assignment, see series/expression.hpp
+		template <typename Texpression, std::enable_if_t<std::is_base_of<series::AbstractExpression, Texpression>::value, int> = 0>
+		LayeredRaster<T,Tgrid,Tmap>& operator=(const Texpression& a)
+		{
+			Raster<T,Tgrid,Tmap>::operator=(a);
+			return *this;
+		}
+
 
 
 		/*
@@ -34,4 +34,30 @@ TEST_CASE( "LayeredRaster consistency", "[rasters]" ) {
         CHECK(a.size() == a.grid.cell_count(mapping::cell) );
         CHECK(b.size() == b.grid.cell_count(mapping::arrow) );
     }
-}
\ No newline at end of file
+}
+TEST_CASE( "LayeredRaster layer view consistency", "[rasters]" ) {
+    auto a = make_LayeredRaster<float>(layered_tetrahedron_grid);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = float(i);
+    }
+    auto layer = make_Raster<float>(tetrahedron_grid);
+    SECTION("view_layer() must refer to the same elements as get_layer()"){
+        for (std::size_t j = 0; j < layered_tetrahedron_grid.layering->layer_count; ++j)
+        {
+            get_layer(a, j, layer);
+            auto layer_view = view_layer(a, j);
+            series::floats viewed(layer_view.size());
+            series::copy(viewed, layer_view);
+            CHECK(viewed == series::floats(layer.begin(), layer.end()));
+        }
+    }
+    SECTION("view_layer() must allow layers to be modified in place"){
+        auto layer_view = view_layer(a, 1);
+        series::fill(layer_view, -1.f);
+        get_layer(a, 0, layer);
+        CHECK(series::min(layer) >= 0.f);
+        get_layer(a, 1, layer);
+        CHECK(series::max(layer) == -1.f);
+    }
+}
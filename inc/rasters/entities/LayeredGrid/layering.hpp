@@ -2,6 +2,7 @@
 
 #include <series/types.hpp>
 #include <series/glm/types.hpp>
+#include <series/view.hpp>
 
 #include "LayeredGrid.hpp"
 #include "LayeredRaster.hpp"
@@ -26,6 +27,27 @@ namespace rasters
 		}
 	}
 
+	/*
+	`view_layer()` returns a view of a single layer that can be read or written in place, 
+	as an alternative to `get_layer()` and `set_layer()`, see "series/view.hpp".
+	*/
+	template <typename Tgrid, typename T, rasters::mapping Tmap>
+	series::StridedSeriesView<T> view_layer(
+		LayeredRaster<T, Tgrid, Tmap>& a, 
+		const std::size_t layer_id
+	){
+		assert(layer_id < a.grid.layering->layer_count);
+		return series::strided_view(a, layer_id, a.grid.layering->layer_count);
+	}
+	template <typename Tgrid, typename T, rasters::mapping Tmap>
+	series::StridedSeriesView<const T> view_layer(
+		const LayeredRaster<T, Tgrid, Tmap>& a, 
+		const std::size_t layer_id
+	){
+		assert(layer_id < a.grid.layering->layer_count);
+		return series::strided_view(a, layer_id, a.grid.layering->layer_count);
+	}
+
 	// e.g. F₀ = f
 	template <typename Tgrid1, typename Tgrid2, typename T, rasters::mapping Tmap>
 	void set_layer(
@@ -584,3 +584,22 @@ TEST_CASE( "padding happy path", "[rasters]" ) {
 }
 */
 
+TEST_CASE( "Mask dilation and erosion radius on cells that do not correspond to a vertex", "[rasters]" ) {
+    auto top_only   =  Mask<LayeredGrid<uint,float>>(make_Raster(layered_diamond_grid, {false, false, true,  false, false, false, false, true , false, true  }));
+    auto upper_half =  Mask<LayeredGrid<uint,float>>(make_Raster(layered_diamond_grid, {true,  true , true,  true , false, true , true,  true , false, false }));
+    auto expected   =  make_Mask(layered_diamond_grid);
+    auto step       =  make_Mask(layered_diamond_grid);
+    auto out        =  make_Mask(layered_diamond_grid);
+    SECTION("dilate(grid, a, radius) must generate the same output as radius calls to dilate(grid, a)"){
+        dilate(top_only, step);
+        dilate(step, expected);
+        dilate(top_only, out, 2);
+        CHECK(rasters::equal(out, expected));
+    }
+    SECTION("erode(grid, a, radius) must generate the same output as radius calls to erode(grid, a)"){
+        erode(upper_half, step);
+        erode(step, expected);
+        erode(upper_half, out, 2);
+        CHECK(rasters::equal(out, expected));
+    }
+}
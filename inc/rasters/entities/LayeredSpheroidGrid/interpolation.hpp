@@ -1,6 +1,16 @@
 #pragma once
 
+// std libraries
+#include <cstddef>      // std::size_t
+#include <numeric>      // std::gcd
+#include <type_traits>  // std::enable_if_t
+
+// in-house libraries
+#include <series/execution.hpp>
+
 #include "../LayeredGrid/LayeredRaster.hpp"
+#include "../SpheroidGrid/interpolation.hpp"
+#include "../SpheroidGrid/InterpolationCache.hpp"
 
 namespace rasters
 {
@@ -32,4 +42,108 @@ namespace rasters
         auto scratch = make_Raster<unsigned int>(output.grid);
         nearest_neighbor_interpolation(input, output, scratch);
     }
+
+    /*
+    `get_layered_write_alignment()` returns the multiple of vertices at which separate threads may safely write to
+    a layered raster of `T` with `L` layers, since each vertex writes `L` consecutive elements, see `series::write_alignment`.
+    */
+    template<typename T>
+    std::size_t get_layered_write_alignment(const std::size_t L)
+    {
+        return series::write_alignment<T> / std::gcd(series::write_alignment<T>, L);
+    }
+
+    /*
+    Layers are interpolated independently using the same weights, see "SpheroidGrid/interpolation.hpp".
+    Weights can be calculated from `get_barycentric_weights()` using the grids of either kind of raster.
+    Vertices are distributed according to `policy`, see "series/execution.hpp".
+    */
+    template<typename Tpolicy, typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void barycentric_interpolation(
+        const Tpolicy policy,
+        const BarycentricWeights<Tid,Tfloat>& weights,
+        const LayeredRaster<T, Tgrid1, Tmap>& input, 
+        LayeredRaster<T, Tgrid2, Tmap>& output
+    ) {
+        // TODO: relax this assertion to work for arbitrary combinations of layer schemes
+        assert(*input.grid.layering == *output.grid.layering);
+        const std::size_t V = output.grid.structure->vertex_count;
+        const std::size_t L = output.grid.layering->layer_count;
+        series::for_each_id(policy, V, [&](const std::size_t i) {
+            const glm::vec<3,Tid,glm::defaultp> ids = weights.vertex_ids[i];
+            const glm::vec<3,Tfloat,glm::defaultp> w = weights.weights[i];
+            for (std::size_t j = 0; j < L; ++j)
+            {
+                output[i*L+j] = input[ids.x*L+j] * w.x + input[ids.y*L+j] * w.y + input[ids.z*L+j] * w.z;
+            }
+        }, get_layered_write_alignment<T>(L));
+    }
+
+    template<typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap>
+    void barycentric_interpolation(
+        const BarycentricWeights<Tid,Tfloat>& weights,
+        const LayeredRaster<T, Tgrid1, Tmap>& input, 
+        LayeredRaster<T, Tgrid2, Tmap>& output
+    ) {
+        barycentric_interpolation(series::sequenced, weights, input, output);
+    }
+
+    template<typename T, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap>
+    void barycentric_interpolation(
+        const LayeredRaster<T, Tgrid1, Tmap>& input, 
+        LayeredRaster<T, Tgrid2, Tmap>& output
+    ) {
+        barycentric_interpolation(get_barycentric_weights(input.grid, output.grid), input, output);
+    }
+
+    template<typename Tpolicy, typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void barycentric_interpolation(
+        const Tpolicy policy,
+        InterpolationCache<Tid,Tfloat>& cache,
+        const LayeredRaster<T, Tgrid1, Tmap>& input, 
+        LayeredRaster<T, Tgrid2, Tmap>& output
+    ) {
+        barycentric_interpolation(policy, cache.get_barycentric_weights(policy, input.grid, output.grid), input, output);
+    }
+
+    template<typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap>
+    void barycentric_interpolation(
+        InterpolationCache<Tid,Tfloat>& cache,
+        const LayeredRaster<T, Tgrid1, Tmap>& input, 
+        LayeredRaster<T, Tgrid2, Tmap>& output
+    ) {
+        barycentric_interpolation(series::sequenced, cache, input, output);
+    }
+
+    template<typename Tpolicy, typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void nearest_neighbor_interpolation(
+        const Tpolicy policy,
+        InterpolationCache<Tid,Tfloat>& cache,
+        const LayeredRaster<T, Tgrid1, Tmap>& input, 
+        LayeredRaster<T, Tgrid2, Tmap>& output
+    ) {
+        // TODO: relax this assertion to work for arbitrary combinations of layer schemes
+        assert(*input.grid.layering == *output.grid.layering);
+        const series::uints& nearest_ids = cache.get_nearest_ids(policy, input.grid, output.grid);
+        const std::size_t V = output.grid.structure->vertex_count;
+        const std::size_t L = output.grid.layering->layer_count;
+        series::for_each_id(policy, V, [&](const std::size_t i) {
+            for (std::size_t j = 0; j < L; ++j)
+            {
+                output[i*L+j] = input[nearest_ids[i]*L+j];
+            }
+        }, get_layered_write_alignment<T>(L));
+    }
+
+    template<typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap>
+    void nearest_neighbor_interpolation(
+        InterpolationCache<Tid,Tfloat>& cache,
+        const LayeredRaster<T, Tgrid1, Tmap>& input, 
+        LayeredRaster<T, Tgrid2, Tmap>& output
+    ) {
+        nearest_neighbor_interpolation(series::sequenced, cache, input, output);
+    }
 }
\ No newline at end of file
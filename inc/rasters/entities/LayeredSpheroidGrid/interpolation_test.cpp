@@ -11,6 +11,7 @@
 #include <series/types.hpp>
 #include <series/glm/types.hpp>
 #include <series/glm/random.hpp>  
+#include <series/execution.hpp>  
 
 #include <rasters/entities/LayeredGrid/LayeredRaster.hpp>
 #include <rasters/entities/LayeredSpheroidGrid/LayeredSpheroidGrid.hpp>  
@@ -80,4 +81,59 @@ TEST_CASE( "LayeredSpheroidGrid nearest_neighbor_interpolation invertibility", "
 
         CHECK(raster1 == raster3);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "LayeredSpheroidGrid barycentric_interpolation identity", "[many]" ) {
+    SECTION("barycentric_interpolation onto the same grid must reproduce the original input"){
+        // initialize rasters
+        std::mt19937 generator(2);
+        auto raster1 = get_random_LayeredSpheroidRaster(layered_icosahedron_grid, generator);
+        auto raster2 = get_random_LayeredSpheroidRaster(layered_icosahedron_grid, generator);
+
+        rasters::barycentric_interpolation(raster1, raster2);
+
+        float max_difference = 0;
+        for (unsigned int i = 0; i < raster1.size(); ++i)
+        {
+            max_difference = std::max(max_difference, std::abs(raster1[i] - raster2[i]));
+        }
+        CHECK(max_difference < 1e-4f);
+    }
+}
+
+TEST_CASE( "LayeredSpheroidGrid interpolation with InterpolationCache", "[many]" ) {
+    SECTION("interpolation must produce the same output with or without a cache"){
+        // initialize rasters
+        std::mt19937 generator(2);
+        auto input = get_random_LayeredSpheroidRaster(layered_icosahedron_grid, generator);
+        auto expected = get_random_LayeredSpheroidRaster(layered_icosahedron_grid, generator);
+        auto out = get_random_LayeredSpheroidRaster(layered_icosahedron_grid, generator);
+        rasters::InterpolationCache<uint,float> cache;
+
+        rasters::nearest_neighbor_interpolation(input, expected);
+        rasters::nearest_neighbor_interpolation(cache, input, out);
+        CHECK(out == expected);
+
+        rasters::barycentric_interpolation(input, expected);
+        rasters::barycentric_interpolation(cache, input, out);
+        CHECK(out == expected);
+        CHECK(cache.size() == 1);
+    }
+    SECTION("interpolation with a cache must produce the same output regardless of policy"){
+        std::mt19937 generator(2);
+        auto input = get_random_LayeredSpheroidRaster(layered_icosahedron_grid, generator);
+        auto expected = get_random_LayeredSpheroidRaster(layered_icosahedron_grid, generator);
+        auto out = get_random_LayeredSpheroidRaster(layered_icosahedron_grid, generator);
+        rasters::InterpolationCache<uint,float> cache;
+        const series::ParallelPolicy parallel(4, 1);
+
+        rasters::nearest_neighbor_interpolation(cache, input, expected);
+        rasters::nearest_neighbor_interpolation(parallel, cache, input, out);
+        CHECK(out == expected);
+
+        rasters::barycentric_interpolation(cache, input, expected);
+        rasters::barycentric_interpolation(parallel, cache, input, out);
+        CHECK(out == expected);
+        CHECK(cache.size() == 1);
+    }
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+// std libraries
+#include <array>        // std::array
+#include <algorithm>    // std::remove_if
+#include <memory>       // std::shared_ptr, std::weak_ptr
+#include <vector>       // std::vector
+
+// in-house libraries
+#include <series/types.hpp>
+#include <series/execution.hpp>
+
+#include "../Grid/Raster.hpp"
+#include "interpolation.hpp"
+
+namespace rasters
+{
+    /*
+    An `InterpolationCache` stores the operators that are used to interpolate from one grid to another,
+    so that rasters can be interpolated repeatedly between the same grids without repeating voronoi lookups or face searches.
+    Once an operator is cached, each interpolation is a single gather that can be run in parallel.
+
+    Operators are keyed on the shared components of the grids that determine them,
+    namely the structure, metrics, and voronoi lookup of the input grid, and the metrics of the output grid.
+    Grids only hold pointers to `const` components, so a grid can only "change" by replacing a component,
+    and an operator is only reused if both grids share the exact components that it was built from.
+    Invalidation only notices replaced components, so it is a precondition that components are never modified in place,
+    e.g. through a `const_cast` or through another pointer that was used to construct them.
+    `clear()` must be called if this precondition is ever broken.
+    Components are held by weak pointers, so the cache never keeps a grid alive,
+    and operators are discarded once any of their components is destroyed.
+
+    Operators are built lazily: nearest neighbor ids are only built when `nearest_neighbor_interpolation()` is called,
+    and barycentric weights are only built when `barycentric_interpolation()` is called.
+    An `InterpolationCache` must not be used by multiple threads at once,
+    though the operators it builds are built and applied according to the policies that are passed.
+    */
+    template<typename Tid, typename Tfloat>
+    class InterpolationCache
+    {
+        typedef std::array<std::weak_ptr<const void>, 4> Key;
+
+        struct Entry
+        {
+            Key key;
+            std::shared_ptr<const series::uints> nearest_ids;
+            std::shared_ptr<const BarycentricWeights<Tid,Tfloat>> barycentric_weights;
+        };
+
+        std::vector<Entry> entries;
+
+        template<typename Tgrid1, typename Tgrid2>
+        static std::array<std::shared_ptr<const void>, 4> get_components(const Tgrid1& input, const Tgrid2& output)
+        {
+            return {input.structure, input.metrics, input.voronoi, output.metrics};
+        }
+        static bool is_expired(const Key& key)
+        {
+            for (const auto& component : key)
+            {
+                if (component.expired()) { return true; }
+            }
+            return false;
+        }
+        // returns whether each pointer in `key` shares ownership with the corresponding pointer in `components`
+        static bool is_match(const Key& key, const std::array<std::shared_ptr<const void>, 4>& components)
+        {
+            for (std::size_t i = 0; i < key.size(); ++i)
+            {
+                if (key[i].owner_before(components[i]) || components[i].owner_before(key[i])) { return false; }
+            }
+            return true;
+        }
+
+        template<typename Tgrid1, typename Tgrid2>
+        Entry& get_entry(const Tgrid1& input, const Tgrid2& output)
+        {
+            entries.erase(
+                std::remove_if(entries.begin(), entries.end(), [](const Entry& entry){ return is_expired(entry.key); }),
+                entries.end());
+            const auto components = get_components(input, output);
+            for (Entry& entry : entries)
+            {
+                if (is_match(entry.key, components)) { return entry; }
+            }
+            entries.push_back(Entry{Key{components[0], components[1], components[2], components[3]}, nullptr, nullptr});
+            return entries.back();
+        }
+
+    public:
+        /*
+        Returns the id of the cell in `input` that is nearest to each cell of `output`, building it if needed.
+        The reference remains valid until the cache is next used or cleared.
+        */
+        template<typename Tpolicy, typename Tgrid1, typename Tgrid2,
+            std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+        const series::uints& get_nearest_ids(const Tpolicy policy, const Tgrid1& input, const Tgrid2& output)
+        {
+            Entry& entry = get_entry(input, output);
+            if (!entry.nearest_ids)
+            {
+                auto nearest_ids = std::make_shared<series::uints>(output.metrics->vertex_positions.size());
+                input.voronoi->get_values(policy, output.metrics->vertex_positions, *nearest_ids);
+                entry.nearest_ids = nearest_ids;
+            }
+            return *entry.nearest_ids;
+        }
+        /*
+        Returns the output of `get_barycentric_weights()` for `input` and `output`, building it if needed.
+        The reference remains valid until the cache is next used or cleared.
+        */
+        template<typename Tpolicy, typename Tgrid1, typename Tgrid2,
+            std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+        const BarycentricWeights<Tid,Tfloat>& get_barycentric_weights(const Tpolicy policy, const Tgrid1& input, const Tgrid2& output)
+        {
+            Entry& entry = get_entry(input, output);
+            if (!entry.barycentric_weights)
+            {
+                entry.barycentric_weights = std::make_shared<BarycentricWeights<Tid,Tfloat>>(
+                    rasters::get_barycentric_weights(policy, input, output));
+            }
+            return *entry.barycentric_weights;
+        }
+
+        // the number of grid pairs for which operators are stored, including pairs whose grids may have since been destroyed
+        std::size_t size() const
+        {
+            return entries.size();
+        }
+        void clear()
+        {
+            entries.clear();
+        }
+    };
+
+    template<typename Tpolicy, typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void nearest_neighbor_interpolation(
+        const Tpolicy policy,
+        InterpolationCache<Tid,Tfloat>& cache,
+        const Raster<T, Tgrid1, mapping::cell>& input,
+        Raster<T, Tgrid2, mapping::cell>& output
+    ) {
+        const series::uints& nearest_ids = cache.get_nearest_ids(policy, input.grid, output.grid);
+        series::for_each_id(policy, output.size(), [&](const std::size_t i) {
+            output[i] = input[nearest_ids[i]];
+        }, series::write_alignment<T>);
+    }
+
+    template<typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2>
+    void nearest_neighbor_interpolation(
+        InterpolationCache<Tid,Tfloat>& cache,
+        const Raster<T, Tgrid1, mapping::cell>& input,
+        Raster<T, Tgrid2, mapping::cell>& output
+    ) {
+        nearest_neighbor_interpolation(series::sequenced, cache, input, output);
+    }
+
+    template<typename Tpolicy, typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void barycentric_interpolation(
+        const Tpolicy policy,
+        InterpolationCache<Tid,Tfloat>& cache,
+        const Raster<T, Tgrid1, mapping::cell>& input,
+        Raster<T, Tgrid2, mapping::cell>& output
+    ) {
+        barycentric_interpolation(policy, cache.get_barycentric_weights(policy, input.grid, output.grid), input, output);
+    }
+
+    template<typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2>
+    void barycentric_interpolation(
+        InterpolationCache<Tid,Tfloat>& cache,
+        const Raster<T, Tgrid1, mapping::cell>& input,
+        Raster<T, Tgrid2, mapping::cell>& output
+    ) {
+        barycentric_interpolation(series::sequenced, cache, input, output);
+    }
+}
@@ -0,0 +1,76 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#define GLM_FORCE_PURE     // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>             // *vec3
+#include <glm/mat3x3.hpp>             // *mat3
+#include <glm/mat4x4.hpp>             // *mat4
+#include <glm/gtc/matrix_transform.hpp> // rotate
+
+#include <series/types.hpp>
+#include <series/glm/types.hpp>
+#include <series/glm/random.hpp>  
+
+#include <rasters/entities/Grid/Raster.hpp>
+#include <rasters/entities/SpheroidGrid/SpheroidGrid.hpp>  
+#include <rasters/entities/SpheroidGrid/interpolation.hpp>
+#include <rasters/entities/SpheroidGrid/InterpolationCache.hpp>
+
+#include "SpheroidGrid_test_utils.hpp"
+
+TEST_CASE( "InterpolationCache consistency", "[many]" ) {
+    // initialize mesh
+    auto mesh1 = meshes::subdivide(meshes::icosahedron);
+    auto mesh2 = meshes::subdivide(meshes::subdivide(meshes::icosahedron));
+    mult(glm::mat3(glm::rotate(glm::mat4(1.0f), glm::radians(135.0f), glm::normalize(glm::vec3(1.0f, 1.0f, 1.0f)))), mesh2.vertices, mesh2.vertices);
+
+    // initialize grids
+    auto grid1 = rasters::SpheroidGrid<uint,float>(mesh1.vertices, mesh1.faces);
+    auto grid2 = rasters::SpheroidGrid<uint,float>(mesh2.vertices, mesh2.faces);
+
+    // initialize rasters
+    std::mt19937 generator(2);
+    auto input = rasters::make_Raster<float>(grid1);
+    auto expected = rasters::make_Raster<float>(grid2);
+    auto out = rasters::make_Raster<float>(grid2);
+    series::get_elias_noise(grid1.metrics->vertex_positions, generator, input);
+
+    rasters::InterpolationCache<uint,float> cache;
+    SECTION("nearest_neighbor_interpolation must produce the same output with or without a cache"){
+        rasters::nearest_neighbor_interpolation(input, expected);
+        rasters::nearest_neighbor_interpolation(cache, input, out);
+        CHECK(out == expected);
+        rasters::nearest_neighbor_interpolation(series::ParallelPolicy(4, 16), cache, input, out);
+        CHECK(out == expected);
+    }
+    SECTION("barycentric_interpolation must produce the same output with or without a cache"){
+        rasters::barycentric_interpolation(input, expected);
+        rasters::barycentric_interpolation(cache, input, out);
+        CHECK(out == expected);
+        rasters::barycentric_interpolation(series::ParallelPolicy(4, 16), cache, input, out);
+        CHECK(out == expected);
+    }
+    SECTION("InterpolationCache must reuse operators for grids that share components"){
+        rasters::nearest_neighbor_interpolation(cache, input, out);
+        rasters::barycentric_interpolation(cache, input, out);
+        auto copied_grid2 = rasters::SpheroidGrid<uint,float>(grid2);
+        auto copied_out = rasters::make_Raster<float>(copied_grid2);
+        rasters::nearest_neighbor_interpolation(cache, input, copied_out);
+        CHECK(cache.size() == 1);
+        rasters::nearest_neighbor_interpolation(cache, out, input);
+        CHECK(cache.size() == 2);
+    }
+    SECTION("InterpolationCache must discard operators once their grids are destroyed"){
+        {
+            auto grid3 = rasters::SpheroidGrid<uint,float>(mesh2.vertices, mesh2.faces);
+            auto out3 = rasters::make_Raster<float>(grid3);
+            rasters::nearest_neighbor_interpolation(cache, input, out3);
+            CHECK(cache.size() == 1);
+        }
+        rasters::nearest_neighbor_interpolation(cache, input, out);
+        CHECK(cache.size() == 1);
+        rasters::nearest_neighbor_interpolation(input, expected);
+        CHECK(out == expected);
+    }
+}
@@ -29,19 +29,61 @@ namespace rasters
     template<typename Tid=std::uint16_t, typename Tfloat=float>
 	struct SpheroidGrid: public Grid<Tid, Tfloat>
 	{
-		std::shared_ptr<SpheroidVoronoi> voronoi;
+		std::shared_ptr<const SpheroidVoronoi> voronoi;
 
 		SpheroidGrid(
 			const series::Series<glm::vec<3,Tfloat,glm::defaultp>>& vertices, 
-			const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces
+			const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces,
+			const unsigned int metric_attributes = rasters::metric_attributes::all
 		):
-			Grid<Tid, Tfloat>(vertices, faces),
-			voronoi(std::make_shared< SpheroidVoronoi>(
-				vertices, 
-				series::min(this->metrics->arrow_lengths / 8.f), 
-				series::max(this->metrics->arrow_lengths * 1.f)
-			))
+			SpheroidGrid(series::sequenced, vertices, faces, metric_attributes)
 		{}
+		/*
+		Components that support execution policies are built according to `policy`, see "series/execution.hpp".
+		The voronoi lookup is built by walking the graph of the mesh if its faces form a delaunay triangulation of its normalized vertices,
+		as is the case for the convex hull of any points on a sphere, see `is_delaunay_on_sphere()`.
+		Otherwise, the walk would not be exact, so the lookup is built by checking every cell near each vertex instead, which is much slower.
+		*/
+		template<typename Tpolicy, std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+		SpheroidGrid(
+			const Tpolicy policy,
+			const series::Series<glm::vec<3,Tfloat,glm::defaultp>>& vertices, 
+			const series::Series<glm::vec<3,Tid, glm::defaultp>>& faces,
+			const unsigned int metric_attributes = rasters::metric_attributes::all
+		):
+			Grid<Tid, Tfloat>(policy, vertices, faces, metric_attributes),
+			voronoi(make_voronoi(policy, vertices, *this->structure, *this->metrics))
+		{}
+		/*
+		Reads a grid that was previously stored using `write()`, see "binary.hpp".
+		*/
+		explicit SpheroidGrid(series::BinaryReader& reader):
+			Grid<Tid, Tfloat>(reader),
+			voronoi(std::make_shared<SpheroidVoronoi>(reader))
+		{
+			voronoi->validate(this->structure->vertex_count);
+		}
+		template<typename Tpolicy>
+		static std::shared_ptr<SpheroidVoronoi> make_voronoi(
+			const Tpolicy policy,
+			const series::Series<glm::vec<3,Tfloat,glm::defaultp>>& vertices, 
+			const Structure<Tid>& structure,
+			const Metrics<Tid,Tfloat>& metrics
+		){
+			const float cell_width = series::min(metrics.arrow_lengths / 8.f);
+			const float max_vertex_distance = series::max(metrics.arrow_lengths * 1.f);
+			if (is_delaunay_on_sphere(vertices, structure.face_vertex_ids, structure.edge_vertex_ids, structure.edge_face_ids))
+			{
+				return std::make_shared<SpheroidVoronoi>(policy, vertices, 
+					structure.vertex_neighbor_offsets, structure.vertex_neighbor_ids, cell_width, max_vertex_distance);
+			}
+			return std::make_shared<SpheroidVoronoi>(vertices, cell_width, max_vertex_distance);
+		}
+		void write(series::BinaryWriter& writer) const
+		{
+			Grid<Tid, Tfloat>::write(writer);
+			voronoi->write(writer);
+		}
 		bool operator== (const SpheroidGrid& other) const
 		{
 		    return (this->structure == other.structure && 
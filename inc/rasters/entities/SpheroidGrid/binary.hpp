@@ -0,0 +1,12 @@
+#pragma once
+
+// in-house libraries
+#include <rasters/entities/Grid/binary.hpp>
+
+#include "SpheroidGrid.hpp"
+
+namespace rasters
+{
+	template<typename Tid, typename Tfloat>
+	struct grid_file_kind<SpheroidGrid<Tid,Tfloat>> { static constexpr std::uint32_t value = 2; };
+}
@@ -0,0 +1,87 @@
+
+// 3rd party libraries
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#define GLM_FORCE_PURE      // disable SIMD support for glm so we can work with webassembly
+
+// std libraries
+#include <cstdint>          // std::uint32_t, std::uint64_t
+#include <cstdio>           // std::remove
+#include <cstring>          // std::memcpy
+#include <sstream>          // std::stringstream
+
+// in-house libraries
+#include <meshes/mesh.hpp>  
+#include <series/glm/relational.hpp>  // equal
+
+#include "SpheroidGrid.hpp"
+#include "binary.hpp"
+
+#include "SpheroidGrid_test_utils.hpp"
+
+TEST_CASE( "SpheroidGrid binary round trip", "[rasters]" ) {
+    const std::string path = "SpheroidGrid_binary_test.grid";
+    rasters::save(path, icosahedron_grid);
+    const rasters::SpheroidGrid<uint,float> loaded = rasters::load<rasters::SpheroidGrid<uint,float>>(path);
+
+    SECTION("Loaded grids must have the same structure as the grids that were saved"){
+        CHECK(loaded.structure->vertex_count == icosahedron_grid.structure->vertex_count);
+        CHECK(loaded.structure->arrow_count == icosahedron_grid.structure->arrow_count);
+        CHECK(loaded.structure->arrow_vertex_id_from == icosahedron_grid.structure->arrow_vertex_id_from);
+        CHECK(loaded.structure->vertex_neighbor_ids == icosahedron_grid.structure->vertex_neighbor_ids);
+    }
+    SECTION("Loaded grids must have the same metrics as the grids that were saved"){
+        CHECK(series::equal(loaded.metrics->vertex_positions, icosahedron_grid.metrics->vertex_positions));
+        CHECK(series::equal(loaded.metrics->arrow_dual_normals, icosahedron_grid.metrics->arrow_dual_normals));
+        CHECK(loaded.metrics->vertex_dual_areas == icosahedron_grid.metrics->vertex_dual_areas);
+        CHECK(loaded.metrics->total_area == icosahedron_grid.metrics->total_area);
+        CHECK(loaded.metrics->attributes == icosahedron_grid.metrics->attributes);
+    }
+    SECTION("Loaded grids must have the same voronoi lookup as the grids that were saved"){
+        series::uints loaded_ids(icosahedron_grid.structure->vertex_count);
+        series::uints saved_ids(icosahedron_grid.structure->vertex_count);
+        loaded.voronoi->get_values(icosahedron_grid.metrics->vertex_positions, loaded_ids);
+        icosahedron_grid.voronoi->get_values(icosahedron_grid.metrics->vertex_positions, saved_ids);
+        CHECK(loaded_ids == saved_ids);
+    }
+    SECTION("Loading a file as the wrong kind of grid must throw"){
+        CHECK_THROWS(rasters::load<rasters::Grid<uint,float>>(path));
+        CHECK_THROWS(rasters::load<rasters::SpheroidGrid<uint,double>>(path));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE( "SpheroidGrid binary validation", "[rasters]" ) {
+    typedef rasters::SpheroidGrid<uint,float> Tgrid;
+    std::stringstream stream;
+    series::BinaryWriter writer(stream);
+    icosahedron_grid.write(writer);
+    const std::string bytes = stream.str();
+    // the structure starts with its vertex count, and its first series starts with a count and id that are each padded to 16 bytes
+    const std::size_t vertex_count_offset = 0;
+    const std::size_t first_id_offset = 48;
+
+    SECTION("Grids that are stored intact must be read without error"){
+        series::BinaryReader reader(bytes.data(), bytes.size());
+        CHECK_NOTHROW(Tgrid{reader});
+    }
+    SECTION("Reading a grid that is truncated must throw"){
+        series::BinaryReader reader(bytes.data(), bytes.size() / 2);
+        CHECK_THROWS_AS(Tgrid{reader}, std::runtime_error);
+    }
+    SECTION("Reading a structure whose counts do not match its series must throw"){
+        std::string corrupted = bytes;
+        const std::uint64_t vertex_count = icosahedron_grid.structure->vertex_count + 1;
+        std::memcpy(&corrupted[vertex_count_offset], &vertex_count, sizeof(vertex_count));
+        series::BinaryReader reader(corrupted.data(), corrupted.size());
+        CHECK_THROWS_AS(rasters::Structure<uint>{reader}, std::runtime_error);
+    }
+    SECTION("Reading a structure with ids that refer to vertices that do not exist must throw"){
+        std::string corrupted = bytes;
+        const std::uint32_t vertex_id = icosahedron_grid.structure->vertex_count;
+        std::memcpy(&corrupted[first_id_offset], &vertex_id, sizeof(vertex_id));
+        series::BinaryReader reader(corrupted.data(), corrupted.size());
+        CHECK_THROWS_AS(rasters::Structure<uint>{reader}, std::runtime_error);
+    }
+}
@@ -1,19 +1,42 @@
 #pragma once
 
+// std libraries
+#include <algorithm>    // std::min
+
+// 3rd party libraries
+#include <glm/vec3.hpp>               // *vec3
+#include <glm/geometric.hpp>          // dot, cross
+
+// in-house libraries
+#include <series/types.hpp>
+#include <series/glm/types.hpp>
+#include <series/execution.hpp>
+
 #include "../Grid/Raster.hpp"
 
 namespace rasters
 {
-    template<typename T, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap>
+    template<typename Tpolicy, typename T, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
     void nearest_neighbor_interpolation(
+        const Tpolicy policy,
         const Raster<T, Tgrid1, Tmap>& input, 
         Raster<T, Tgrid2, Tmap>& output,
         Raster<unsigned int, Tgrid2, Tmap>& scratch
     ) {
-        input.grid.voronoi->get_values(output.grid.metrics->vertex_positions, scratch);
+        input.grid.voronoi->get_values(policy, output.grid.metrics->vertex_positions, scratch);
         series::get(input, scratch, output);
     }
 
+    template<typename T, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap>
+    void nearest_neighbor_interpolation(
+        const Raster<T, Tgrid1, Tmap>& input, 
+        Raster<T, Tgrid2, Tmap>& output,
+        Raster<unsigned int, Tgrid2, Tmap>& scratch
+    ) {
+        nearest_neighbor_interpolation(series::sequenced, input, output, scratch);
+    }
+
     template<typename T, typename Tgrid1, typename Tgrid2, rasters::mapping Tmap>
     void nearest_neighbor_interpolation(
         const Raster<T, Tgrid1, Tmap>& input, 
@@ -22,4 +45,150 @@ namespace rasters
         auto scratch = make_Raster<unsigned int>(output.grid);
         nearest_neighbor_interpolation(input, output, scratch);
     }
-}
\ No newline at end of file
+
+
+
+    /*
+    `BarycentricWeights` describes an interpolation from the cells of one grid to the cells of another.
+    For each cell of the output grid, it stores the vertices of the face on the input grid that contains the cell,
+    and the barycentric coordinates of the cell within that face.
+    Weights only depend on the two grids, so they can be calculated once using `get_barycentric_weights()`
+    and reused to interpolate any number of rasters, where each interpolation is a single gather.
+    */
+    template<typename Tid, typename Tfloat>
+    struct BarycentricWeights
+    {
+        series::Series<glm::vec<3,Tid,glm::defaultp>>    vertex_ids;
+        series::Series<glm::vec<3,Tfloat,glm::defaultp>> weights;
+
+        explicit BarycentricWeights(const std::size_t cell_count):
+            vertex_ids(cell_count),
+            weights(cell_count)
+        {}
+    };
+
+    /*
+    `get_barycentric_weights()` locates the face of `input` that contains each cell of `output`.
+    The voronoi lookup of `input` finds the nearest vertex to a cell,
+    and faces around that vertex and around its neighbors are tried in turn.
+    Barycentric coordinates are found by projecting the cell onto the plane of each face through the center of the sphere,
+    and the face is chosen whose smallest coordinate is largest, so cells that lie on an edge are never missed due to rounding.
+    If no nearby face contains the cell, all weight is given to the nearest vertex, as in `nearest_neighbor_interpolation()`.
+    Cells are distributed according to `policy`, see "series/execution.hpp".
+    */
+    template<typename Tpolicy, typename Tgrid1, typename Tgrid2,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    BarycentricWeights<typename Tgrid1::size_type, typename Tgrid1::value_type> get_barycentric_weights(
+        const Tpolicy policy,
+        const Tgrid1& input,
+        const Tgrid2& output
+    ) {
+        typedef typename Tgrid1::size_type Tid;
+        typedef typename Tgrid1::value_type Tfloat;
+        typedef glm::vec<3,Tfloat,glm::defaultp> vec3;
+
+        const auto& structure = *input.structure;
+        const auto& vertex_positions = input.metrics->vertex_positions;
+        const auto& cell_positions = output.metrics->vertex_positions;
+        BarycentricWeights<Tid,Tfloat> result(cell_positions.size());
+        series::uints nearest_ids(cell_positions.size());
+        input.voronoi->get_values(policy, cell_positions, nearest_ids);
+
+        series::for_each_id(policy, cell_positions.size(), [&](const std::size_t i) {
+            const vec3 point = cell_positions[i];
+            glm::vec<3,Tid,glm::defaultp> best_ids(nearest_ids[i]);
+            vec3 best_weights(1,0,0);
+            Tfloat best_min_weight = -1;
+            const auto try_faces_around = [&](const Tid vertex_id) {
+                for (Tid j = structure.vertex_neighbor_offsets[vertex_id]; j < structure.vertex_neighbor_offsets[vertex_id+1]; ++j)
+                {
+                    const Tid arrow_id = structure.vertex_neighbor_arrow_ids[j];
+                    for (const Tid face_id : {structure.arrow_face_id_a[arrow_id], structure.arrow_face_id_b[arrow_id]})
+                    {
+                        const glm::vec<3,Tid,glm::defaultp> face = structure.face_vertex_ids[face_id];
+                        const vec3 a = vertex_positions[face.x];
+                        const vec3 b = vertex_positions[face.y];
+                        const vec3 c = vertex_positions[face.z];
+                        const vec3 weights = vec3(
+                            glm::dot(point, glm::cross(b, c)),
+                            glm::dot(a, glm::cross(point, c)),
+                            glm::dot(a, glm::cross(b, point))
+                        ) / glm::dot(a, glm::cross(b, c));
+                        // the projection is only valid if the cell lies on the same side of the sphere as the face
+                        const Tfloat weight_sum = weights.x + weights.y + weights.z;
+                        if (weight_sum <= 0) { continue; }
+                        const vec3 normalized = weights / weight_sum;
+                        const Tfloat min_weight = std::min(normalized.x, std::min(normalized.y, normalized.z));
+                        if (min_weight > best_min_weight)
+                        {
+                            best_ids = face;
+                            best_weights = normalized;
+                            best_min_weight = min_weight;
+                        }
+                    }
+                }
+            };
+            const Tid nearest_id = nearest_ids[i];
+            try_faces_around(nearest_id);
+            for (Tid j = structure.vertex_neighbor_offsets[nearest_id];
+                 best_min_weight < 0 && j < structure.vertex_neighbor_offsets[nearest_id+1]; ++j)
+            {
+                try_faces_around(structure.vertex_neighbor_ids[j]);
+            }
+            if (best_min_weight < 0)
+            {
+                best_ids = glm::vec<3,Tid,glm::defaultp>(nearest_id);
+                best_weights = vec3(1,0,0);
+            }
+            result.vertex_ids[i] = best_ids;
+            result.weights[i] = best_weights;
+        });
+        return result;
+    }
+
+    template<typename Tgrid1, typename Tgrid2>
+    BarycentricWeights<typename Tgrid1::size_type, typename Tgrid1::value_type> get_barycentric_weights(
+        const Tgrid1& input,
+        const Tgrid2& output
+    ) {
+        return get_barycentric_weights(series::sequenced, input, output);
+    }
+
+    /*
+    `barycentric_interpolation()` resamples `input` onto the grid of `output` using weights from `get_barycentric_weights()`.
+    Unlike `nearest_neighbor_interpolation()`, output varies continuously across the faces of the input grid,
+    so a coarser grid can be used for the same visual quality.
+    */
+    template<typename Tpolicy, typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2,
+        std::enable_if_t<series::is_execution_policy<Tpolicy>, int> = 0>
+    void barycentric_interpolation(
+        const Tpolicy policy,
+        const BarycentricWeights<Tid,Tfloat>& weights,
+        const Raster<T, Tgrid1, mapping::cell>& input,
+        Raster<T, Tgrid2, mapping::cell>& output
+    ) {
+        assert(weights.vertex_ids.size() == output.size());
+        series::for_each_id(policy, output.size(), [&](const std::size_t i) {
+            const glm::vec<3,Tid,glm::defaultp> ids = weights.vertex_ids[i];
+            const glm::vec<3,Tfloat,glm::defaultp> w = weights.weights[i];
+            output[i] = input[ids.x] * w.x + input[ids.y] * w.y + input[ids.z] * w.z;
+        });
+    }
+
+    template<typename T, typename Tid, typename Tfloat, typename Tgrid1, typename Tgrid2>
+    void barycentric_interpolation(
+        const BarycentricWeights<Tid,Tfloat>& weights,
+        const Raster<T, Tgrid1, mapping::cell>& input,
+        Raster<T, Tgrid2, mapping::cell>& output
+    ) {
+        barycentric_interpolation(series::sequenced, weights, input, output);
+    }
+
+    template<typename T, typename Tgrid1, typename Tgrid2>
+    void barycentric_interpolation(
+        const Raster<T, Tgrid1, mapping::cell>& input,
+        Raster<T, Tgrid2, mapping::cell>& output
+    ) {
+        barycentric_interpolation(get_barycentric_weights(input.grid, output.grid), input, output);
+    }
+}
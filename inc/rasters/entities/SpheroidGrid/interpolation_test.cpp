@@ -84,4 +84,67 @@ TEST_CASE( "SpheroidGrid nearest_neighbor_interpolation invertibility", "[many]"
 
         CHECK(raster1 == raster3);
     }
-}
\ No newline at end of file
+}
+
+float get_mean_absolute_difference(const series::floats& a, const series::floats& b)
+{
+    float sum = 0;
+    for (unsigned int i = 0; i < a.size(); ++i)
+    {
+        sum += std::abs(a[i] - b[i]);
+    }
+    return sum / a.size();
+}
+
+TEST_CASE( "SpheroidGrid barycentric_interpolation identity", "[many]" ) {
+    SECTION("barycentric_interpolation onto the same grid must reproduce the original input"){
+        auto grid = rasters::SpheroidGrid<uint,float>(meshes::subdivide(meshes::icosahedron).vertices, meshes::subdivide(meshes::icosahedron).faces);
+        auto raster1 = rasters::make_Raster<float>(grid);
+        auto raster2 = rasters::make_Raster<float>(grid);
+        std::mt19937 generator(2);
+        series::get_elias_noise(grid.metrics->vertex_positions, generator, raster1);
+        rasters::barycentric_interpolation(raster1, raster2);
+        CHECK(get_mean_absolute_difference(raster1, raster2) < 1e-4f);
+    }
+}
+
+TEST_CASE( "SpheroidGrid barycentric_interpolation accuracy", "[many]" ) {
+    // initialize mesh
+    auto mesh1 = meshes::subdivide(meshes::subdivide(meshes::icosahedron));
+    auto mesh2 = meshes::subdivide(meshes::subdivide(meshes::subdivide(meshes::icosahedron)));
+    mult(glm::mat3(glm::rotate(glm::mat4(1.0f), glm::radians(135.0f), glm::normalize(glm::vec3(1.0f, 1.0f, 1.0f)))), mesh2.vertices, mesh2.vertices);
+
+    // initialize grids
+    auto grid1 = rasters::SpheroidGrid<uint,float>(mesh1.vertices, mesh1.faces);
+    auto grid2 = rasters::SpheroidGrid<uint,float>(mesh2.vertices, mesh2.faces);
+
+    // initialize rasters with a smooth field, and the values that the field should have on the output grid
+    auto input = rasters::make_Raster<float>(grid1);
+    auto expected = rasters::make_Raster<float>(grid2);
+    auto barycentric = rasters::make_Raster<float>(grid2);
+    auto nearest = rasters::make_Raster<float>(grid2);
+    for (unsigned int i = 0; i < input.size(); ++i)
+    {
+        input[i] = glm::normalize(grid1.metrics->vertex_positions[i]).x;
+    }
+    for (unsigned int i = 0; i < expected.size(); ++i)
+    {
+        expected[i] = glm::normalize(grid2.metrics->vertex_positions[i]).x;
+    }
+    rasters::barycentric_interpolation(input, barycentric);
+    rasters::nearest_neighbor_interpolation(input, nearest);
+
+    SECTION("barycentric_interpolation must never produce output outside the range of its input"){
+        CHECK(series::min(barycentric) >= series::min(input) - 1e-4f);
+        CHECK(series::max(barycentric) <= series::max(input) + 1e-4f);
+    }
+    SECTION("barycentric_interpolation must approximate a smooth field better than nearest_neighbor_interpolation"){
+        CHECK(get_mean_absolute_difference(barycentric, expected) < get_mean_absolute_difference(nearest, expected) / 2.f);
+    }
+    SECTION("barycentric_interpolation must produce the same output when using precomputed weights, regardless of execution policy"){
+        auto weights = rasters::get_barycentric_weights(series::ParallelPolicy(4, 16), grid1, grid2);
+        auto precomputed = rasters::make_Raster<float>(grid2);
+        rasters::barycentric_interpolation(series::ParallelPolicy(4, 16), weights, input, precomputed);
+        CHECK(precomputed == barycentric);
+    }
+}
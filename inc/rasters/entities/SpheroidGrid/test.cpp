@@ -1,3 +1,5 @@
 #include "./interpolation_test.cpp"
+#include "./InterpolationCache_test.hpp"
 #include "./string_cast_test.hpp"
 #include "./SpheroidGrid_test.hpp"
+#include "./binary_test.hpp"
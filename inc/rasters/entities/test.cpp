@@ -6,9 +6,18 @@
 #include "./LayeredSpheroidGrid/LayeredSpheroidGrid_test.hpp"
 #include "./LayeredSpheroidGrid/string_cast_test.hpp"
 #include "./SpheroidGrid/interpolation_test.cpp"
+#include "./SpheroidGrid/InterpolationCache_test.hpp"
 #include "./SpheroidGrid/string_cast_test.hpp"
 #include "./SpheroidGrid/SpheroidGrid_test.hpp"
+#include "./SpheroidGrid/binary_test.hpp"
 #include "./Grid/vector_calculus_test.hpp"
 #include "./Grid/Raster_test.hpp"
 #include "./Grid/morphologic_test.hpp"
 #include "./Grid/Grid_test.hpp"
+#include "./Grid/sparse_test.hpp"
+#include "./Grid/diffusion_test.hpp"
+#include "./Grid/multigrid_test.hpp"
+#include "./Grid/Mask_test.hpp"
+#include "./Grid/distance_test.hpp"
+#include "./Grid/grayscale_test.hpp"
+#include "./Grid/labeling_test.hpp"
@@ -6,12 +6,22 @@
 #include "./entities/LayeredSpheroidGrid/LayeredSpheroidGrid_test.hpp"
 #include "./entities/LayeredSpheroidGrid/string_cast_test.hpp"
 #include "./entities/SpheroidGrid/interpolation_test.cpp"
+#include "./entities/SpheroidGrid/InterpolationCache_test.hpp"
 #include "./entities/SpheroidGrid/string_cast_test.hpp"
 #include "./entities/SpheroidGrid/SpheroidGrid_test.hpp"
+#include "./entities/SpheroidGrid/binary_test.hpp"
 #include "./entities/Grid/vector_calculus_test.hpp"
 #include "./entities/Grid/Raster_test.hpp"
 #include "./entities/Grid/morphologic_test.hpp"
 #include "./entities/Grid/Grid_test.hpp"
+#include "./entities/Grid/sparse_test.hpp"
+#include "./entities/Grid/diffusion_test.hpp"
+#include "./entities/Grid/multigrid_test.hpp"
+#include "./entities/Grid/Mask_test.hpp"
+#include "./entities/Grid/distance_test.hpp"
+#include "./entities/Grid/grayscale_test.hpp"
+#include "./entities/Grid/labeling_test.hpp"
 #include "./components/SpheroidVoronoi/SpheroidVoronoi_test.hpp"
+#include "./components/SpheroidVoronoi/CompactSpheroidVoronoi_test.hpp"
 #include "./components/Structure/Structure_test.cpp"
 #include "./components/Metrics/Metrics_test.cpp"
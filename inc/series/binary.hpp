@@ -0,0 +1,229 @@
+#pragma once
+
+// C libraries
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+
+// std libraries
+#include <algorithm>    // std::min
+#include <cstdint>      // std::uint16_t, std::uint64_t
+#include <cstring>      // std::memcpy
+#include <ostream>      // std::ostream
+#include <stdexcept>    // std::runtime_error
+#include <string>       // std::string
+#include <type_traits>  // std::is_trivially_copyable
+#include <vector>       // std::vector
+
+#include "types.hpp"
+
+/*
+"binary.hpp" reads and writes series in a flat binary format,
+so that expensive precomputed data like grids can be stored on disk and loaded quickly.
+
+Each series is stored as a 64 bit element count, followed by the raw bytes of its elements.
+Both are padded to `binary_alignment` bytes, so elements will be aligned
+if the file is memory mapped, and files can be inspected with a hex editor.
+Values are stored in little endian byte order, and only little endian hosts are supported.
+It is up to the caller to store any version or type information that is needed to interpret a file,
+see "rasters/entities/Grid/binary.hpp" for an example.
+
+Files are written to any `std::ostream` using `BinaryWriter`.
+They are read from any contiguous block of memory using `BinaryReader`,
+and `MappedFile` provides such a block for a file on disk by mapping it into memory, read only.
+`BinaryReader` copies every series it reads into memory that the series owns,
+so reading costs one pass over the file and as much memory as its contents, and nothing refers to the mapping afterward.
+The mapping only saves the intermediate buffer that a stream would need.
+*/
+
+namespace series
+{
+	constexpr std::size_t binary_alignment = 16;
+
+	inline bool is_little_endian()
+	{
+		const std::uint16_t word = 1;
+		unsigned char first_byte;
+		std::memcpy(&first_byte, &word, 1);
+		return first_byte == 1;
+	}
+
+	class BinaryWriter
+	{
+		std::ostream& os;
+		std::size_t offset;
+
+		void write_bytes(const void* data, const std::size_t size)
+		{
+			os.write(reinterpret_cast<const char*>(data), size);
+			offset += size;
+			if (!os)
+			{
+				throw std::runtime_error("could not write binary output");
+			}
+		}
+		void write_padding()
+		{
+			const char zeros[binary_alignment] = {};
+			write_bytes(zeros, (binary_alignment - offset % binary_alignment) % binary_alignment);
+		}
+
+	public:
+		explicit BinaryWriter(std::ostream& os) : os(os), offset(0)
+		{
+			if (!is_little_endian())
+			{
+				throw std::runtime_error("binary output is only supported on little endian hosts");
+			}
+		}
+
+		template <typename T, std::enable_if_t<!std::is_base_of<AbstractSeries, T>::value, int> = 0>
+		void write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written");
+			write_bytes(&value, sizeof(T));
+		}
+		template <typename T>
+		void write(const std::vector<T>& a)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written");
+			write_padding();
+			write(std::uint64_t(a.size()));
+			write_padding();
+			write_bytes(a.data(), a.size() * sizeof(T));
+			write_padding();
+		}
+		template <typename T>
+		void write(const Series<T>& a)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written");
+			write_padding();
+			write(std::uint64_t(a.size()));
+			write_padding();
+			write_bytes(a.size() > 0? &a[0] : nullptr, a.size() * sizeof(T));
+			write_padding();
+		}
+	};
+
+	class BinaryReader
+	{
+		const char* first;
+		const char* cursor;
+		const char* last;
+
+		void read_bytes(void* data, const std::size_t size)
+		{
+			if (std::size_t(last - cursor) < size)
+			{
+				throw std::runtime_error("unexpected end of binary input");
+			}
+			std::memcpy(data, cursor, size);
+			cursor += size;
+		}
+		void read_padding()
+		{
+			const std::size_t padding = (binary_alignment - (cursor - first) % binary_alignment) % binary_alignment;
+			cursor += std::min(padding, std::size_t(last - cursor));
+		}
+		template <typename T>
+		std::size_t read_element_count()
+		{
+			read_padding();
+			const std::uint64_t count = read<std::uint64_t>();
+			read_padding();
+			if (count > std::size_t(last - cursor) / sizeof(T))
+			{
+				throw std::runtime_error("unexpected end of binary input");
+			}
+			return count;
+		}
+
+	public:
+		BinaryReader(const char* data, const std::size_t size) : first(data), cursor(data), last(data + size)
+		{
+			if (!is_little_endian())
+			{
+				throw std::runtime_error("binary input is only supported on little endian hosts");
+			}
+		}
+
+		// returns the number of bytes that have not yet been read
+		inline std::size_t remaining() const
+		{
+			return std::size_t(last - cursor);
+		}
+
+		template <typename T>
+		T read()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be read");
+			T value;
+			read_bytes(&value, sizeof(T));
+			return value;
+		}
+		template <typename T>
+		void read(std::vector<T>& out)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be read");
+			out.resize(read_element_count<T>());
+			read_bytes(out.data(), out.size() * sizeof(T));
+			read_padding();
+		}
+		template <typename T>
+		void read(Series<T>& out)
+		{
+			read(out.vector());
+		}
+	};
+
+	/*
+	`MappedFile` maps a file into memory, read only, for as long as it exists.
+	*/
+	class MappedFile
+	{
+		const char* data_;
+		std::size_t size_;
+
+	public:
+		explicit MappedFile(const std::string& path) : data_(nullptr), size_(0)
+		{
+			const int descriptor = open(path.c_str(), O_RDONLY);
+			if (descriptor < 0)
+			{
+				throw std::runtime_error("could not open " + path);
+			}
+			struct stat status;
+			if (fstat(descriptor, &status) < 0)
+			{
+				close(descriptor);
+				throw std::runtime_error("could not read the size of " + path);
+			}
+			size_ = status.st_size;
+			if (size_ > 0)
+			{
+				void* mapping = mmap(nullptr, size_, PROT_READ, MAP_SHARED, descriptor, 0);
+				if (mapping == MAP_FAILED)
+				{
+					close(descriptor);
+					throw std::runtime_error("could not map " + path);
+				}
+				data_ = static_cast<const char*>(mapping);
+			}
+			close(descriptor);
+		}
+		MappedFile(const MappedFile& other) = delete;
+		MappedFile& operator=(const MappedFile& other) = delete;
+		~MappedFile()
+		{
+			if (data_ != nullptr)
+			{
+				munmap(const_cast<char*>(data_), size_);
+			}
+		}
+
+		inline const char* data() const  { return data_; }
+		inline std::size_t size() const  { return size_; }
+		inline BinaryReader reader() const { return BinaryReader(data_, size_); }
+	};
+}
@@ -0,0 +1,48 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#include <sstream>  // std::stringstream
+
+#include <series/series.hpp>  
+#include <series/binary.hpp>  
+
+
+TEST_CASE( "Series<T> binary round trip", "[many]" ) {
+    series::floats a({1.5f, -2.f, 3.25f});
+    series::uints  b({7, 8, 9, 10, 11});
+    series::floats empty(0);
+    std::stringstream stream;
+    series::BinaryWriter writer(stream);
+    writer.write(std::uint32_t(42));
+    writer.write(a);
+    writer.write(empty);
+    writer.write(b);
+    const std::string bytes = stream.str();
+
+    SECTION("Series must be padded so that their elements are aligned"){
+        CHECK(bytes.size() % series::binary_alignment == 0);
+    }
+    SECTION("Series must be read back in the same state that they were written"){
+        series::BinaryReader reader(bytes.data(), bytes.size());
+        series::floats a2(10);
+        series::floats empty2(10);
+        series::uints  b2(0);
+        CHECK(reader.read<std::uint32_t>() == 42);
+        reader.read(a2);
+        reader.read(empty2);
+        reader.read(b2);
+        CHECK(a2 == a);
+        CHECK(empty2.size() == 0);
+        CHECK(b2 == b);
+    }
+    SECTION("Reading past the end of input must throw"){
+        series::BinaryReader reader(bytes.data(), bytes.size() / 2);
+        series::floats a2(0);
+        series::uints  b2(0);
+        reader.read<std::uint32_t>();
+        reader.read(a2);
+        reader.read(a2);
+        CHECK_THROWS(reader.read(b2));
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+// C libraries
+#include <cmath>        /* std::sqrt */
+
+// std libraries
+#include <cstddef>      // std::size_t
+#include <type_traits>  // std::enable_if_t
+#include <vector>       // std::vector
+
+#include "execution.hpp"
+
+/*
+"conjugate_gradient.hpp" solves symmetric positive definite linear systems, `A x = b`, for series of scalars.
+The solver is matrix-free: `A` is never stored, it is only applied to a series by a callback, `apply(x, out)`,
+so the same solver can be used for operators that are assembled as a `SparseMatrix` (see "sparse.hpp")
+and for operators that are calculated on the fly from the metrics of a grid (see "rasters/entities/Grid/diffusion.hpp").
+
+Convergence is accelerated by a preconditioner, `precondition(r, out)`, which stores an approximation of `A⁻¹ r` in `out`.
+The preconditioner must itself be symmetric positive definite, e.g. division by the diagonal of `A` ("Jacobi"),
+or a fixed number of symmetric multigrid cycles.
+*/
+
+namespace series
+{
+	/*
+	`inner_product()` returns the sum of `a[i]*b[i]`.
+	Blocks are summed in order after each is summed separately, so the result only depends on the number of blocks,
+	and the sum is accumulated in double precision so that it does not lose precision for large series.
+	*/
+	template <typename Tpolicy, typename T1, typename T2,
+		std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	double inner_product(const Tpolicy policy, const T1& a, const T2& b)
+	{
+		const std::size_t block_count = get_block_count(policy, a.size());
+		std::vector<double> block_sums(block_count, 0.0);
+		for_each_block(block_count, a.size(),
+			[&](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+				double sum(0);
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					sum += double(a[i]) * double(b[i]);
+				}
+				block_sums[block_id] = sum;
+			});
+		double sum(0);
+		for (const double block_sum : block_sums)
+		{
+			sum += block_sum;
+		}
+		return sum;
+	}
+	template <typename T1, typename T2>
+	double inner_product(const T1& a, const T2& b)
+	{
+		return inner_product(sequenced, a, b);
+	}
+
+	/*
+	`ConjugateGradientResult` describes how a call to `conjugate_gradient()` finished.
+	`relative_residual` is the norm of `b - A x` relative to the norm of `b`.
+	*/
+	struct ConjugateGradientResult
+	{
+		std::size_t iteration_count;
+		double relative_residual;
+		bool converged;
+	};
+
+	/*
+	`conjugate_gradient()` solves `A x = b` using the preconditioned conjugate gradient method.
+	`x` stores the initial guess on input and the solution on output,
+	so a good initial guess, such as the solution of the previous timestep, will reduce the number of iterations.
+	Iteration stops once the residual is within `tolerance` of `b`, relative to the norm of `b`, or after `max_iterations`.
+	Element-wise operations and inner products are run according to `policy`, see "execution.hpp",
+	but `apply` and `precondition` are responsible for their own parallelism.
+	`Tx` must be copy constructible, since the solver allocates four series of scratch space by copying `x`.
+	*/
+	template <typename Tpolicy, typename Tx, typename Tapply, typename Tprecondition,
+		std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	ConjugateGradientResult conjugate_gradient(
+		const Tpolicy policy,
+		const Tapply& apply,
+		const Tprecondition& precondition,
+		const Tx& b,
+		Tx& x,
+		const double tolerance,
+		const std::size_t max_iterations
+	) {
+		typedef std::remove_cv_t<std::remove_reference_t<decltype(x[0])>> T;
+		const std::size_t N = x.size();
+		Tx r(x); // residual
+		Tx z(x); // preconditioned residual
+		Tx p(x); // search direction
+		Tx q(x); // A p
+		apply(x, q);
+		for_each_id(policy, N, [&](const std::size_t i) { r[i] = b[i] - q[i]; });
+		const double b_norm = std::sqrt(inner_product(policy, b, b));
+		if (b_norm == 0.0)
+		{
+			for_each_id(policy, N, [&](const std::size_t i) { x[i] = T(0); });
+			return ConjugateGradientResult{0, 0.0, true};
+		}
+		double r_norm = std::sqrt(inner_product(policy, r, r));
+		precondition(r, z);
+		for_each_id(policy, N, [&](const std::size_t i) { p[i] = z[i]; });
+		double rz = inner_product(policy, r, z);
+		std::size_t iteration = 0;
+		for (; iteration < max_iterations && r_norm > tolerance * b_norm; ++iteration)
+		{
+			apply(p, q);
+			const double pq = inner_product(policy, p, q);
+			if (pq <= 0.0) { break; } // A is not positive definite along p, or p vanished due to rounding
+			const T alpha = T(rz / pq);
+			for_each_id(policy, N, [&](const std::size_t i) {
+				x[i] += alpha * p[i];
+				r[i] -= alpha * q[i];
+			});
+			r_norm = std::sqrt(inner_product(policy, r, r));
+			precondition(r, z);
+			const double rz_next = inner_product(policy, r, z);
+			const T beta = T(rz_next / rz);
+			rz = rz_next;
+			for_each_id(policy, N, [&](const std::size_t i) { p[i] = z[i] + beta * p[i]; });
+		}
+		return ConjugateGradientResult{iteration, r_norm / b_norm, r_norm <= tolerance * b_norm};
+	}
+	template <typename Tx, typename Tapply, typename Tprecondition>
+	ConjugateGradientResult conjugate_gradient(
+		const Tapply& apply,
+		const Tprecondition& precondition,
+		const Tx& b,
+		Tx& x,
+		const double tolerance,
+		const std::size_t max_iterations
+	) {
+		return conjugate_gradient(sequenced, apply, precondition, b, x, tolerance, max_iterations);
+	}
+}
@@ -0,0 +1,87 @@
+
+// std libraries
+#include <algorithm>  // std::max
+#include <cmath>      // std::abs
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#include <series/series.hpp>  
+#include <series/sparse.hpp>  
+#include <series/conjugate_gradient.hpp>  
+
+// returns a symmetric positive definite matrix with 3 on the diagonal and -1 between adjacent rows
+series::SparseMatrix<float> get_example_tridiagonal_matrix(const std::size_t N)
+{
+    series::SparseMatrix<float> a(N, N, 3*N-2);
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (i > 0)   { a.column_ids[j] = i-1; a.values[j] = -1; ++j; }
+        a.column_ids[j] = i; a.values[j] = 3; ++j;
+        if (i+1 < N) { a.column_ids[j] = i+1; a.values[j] = -1; ++j; }
+        a.row_offsets[i+1] = j;
+    }
+    return a;
+}
+
+TEST_CASE( "inner_product() correctness", "[many]" ) {
+    SECTION("inner_product() must return the sum of products of elements"){
+        CHECK(series::inner_product(series::floats({1, 2, 3}), series::floats({4, 5, 6})) == Approx(32));
+    }
+    SECTION("inner_product() must produce the same output regardless of policy"){
+        series::floats a(10000);
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            a[i] = float(i % 17) - 8.0f;
+        }
+        CHECK(series::inner_product(series::ParallelPolicy(4, 100), a, a) == Approx(series::inner_product(a, a)));
+    }
+}
+
+TEST_CASE( "conjugate_gradient() correctness", "[many]" ) {
+    const std::size_t N = 1000;
+    const series::SparseMatrix<float> a = get_example_tridiagonal_matrix(N);
+    const auto apply = [&](const series::floats& x, series::floats& out) { series::multiply(a, x, out); };
+    const auto precondition = [](const series::floats& r, series::floats& out) {
+        for (std::size_t i = 0; i < r.size(); ++i) { out[i] = r[i] / 3.0f; }
+    };
+    series::floats b(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        b[i] = float(i % 13) - 6.0f;
+    }
+    SECTION("conjugate_gradient() must find a solution to the system within the given tolerance"){
+        series::floats x(N, 0.0f);
+        const auto result = series::conjugate_gradient(apply, precondition, b, x, 1e-5, 1000);
+        series::floats Ax(N);
+        series::multiply(a, x, Ax);
+        float max_error = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            max_error = std::max(max_error, std::abs(Ax[i] - b[i]));
+        }
+        CHECK(result.converged);
+        CHECK(result.relative_residual <= 1e-5);
+        CHECK(max_error < 1e-3f);
+    }
+    SECTION("conjugate_gradient() must produce the same output regardless of policy"){
+        series::floats sequential_x(N, 0.0f);
+        series::floats parallel_x(N, 0.0f);
+        const auto sequential_result = series::conjugate_gradient(apply, precondition, b, sequential_x, 1e-5, 1000);
+        const auto parallel_result = series::conjugate_gradient(series::ParallelPolicy(4, 100), apply, precondition, b, parallel_x, 1e-5, 1000);
+        CHECK(sequential_result.iteration_count == parallel_result.iteration_count);
+        float max_difference = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            max_difference = std::max(max_difference, std::abs(sequential_x[i] - parallel_x[i]));
+        }
+        CHECK(max_difference < 1e-4f);
+    }
+    SECTION("conjugate_gradient() must return a zero solution for a zero right hand side"){
+        series::floats x(N, 1.0f);
+        const auto result = series::conjugate_gradient(apply, precondition, series::floats(N, 0.0f), x, 1e-5, 1000);
+        CHECK(result.iteration_count == 0);
+        CHECK(x == series::floats(N, 0.0f));
+    }
+}
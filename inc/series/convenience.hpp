@@ -155,7 +155,7 @@ namespace series
 	template <typename T>
 	Series<T> floor(const Series<T>& a)
 	{
-		return series::transform(std::floor, a);
+		return series::transform([](T ai){ return std::floor(ai); }, a);
 	}
 
 	/// Returns a value equal to the nearest integer to x
@@ -163,7 +163,7 @@ namespace series
 	template <typename T>
 	Series<T> trunc(const Series<T>& a)
 	{
-		return series::transform(std::trunc, a);
+		return series::transform([](T ai){ return std::trunc(ai); }, a);
 	}
 
 	/// Returns a value equal to the nearest integer to x.
@@ -174,7 +174,7 @@ namespace series
 	template <typename T>
 	Series<T> round(const Series<T>& a)
 	{
-		return series::transform(std::round, a);
+		return series::transform([](T ai){ return std::round(ai); }, a);
 	}
 
 	/// Returns a value equal to the nearest integer
@@ -182,7 +182,7 @@ namespace series
 	template <typename T>
 	Series<T> ceil(const Series<T>& a)
 	{
-		series::transform(std::ceil, a);
+		return series::transform([](T ai){ return std::ceil(ai); }, a);
 	}
 
 
@@ -0,0 +1,289 @@
+#pragma once
+
+// std libraries
+#include <algorithm>          // std::min, std::max
+#include <climits>            // CHAR_BIT
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <deque>              // std::deque
+#include <exception>          // std::exception_ptr
+#include <functional>         // std::function
+#include <mutex>              // std::mutex
+#include <thread>             // std::thread
+#include <type_traits>        // std::is_base_of
+#include <vector>             // std::vector
+
+/*
+"execution.hpp" contains execution policies that determine how the loops of `store()` and `aggregate_into()` are run.
+They mirror the policies of `std::execution`, but they are defined here since support for `std::execution`
+varies across compilers and requires linking with third party libraries like TBB.
+
+Policies are opt-in: they are passed as the first parameter to the methods that support them, e.g.
+
+	out.store(series::parallel, [](float ai, float bi){ return ai+bi; }, a, b);
+	aggregate_into(series::parallel, arrow_flow, arrow_vertex_id_from, [](float a, float b){ return a+b; }, out);
+
+Functions that are not passed a policy always run sequentially, as they did before.
+
+Parallel policies partition a loop into contiguous blocks, one per thread.
+Blocks are run by a pool of threads that persists between calls, so fine grained calls do not pay to start threads.
+Series that are too small to justify the cost of handing a block to another thread are always run sequentially,
+so it is safe to use parallel policies on small series as well.
+Series of booleans wrap `std::vector<bool>`, which packs neighboring elements into the same word,
+so loops that write to them must keep every block boundary on a multiple of `write_alignment<bool>`.
+*/
+
+namespace series
+{
+	class AbstractExecutionPolicy {};
+
+	// Runs loops on the calling thread, in order.
+	class SequencedPolicy : public AbstractExecutionPolicy {};
+
+	// Runs loops across multiple threads, with each thread visiting its own block in order.
+	class ParallelPolicy : public AbstractExecutionPolicy
+	{
+	public:
+		// the number of threads to use, or 0 to use the number of hardware threads
+		std::size_t thread_count;
+		// the smallest number of elements for which a thread will be started
+		std::size_t min_block_size;
+
+		explicit constexpr ParallelPolicy(const std::size_t thread_count = 0, const std::size_t min_block_size = 16384) :
+			thread_count(thread_count),
+			min_block_size(min_block_size)
+		{}
+	};
+
+	// Runs loops across multiple threads, and allows each thread to vectorize its block.
+	// Only use this policy where elements have no dependencies on one another.
+	class ParallelUnsequencedPolicy : public ParallelPolicy
+	{
+	public:
+		explicit constexpr ParallelUnsequencedPolicy(const std::size_t thread_count = 0, const std::size_t min_block_size = 16384) :
+			ParallelPolicy(thread_count, min_block_size)
+		{}
+	};
+
+	constexpr SequencedPolicy           sequenced;
+	constexpr ParallelPolicy            parallel;
+	constexpr ParallelUnsequencedPolicy parallel_unsequenced;
+
+	template <typename Tpolicy>
+	constexpr bool is_execution_policy = std::is_base_of<AbstractExecutionPolicy, Tpolicy>::value;
+
+	/*
+	`write_alignment<T>` is the multiple of elements at which separate threads may safely write to a container of `T`.
+	`std::vector<bool>` stores its elements as bits within words, and threads that write to different bits of a word would race,
+	so for booleans this is the largest word size that is used by standard library implementations.
+	*/
+	template <typename T>
+	constexpr std::size_t write_alignment = std::is_same<T,bool>::value? CHAR_BIT * sizeof(unsigned long long) : 1;
+
+
+
+	/*
+	`get_block_count()` returns the number of blocks that a loop of `N` elements will be split into under a given policy.
+	*/
+	inline std::size_t get_block_count(const SequencedPolicy policy, const std::size_t N)
+	{
+		return 1;
+	}
+	inline std::size_t get_block_count(const ParallelPolicy policy, const std::size_t N)
+	{
+		const std::size_t hardware_thread_count = std::max(std::size_t(std::thread::hardware_concurrency()), std::size_t(1));
+		const std::size_t thread_count = policy.thread_count > 0? policy.thread_count : hardware_thread_count;
+		return std::max(std::size_t(1), std::min(thread_count, N / std::max(policy.min_block_size, std::size_t(1))));
+	}
+
+	/*
+	`ThreadPool` stores the threads that run the blocks of parallel loops.
+	Threads are started the first time they are needed and are reused by every later loop,
+	until the pool is destroyed when the program exits.
+	Loops that are started from within a thread of the pool run sequentially on that thread,
+	since waiting on other threads of the pool from within the pool could cause every thread to wait on one another.
+	*/
+	class ThreadPool
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::function<void()>> tasks;
+		std::vector<std::thread> threads;
+		bool is_stopping;
+
+		static bool& is_worker_thread()
+		{
+			thread_local bool out = false;
+			return out;
+		}
+		void work()
+		{
+			is_worker_thread() = true;
+			while (true)
+			{
+				std::function<void()> task;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					condition.wait(lock, [this]{ return is_stopping || !tasks.empty(); });
+					if (tasks.empty()) { return; }
+					task = std::move(tasks.front());
+					tasks.pop_front();
+				}
+				task();
+			}
+		}
+
+		ThreadPool(): is_stopping(false) {}
+
+	public:
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				is_stopping = true;
+			}
+			condition.notify_all();
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+		}
+
+		static ThreadPool& get()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+		static bool is_worker()
+		{
+			return is_worker_thread();
+		}
+		// returns the number of threads that have been started by the pool
+		std::size_t size()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			return threads.size();
+		}
+		// starts threads until the pool has at least `thread_count` threads
+		void reserve(const std::size_t thread_count)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			while (threads.size() < thread_count)
+			{
+				threads.emplace_back([this]{ work(); });
+			}
+		}
+		void submit(std::function<void()> task)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				tasks.push_back(std::move(task));
+			}
+			condition.notify_one();
+		}
+	};
+
+	/*
+	`get_block_begin()` returns the first id of a block when [0,N) is partitioned into `block_count` blocks
+	whose boundaries are rounded down to a multiple of `alignment`.
+	*/
+	inline std::size_t get_block_begin(const std::size_t block_id, const std::size_t block_count, const std::size_t N, const std::size_t alignment)
+	{
+		return block_id >= block_count? N : ((N * block_id) / block_count) / alignment * alignment;
+	}
+
+	/*
+	`for_each_block()` calls `f(block_id, begin, end)` for each of `block_count` contiguous blocks that partition [0,N).
+	Boundaries between blocks are multiples of `alignment`, see `write_alignment`.
+	The calling thread always runs the first block, so a single block never involves another thread.
+	The remaining blocks are run by the `ThreadPool`, and the call returns once every block is complete.
+	If a block throws, the first exception is rethrown on the calling thread.
+	*/
+	template <typename F>
+	void for_each_block(const std::size_t block_count, const std::size_t N, const F f, const std::size_t alignment = 1)
+	{
+		if (block_count < 2 || ThreadPool::is_worker())
+		{
+			for (std::size_t block_id = 0; block_id < block_count; ++block_id)
+			{
+				f(block_id, get_block_begin(block_id, block_count, N, alignment), get_block_begin(block_id+1, block_count, N, alignment));
+			}
+			return;
+		}
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::size_t remaining_count = block_count-1;
+		std::exception_ptr exception;
+		ThreadPool& pool = ThreadPool::get();
+		pool.reserve(block_count-1);
+		for (std::size_t block_id = 1; block_id < block_count; ++block_id)
+		{
+			pool.submit([&, block_id]{
+				std::exception_ptr block_exception;
+				try
+				{
+					f(block_id, get_block_begin(block_id, block_count, N, alignment), get_block_begin(block_id+1, block_count, N, alignment));
+				}
+				catch (...)
+				{
+					block_exception = std::current_exception();
+				}
+				std::lock_guard<std::mutex> lock(mutex);
+				if (block_exception && !exception) { exception = block_exception; }
+				if (--remaining_count == 0) { condition.notify_one(); }
+			});
+		}
+		std::exception_ptr first_block_exception;
+		try
+		{
+			f(std::size_t(0), std::size_t(0), get_block_begin(1, block_count, N, alignment));
+		}
+		catch (...)
+		{
+			first_block_exception = std::current_exception();
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [&]{ return remaining_count == 0; });
+		if (first_block_exception) { std::rethrow_exception(first_block_exception); }
+		if (exception) { std::rethrow_exception(exception); }
+	}
+
+	/*
+	`for_each_id()` calls `f(i)` for each id in [0,N) according to a given policy.
+	If `f` writes to a container of `T`, pass `write_alignment<T>` as `alignment`.
+	*/
+	template <typename F>
+	inline void for_each_id(const SequencedPolicy policy, const std::size_t N, const F f, const std::size_t alignment = 1)
+	{
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			f(i);
+		}
+	}
+	template <typename F>
+	inline void for_each_id(const ParallelPolicy policy, const std::size_t N, const F f, const std::size_t alignment = 1)
+	{
+		for_each_block(get_block_count(policy, N), N,
+			[&f](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					f(i);
+				}
+			}, alignment);
+	}
+	template <typename F>
+	inline void for_each_id(const ParallelUnsequencedPolicy policy, const std::size_t N, const F f, const std::size_t alignment = 1)
+	{
+		for_each_block(get_block_count(policy, N), N,
+			[&f](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+				#pragma GCC ivdep
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					f(i);
+				}
+			}, alignment);
+	}
+
+}
@@ -0,0 +1,149 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#include <series/series.hpp>  
+#include <series/execution.hpp>  
+
+#include <algorithm>  // std::count
+#include <stdexcept>  // std::runtime_error
+#include <vector>  // std::vector
+
+
+TEST_CASE( "Series<T> store() execution policy consistency", "[many]" ) {
+    const std::size_t N = 100000;
+    const series::ParallelPolicy parallel(4, 1000);
+    const series::ParallelUnsequencedPolicy parallel_unsequenced(4, 1000);
+    series::floats a(N);
+    series::floats b(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        a[i] = float(i % 17) - 8.0f;
+        b[i] = float(i % 13) + 1.0f;
+    }
+    series::floats sequential_out(N);
+    series::floats parallel_out(N);
+    series::floats unsequenced_out(N);
+
+    SECTION("store() must produce the same output regardless of policy"){
+        sequential_out .store([](float ai, float bi, float ci){ return ai * bi + ci; }, a, b, 2.0f);
+        parallel_out   .store(parallel,             [](float ai, float bi, float ci){ return ai * bi + ci; }, a, b, 2.0f);
+        unsequenced_out.store(parallel_unsequenced, [](float ai, float bi, float ci){ return ai * bi + ci; }, a, b, 2.0f);
+        CHECK(sequential_out == parallel_out);
+        CHECK(sequential_out == unsequenced_out);
+    }
+
+    SECTION("store() must produce the same output for series that are too small to partition"){
+        series::floats c({1,2,3,4,5});
+        series::floats sequential_c(5);
+        series::floats parallel_c(5);
+        sequential_c.store([](float ci){ return ci * ci; }, c);
+        parallel_c  .store(series::parallel, [](float ci){ return ci * ci; }, c);
+        CHECK(sequential_c == parallel_c);
+    }
+
+    SECTION("store() must produce the same output for series of booleans, whose elements share words"){
+        series::bools sequential_bools(N+7);
+        series::bools parallel_bools(N+7);
+        series::bools unsequenced_bools(N+7);
+        const auto f = [](const std::size_t i){ return i % 3 == 0; };
+        series::uints ids(N+7);
+        for (std::size_t i = 0; i < ids.size(); ++i) { ids[i] = i; }
+        sequential_bools .store([&](unsigned int i){ return f(i); }, ids);
+        parallel_bools   .store(parallel,             [&](unsigned int i){ return f(i); }, ids);
+        unsequenced_bools.store(parallel_unsequenced, [&](unsigned int i){ return f(i); }, ids);
+        CHECK(sequential_bools == parallel_bools);
+        CHECK(sequential_bools == unsequenced_bools);
+    }
+
+    SECTION("block boundaries must be multiples of the write alignment for booleans"){
+        const std::size_t alignment = series::write_alignment<bool>;
+        std::vector<std::size_t> begins(7);
+        std::vector<std::size_t> ends(7);
+        series::for_each_block(7, N+7, [&](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+            begins[block_id] = begin;
+            ends[block_id] = end;
+        }, alignment);
+        CHECK(begins[0] == 0);
+        CHECK(ends[6] == N+7);
+        for (std::size_t i = 1; i < 7; ++i)
+        {
+            CHECK(begins[i] % alignment == 0);
+            CHECK(begins[i] == ends[i-1]);
+        }
+    }
+}
+
+TEST_CASE( "Series<T> aggregate_into() execution policy consistency", "[many]" ) {
+    const std::size_t N = 100000;
+    const std::size_t group_count = 1000;
+    const series::ParallelPolicy parallel(4, 1000);
+    series::floats a(N);
+    series::uints group_ids(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        a[i] = float(i % 17) - 8.0f;
+        group_ids[i] = (i * 7919) % group_count;
+    }
+    series::floats sequential_out(group_count, 1.0f);
+    series::floats parallel_out(group_count, 1.0f);
+
+    SECTION("aggregate_into() must produce the same output regardless of policy, even if the aggregator is not commutative"){
+        aggregate_into(          a, group_ids, [](float ai, float bi){ return 0.5f * ai - bi; }, sequential_out);
+        aggregate_into(parallel, a, group_ids, [](float ai, float bi){ return 0.5f * ai - bi; }, parallel_out);
+        CHECK(sequential_out == parallel_out);
+    }
+}
+
+TEST_CASE( "for_each_block() thread reuse", "[many]" ) {
+    const std::size_t N = 100000;
+    const series::ParallelPolicy parallel(4, 1000);
+
+    SECTION("repeated parallel calls must reuse the same threads"){
+        std::size_t thread_count = 0;
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            series::floats a(N, 1.0f);
+            a.store(parallel, [](float ai){ return ai + 1.0f; }, a);
+            if (i == 0) { thread_count = series::ThreadPool::get().size(); }
+        }
+        CHECK(thread_count > 0);
+        CHECK(series::ThreadPool::get().size() == thread_count);
+    }
+
+    SECTION("parallel calls that are nested within parallel calls must visit every id once"){
+        std::vector<std::size_t> visits(N*4, 0);
+        series::for_each_block(4, 4, [&](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+            series::for_each_id(parallel, N, [&](const std::size_t i) { visits[block_id*N + i]++; });
+        });
+        CHECK(std::count(visits.begin(), visits.end(), 1u) == std::ptrdiff_t(visits.size()));
+    }
+
+    SECTION("exceptions thrown by any block must be rethrown on the calling thread"){
+        CHECK_THROWS(series::for_each_block(4, 4, [](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+            if (block_id == 3) { throw std::runtime_error("block failed"); }
+        }));
+    }
+}
+
+TEST_CASE( "Series<T> aggregate_into() execution policy consistency with uneven groups", "[many]" ) {
+    const std::size_t N = 100000;
+    const std::size_t group_count = 37;
+    const series::ParallelPolicy parallel(4, 1000);
+    series::floats a(N);
+    series::uints group_ids(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        a[i] = float(i % 17) - 8.0f;
+        // most ids fall into the first group, so owners receive very different amounts of input
+        group_ids[i] = i % 5 == 0? (i * 7919) % group_count : 0;
+    }
+    series::floats sequential_out(group_count, 1.0f);
+    series::floats parallel_out(group_count, 1.0f);
+
+    SECTION("aggregate_into() must produce the same output regardless of how input is distributed among owners"){
+        aggregate_into(          a, group_ids, [](float ai, float bi){ return 0.5f * ai - bi; }, sequential_out);
+        aggregate_into(parallel, a, group_ids, [](float ai, float bi){ return 0.5f * ai - bi; }, parallel_out);
+        CHECK(sequential_out == parallel_out);
+    }
+}
@@ -0,0 +1,420 @@
+#pragma once
+
+// C libraries
+#include <assert.h>     /* assert */
+
+// std libraries
+#include <cmath>        // std::floor, std::trunc, std::round, std::ceil, std::sqrt, std::exp, std::log
+#include <cstddef>      // std::size_t
+#include <tuple>        // std::tuple, std::apply
+#include <type_traits>  // std::enable_if_t, std::is_base_of
+#include <utility>      // std::declval
+
+#include "types.hpp"
+
+/*
+"expression.hpp" contains lazy alternatives to the operators and convenience functions
+that are found in "operators.hpp" and "convenience.hpp".
+
+Those functions return a new `Series` for every operation,
+so a statement like `(a + b + c) / 3.f` allocates three series and makes four passes over memory.
+The functions here instead return small "expression" objects that only record what must be calculated.
+Nothing is calculated until the expression is assigned to a `Series` (or anything that derives from it, like a `Raster`),
+at which point every element is calculated in a single pass without creating any temporary series.
+
+Lazy evaluation is opt-in: wrap any one series of a statement in `lazy()`,
+and all operations that involve the resulting expression will be lazy as well:
+
+	face_midpoints = (lazy(face_endpoint_a) + face_endpoint_b + face_endpoint_c) / 3.f;
+
+Expressions refer to series by reference, so an expression must never outlive the series it refers to.
+In practice this means an expression should be assigned within the same statement that creates it,
+and it should never be stored using `auto`.
+
+Expressions are series in their own right, so they may also be passed to `Series::store()`
+to be evaluated under an execution policy:
+
+	out.store(policy, [](float ei){ return ei; }, lazy(a) * b + c);
+
+Element-wise functions that depend on glm can be found in "glm/expression.hpp".
+*/
+
+namespace series
+{
+
+	/*
+	`SeriesReference` is the leaf of an expression tree.
+	It simply refers to the elements of an existing series.
+	*/
+	template <typename T>
+	class SeriesReference : public AbstractExpression
+	{
+		const Series<T>& a;
+	public:
+		using value_type = T;
+
+		explicit SeriesReference(const Series<T>& a) : a(a) {}
+
+		inline std::size_t size() const                 { return a.size(); }
+		inline T operator[](const std::size_t id) const { return a[id];     }
+	};
+
+	/*
+	`Expression` represents the application of a function `f`
+	over any combination of expressions and singletons.
+	It mirrors the behavior of `Series::store()`, except that elements are only calculated on request.
+	*/
+	template <typename F, typename... Targs>
+	class Expression : public AbstractExpression
+	{
+		template <typename Targ>
+		static constexpr bool is_expression = std::is_base_of<AbstractExpression, Targ>::value;
+
+		template <typename Targ>
+		static inline decltype(auto) get_element(const Targ& a, const std::size_t id)
+		{
+			if constexpr (is_expression<Targ>) { return a[id]; }
+			else                               { return a;     }
+		}
+		template <typename Targ>
+		static inline std::size_t get_size(const Targ& a, const std::size_t size)
+		{
+			if constexpr (is_expression<Targ>)
+			{
+				assert(size == 0 || size == a.size());
+				return a.size();
+			}
+			else
+			{
+				return size;
+			}
+		}
+
+		F f;
+		std::tuple<Targs...> args;
+		std::size_t N;
+
+	public:
+		using value_type = decltype(std::declval<F>()(get_element(std::declval<Targs>(), 0)...));
+
+		explicit Expression(const F f, const Targs... args) : f(f), args(args...), N(0)
+		{
+			((N = get_size(args, N)), ...);
+		}
+
+		inline std::size_t size() const { return N; }
+		inline value_type operator[](const std::size_t id) const
+		{
+			return std::apply([this, id](const Targs&... args){ return f(get_element(args, id)...); }, args);
+		}
+	};
+
+
+
+	/*
+	`lazy()` begins an expression from an existing series.
+	*/
+	template <typename T>
+	inline SeriesReference<T> lazy(const Series<T>& a)
+	{
+		return SeriesReference<T>(a);
+	}
+	template <typename Texpression, std::enable_if_t<std::is_base_of<AbstractExpression, Texpression>::value, int> = 0>
+	inline Texpression lazy(const Texpression& a)
+	{
+		return a;
+	}
+
+	/*
+	`operand()` converts the arguments of an expression to a form that can be stored within the expression:
+	expressions and singletons are copied (they are small), and series are referenced.
+	*/
+	template <typename T, std::enable_if_t<!std::is_base_of<AbstractSeries, T>::value || std::is_base_of<AbstractExpression, T>::value, int> = 0>
+	inline T operand(const T& a)
+	{
+		return a;
+	}
+	template <typename T>
+	inline SeriesReference<T> operand(const Series<T>& a)
+	{
+		return SeriesReference<T>(a);
+	}
+
+	/*
+	`express()` is the lazy analog to `transform()` in "convenience.hpp",
+	it's used to define every other function in this file.
+	*/
+	template <typename F, typename... Targs>
+	inline auto express(const F f, const Targs&... args)
+	{
+		return Expression<F, decltype(operand(args))...>(f, operand(args)...);
+	}
+
+
+
+	/*
+	NOTE: operators are only defined here when at least one operand is an expression.
+	Operations between plain series and singletons remain eager, as defined in "operators.hpp".
+	We use `enable_if` to exclude cases where both operands are plain series or singletons.
+	*/
+	template <typename T1, typename T2>
+	constexpr bool is_lazy_operation =
+		std::is_base_of<AbstractExpression, T1>::value || std::is_base_of<AbstractExpression, T2>::value;
+
+	template <typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto operator+(const T1& a, const T2& b)
+	{
+		return express([](auto ai, auto bi){ return ai + bi; }, a, b);
+	}
+	template <typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto operator-(const T1& a, const T2& b)
+	{
+		return express([](auto ai, auto bi){ return ai - bi; }, a, b);
+	}
+	template <typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto operator*(const T1& a, const T2& b)
+	{
+		return express([](auto ai, auto bi){ return ai * bi; }, a, b);
+	}
+	template <typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto operator/(const T1& a, const T2& b)
+	{
+		return express([](auto ai, auto bi){ return ai / bi; }, a, b);
+	}
+	template <typename T1, std::enable_if_t<std::is_base_of<AbstractExpression, T1>::value, int> = 0>
+	inline auto operator-(const T1& a)
+	{
+		return express([](auto ai){ return -ai; }, a);
+	}
+
+
+
+	template <typename T, typename Texpression, std::enable_if_t<std::is_base_of<AbstractExpression, Texpression>::value, int> = 0>
+	inline Series<T>& operator+=(Series<T>& a, const Texpression& b)
+	{
+		assert(a.size() == b.size());
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			a[i] += b[i];
+		}
+		return a;
+	}
+	template <typename T, typename Texpression, std::enable_if_t<std::is_base_of<AbstractExpression, Texpression>::value, int> = 0>
+	inline Series<T>& operator-=(Series<T>& a, const Texpression& b)
+	{
+		assert(a.size() == b.size());
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			a[i] -= b[i];
+		}
+		return a;
+	}
+	template <typename T, typename Texpression, std::enable_if_t<std::is_base_of<AbstractExpression, Texpression>::value, int> = 0>
+	inline Series<T>& operator*=(Series<T>& a, const Texpression& b)
+	{
+		assert(a.size() == b.size());
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			a[i] *= b[i];
+		}
+		return a;
+	}
+	template <typename T, typename Texpression, std::enable_if_t<std::is_base_of<AbstractExpression, Texpression>::value, int> = 0>
+	inline Series<T>& operator/=(Series<T>& a, const Texpression& b)
+	{
+		assert(a.size() == b.size());
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			a[i] /= b[i];
+		}
+		return a;
+	}
+
+
+
+	/*
+	NOTE: "common.hpp" declares unconstrained singleton overloads like `abs(const T a)`,
+	so the overloads below are declared for each expression class to guarantee they are more specialized.
+	*/
+
+	/// Returns x if x >= 0; otherwise, it returns -x.
+	template <typename F, typename... Targs>
+	inline auto abs(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return ai >= 0? ai : -ai; }, a);
+	}
+	template <typename T>
+	inline auto abs(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return ai >= 0? ai : -ai; }, a);
+	}
+
+	/// Returns 1.0 if x > 0, 0.0 if x == 0, or -1.0 if x < 0.
+	template <typename F, typename... Targs>
+	inline auto sign(const Expression<F,Targs...>& a)
+	{
+		typedef typename Expression<F,Targs...>::value_type T;
+		return express([](T ai){ return T((T(0) < ai) - (ai < T(0))); }, a);
+	}
+	template <typename T>
+	inline auto sign(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return T((T(0) < ai) - (ai < T(0))); }, a);
+	}
+
+	/// Returns a value equal to the nearest integer that is less then or equal to x.
+	template <typename F, typename... Targs>
+	inline auto floor(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return std::floor(ai); }, a);
+	}
+	template <typename T>
+	inline auto floor(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return std::floor(ai); }, a);
+	}
+
+	/// Returns a value equal to the nearest integer to x
+	/// whose absolute value is not larger than the absolute value of x.
+	template <typename F, typename... Targs>
+	inline auto trunc(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return std::trunc(ai); }, a);
+	}
+	template <typename T>
+	inline auto trunc(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return std::trunc(ai); }, a);
+	}
+
+	/// Returns a value equal to the nearest integer to x.
+	template <typename F, typename... Targs>
+	inline auto round(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return std::round(ai); }, a);
+	}
+	template <typename T>
+	inline auto round(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return std::round(ai); }, a);
+	}
+
+	/// Returns a value equal to the nearest integer that is greater than or equal to x.
+	template <typename F, typename... Targs>
+	inline auto ceil(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return std::ceil(ai); }, a);
+	}
+	template <typename T>
+	inline auto ceil(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return std::ceil(ai); }, a);
+	}
+
+	/// Return x - floor(x).
+	template <typename F, typename... Targs>
+	inline auto fract(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return ai - std::floor(ai); }, a);
+	}
+	template <typename T>
+	inline auto fract(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return ai - std::floor(ai); }, a);
+	}
+
+	/// Returns the positive square root of x.
+	template <typename F, typename... Targs>
+	inline auto sqrt(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return std::sqrt(ai); }, a);
+	}
+	template <typename T>
+	inline auto sqrt(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return std::sqrt(ai); }, a);
+	}
+
+	/// Returns the natural exponentiation of x, i.e., e^x.
+	template <typename F, typename... Targs>
+	inline auto exp(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return std::exp(ai); }, a);
+	}
+	template <typename T>
+	inline auto exp(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return std::exp(ai); }, a);
+	}
+
+	/// Returns the natural logarithm of x.
+	template <typename F, typename... Targs>
+	inline auto log(const Expression<F,Targs...>& a)
+	{
+		return express([](auto ai){ return std::log(ai); }, a);
+	}
+	template <typename T>
+	inline auto log(const SeriesReference<T>& a)
+	{
+		return express([](T ai){ return std::log(ai); }, a);
+	}
+
+	/// Returns y if y < x; otherwise, it returns x.
+	template <typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto min(const T1& a, const T2& b)
+	{
+		return express([](auto ai, auto bi){ return bi < ai? bi : ai; }, a, b);
+	}
+	template <typename F, typename... Targs>
+	inline auto min(const Expression<F,Targs...>& a, const Expression<F,Targs...>& b)
+	{
+		return express([](auto ai, auto bi){ return bi < ai? bi : ai; }, a, b);
+	}
+	template <typename T>
+	inline auto min(const SeriesReference<T>& a, const SeriesReference<T>& b)
+	{
+		return express([](T ai, T bi){ return bi < ai? bi : ai; }, a, b);
+	}
+
+	/// Returns y if x < y; otherwise, it returns x.
+	template <typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto max(const T1& a, const T2& b)
+	{
+		return express([](auto ai, auto bi){ return ai < bi? bi : ai; }, a, b);
+	}
+	template <typename F, typename... Targs>
+	inline auto max(const Expression<F,Targs...>& a, const Expression<F,Targs...>& b)
+	{
+		return express([](auto ai, auto bi){ return ai < bi? bi : ai; }, a, b);
+	}
+	template <typename T>
+	inline auto max(const SeriesReference<T>& a, const SeriesReference<T>& b)
+	{
+		return express([](T ai, T bi){ return ai < bi? bi : ai; }, a, b);
+	}
+
+	/// Returns min(max(x, minVal), maxVal).
+	template <typename T1, typename T2, typename T3, std::enable_if_t<is_lazy_operation<T1,T2> || is_lazy_operation<T1,T3>, int> = 0>
+	inline auto clamp(const T1& a, const T2& lo, const T3& hi)
+	{
+		return express([](auto ai, auto loi, auto hii){ return ai < loi? loi : hii < ai? hii : ai; }, a, lo, hi);
+	}
+
+	/// Returns x * (1.0 - a) + y * a, i.e., the linear blend of x and y using the floating-point value a.
+	template <typename T1, typename T2, typename T3, std::enable_if_t<is_lazy_operation<T1,T2> || is_lazy_operation<T1,T3>, int> = 0>
+	inline auto mix(const T1& x, const T2& y, const T3& a)
+	{
+		return express([](auto xi, auto yi, auto ai){ return xi * (decltype(ai)(1) - ai) + yi * ai; }, x, y, a);
+	}
+	template <typename F, typename... Targs>
+	inline auto mix(const Expression<F,Targs...>& x, const Expression<F,Targs...>& y, const Expression<F,Targs...>& a)
+	{
+		return express([](auto xi, auto yi, auto ai){ return xi * (decltype(ai)(1) - ai) + yi * ai; }, x, y, a);
+	}
+	template <typename T>
+	inline auto mix(const SeriesReference<T>& x, const SeriesReference<T>& y, const SeriesReference<T>& a)
+	{
+		return express([](T xi, T yi, T ai){ return xi * (T(1) - ai) + yi * ai; }, x, y, a);
+	}
+
+}
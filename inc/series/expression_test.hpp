@@ -0,0 +1,105 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#include <series/series.hpp>  
+#include <series/convenience.hpp>  
+#include <series/operators.hpp>  
+#include <series/common.hpp>  
+#include <series/exponential.hpp>  
+#include <series/expression.hpp>  
+
+
+TEST_CASE( "Series<T> expression consistency", "[many]" ) {
+    series::floats a = series::floats({1,2,3,4,5});
+    series::floats b = series::floats({-1,1,-2,2,3});
+    series::floats c = series::floats({2,4,6,8,10});
+    series::floats eager = series::floats({0,0,0,0,0});
+    series::floats lazy = series::floats({0,0,0,0,0});
+
+    SECTION("a+b+c evaluated lazily must equal a+b+c evaluated eagerly"){
+        eager = a + b + c;
+        lazy  = series::lazy(a) + b + c;
+        CHECK(eager == lazy);
+    }
+
+    SECTION("(a-b)*c/2 evaluated lazily must equal (a-b)*c/2 evaluated eagerly"){
+        eager = (a - b) * c / 2.0f;
+        lazy  = (series::lazy(a) - b) * c / 2.0f;
+        CHECK(eager == lazy);
+    }
+
+    SECTION("sign(-(a*b)) evaluated lazily must equal sign(-(a*b)) evaluated eagerly"){
+        eager = sign(-(a * b));
+        lazy  = sign(-(series::lazy(a) * b));
+        CHECK(eager == lazy);
+    }
+
+    SECTION("in place operators must work the same for expressions and series"){
+        eager = a;
+        lazy  = a;
+        eager *= b + c;
+        lazy  *= series::lazy(b) + c;
+        CHECK(eager == lazy);
+    }
+
+    SECTION("an expression must be able to refer to the series it is assigned to"){
+        eager = a;
+        lazy  = a;
+        eager = eager * b + eager;
+        lazy  = series::lazy(lazy) * b + lazy;
+        CHECK(eager == lazy);
+    }
+
+    SECTION("a series must be constructible from an expression"){
+        series::floats constructed = series::lazy(a) + b;
+        eager = a + b;
+        CHECK(eager == constructed);
+    }
+
+    SECTION("rounding functions evaluated lazily must equal their eager counterparts"){
+        series::floats d = a / 3.0f - b;
+        eager = floor(d) + trunc(d) + round(d) + ceil(d) + fract(d);
+        lazy  = floor(series::lazy(d)) + trunc(series::lazy(d)) + round(series::lazy(d)) + ceil(series::lazy(d)) + fract(series::lazy(d));
+        CHECK(eager == lazy);
+    }
+
+    SECTION("sqrt(exp(log(a))) evaluated lazily must equal a"){
+        lazy  = sqrt(exp(log(series::lazy(a)*a)));
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            CHECK(lazy[i] == Approx(a[i]));
+        }
+    }
+
+    SECTION("min and max evaluated lazily must equal their eager counterparts"){
+        eager = a;
+        series::min(a, b, eager);
+        lazy  = min(series::lazy(a), series::lazy(b));
+        CHECK(eager == lazy);
+        series::max(a, b, eager);
+        lazy  = max(series::lazy(a), b);
+        CHECK(eager == lazy);
+        series::max(a, 3.0f, eager);
+        lazy  = max(series::lazy(a), 3.0f);
+        CHECK(eager == lazy);
+    }
+
+    SECTION("clamp and mix evaluated lazily must equal their eager counterparts"){
+        series::clamp(b, 0.0f, 2.0f, eager);
+        lazy  = clamp(series::lazy(b), 0.0f, 2.0f);
+        CHECK(eager == lazy);
+        series::floats t = series::floats({0.0f,0.25f,0.5f,0.75f,1.0f});
+        eager = a * (1.0f - t) + c * t;
+        lazy  = mix(series::lazy(a), series::lazy(c), series::lazy(t));
+        CHECK(eager == lazy);
+        lazy  = mix(series::lazy(a), c, 0.5f);
+        CHECK(lazy == (a + c) / 2.0f);
+    }
+
+    SECTION("an expression must be able to be stored using an execution policy"){
+        eager = a * b + c;
+        lazy.store(series::parallel, [](float ei){ return ei; }, series::lazy(a) * b + c);
+        CHECK(eager == lazy);
+    }
+}
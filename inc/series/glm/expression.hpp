@@ -0,0 +1,86 @@
+#pragma once
+
+// std libraries
+#include <type_traits>  // std::enable_if_t, std::is_base_of
+
+#include "../types.hpp"
+#include "../expression.hpp"
+#include "geometric.hpp"
+
+/*
+"expression.hpp" contains lazy alternatives to the geometric functions found in "convenience.hpp",
+See "../expression.hpp" for more details.
+*/
+
+namespace series
+{
+
+	/*
+	NOTE: expressions of glm vectors carry glm types as template parameters, 
+	so argument dependent lookup will also consider glm's unconstrained `genType` overloads, 
+	like `glm::length(genType)` or `glm::dot(T, T)`.
+	We declare overloads for each expression class so that ours are always more specialized.
+	Binary functions only need this for arguments of the same type, since `genType` requires it.
+	*/
+
+	template<typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto dot (const T1& u, const T2& v) 
+	{
+		return express([](auto ui, auto vi){ return series::dot(ui,vi); }, u, v);
+	}
+	template<typename F, typename... Targs>
+	inline auto dot (const Expression<F,Targs...>& u, const Expression<F,Targs...>& v) 
+	{
+		return express([](auto ui, auto vi){ return series::dot(ui,vi); }, u, v);
+	}
+	template<typename T>
+	inline auto dot (const SeriesReference<T>& u, const SeriesReference<T>& v) 
+	{
+		return express([](auto ui, auto vi){ return series::dot(ui,vi); }, u, v);
+	}
+
+	template<typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto cross (const T1& u, const T2& v) 
+	{
+		return express([](auto ui, auto vi){ return series::cross(ui,vi); }, u, v);
+	}
+
+	template<typename T1, typename T2, std::enable_if_t<is_lazy_operation<T1,T2>, int> = 0>
+	inline auto distance (const T1& u, const T2& v) 
+	{
+		return express([](auto ui, auto vi){ return series::distance(ui,vi); }, u, v);
+	}
+	template<typename F, typename... Targs>
+	inline auto distance (const Expression<F,Targs...>& u, const Expression<F,Targs...>& v) 
+	{
+		return express([](auto ui, auto vi){ return series::distance(ui,vi); }, u, v);
+	}
+	template<typename T>
+	inline auto distance (const SeriesReference<T>& u, const SeriesReference<T>& v) 
+	{
+		return express([](auto ui, auto vi){ return series::distance(ui,vi); }, u, v);
+	}
+
+	template<typename F, typename... Targs>
+	inline auto normalize(const Expression<F,Targs...>& u) 
+	{
+		return express([](auto ui){ return series::normalize(ui); }, u);
+	}
+	template<typename T>
+	inline auto normalize(const SeriesReference<T>& u) 
+	{
+		return express([](auto ui){ return series::normalize(ui); }, u);
+	}
+
+	template<typename F, typename... Targs>
+	inline auto length(const Expression<F,Targs...>& u) 
+	{
+		return express([](auto ui){ return series::length(ui); }, u);
+	}
+	template<typename T>
+	inline auto length(const SeriesReference<T>& u) 
+	{
+		return express([](auto ui){ return series::length(ui); }, u);
+	}
+
+}
@@ -0,0 +1,48 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#include <series/series.hpp>  
+#include <series/convenience.hpp>  
+#include <series/operators.hpp>  
+#include <series/expression.hpp>  
+
+#include "types_test_utils.hpp"
+#include "convenience.hpp"
+#include "expression.hpp"
+
+
+TEST_CASE( "Series<T> geometric expression consistency", "[many]" ) {
+    std::mt19937 generator(2);
+    series::vec3s a = series::get_random_vec3s(5, generator);
+    series::vec3s b = series::get_random_vec3s(5, generator);
+    series::vec3s c = series::get_random_vec3s(5, generator);
+    series::floats eager_floats = series::floats({0,0,0,0,0});
+    series::floats lazy_floats  = series::floats({0,0,0,0,0});
+    series::vec3s eager_vec3s = series::get_random_vec3s(5, generator);
+    series::vec3s lazy_vec3s  = series::get_random_vec3s(5, generator);
+
+    SECTION("length(cross(c-b,a-b)) evaluated lazily must equal length(cross(c-b,a-b)) evaluated eagerly"){
+        eager_floats = length(cross(c - b, a - b)) / 2.0f;
+        lazy_floats  = length(cross(series::lazy(c) - b, series::lazy(a) - b)) / 2.0f;
+        CHECK(eager_floats == lazy_floats);
+    }
+
+    SECTION("dot(a,normalize(b)) evaluated lazily must equal dot(a,normalize(b)) evaluated eagerly"){
+        eager_floats = dot(a, normalize(b));
+        lazy_floats  = dot(series::lazy(a), normalize(series::lazy(b)));
+        CHECK(eager_floats == lazy_floats);
+    }
+
+    SECTION("(a+b+c)/3 evaluated lazily must equal (a+b+c)/3 evaluated eagerly"){
+        eager_vec3s = (a + b + c) / 3.0f;
+        lazy_vec3s  = (series::lazy(a) + b + c) / 3.0f;
+        CHECK(eager_vec3s == lazy_vec3s);
+    }
+
+    SECTION("a*distance(b,c) evaluated lazily must equal a*distance(b,c) evaluated eagerly"){
+        eager_vec3s = a * distance(b, c);
+        lazy_vec3s  = series::lazy(a) * distance(series::lazy(b), c);
+        CHECK(eager_vec3s == lazy_vec3s);
+    }
+}
@@ -0,0 +1,392 @@
+#pragma once
+
+// C libraries
+#include <assert.h>     /* assert */
+#include <cmath>        // std::sqrt, std::floor
+
+// 3rd party libraries
+#include <glm/vec3.hpp> // *vec3
+
+#include "../types.hpp"
+#include "../execution.hpp"
+
+/*
+"lanes.hpp" contains `Vec3Lanes`, a series of 3d vectors that is stored as a "structure of arrays":
+each component is stored in its own contiguous series, or "lane".
+`Series<glm::vec3>` is instead stored as an "array of structures", where the components of a vector are interleaved.
+
+Interleaved components prevent compilers from vectorizing loops over geometric functions like `dot()` and `cross()`,
+since each operation on a vector must first gather components from different offsets,
+and `GLM_FORCE_PURE` prevents glm from providing its own SIMD implementation.
+Lanes avoid this: every function below is a single loop that reads and writes each lane contiguously,
+which compilers vectorize for whatever instruction set is enabled at compile time (e.g. SSE, AVX2, AVX-512, or WebAssembly SIMD).
+No intrinsics are used, so the library remains portable.
+
+Use `split()` and `join()` to convert to and from `Series<glm::vec3>`,
+and keep data in lanes for as long as possible between conversions, since each conversion is a full pass over memory.
+Functions optionally accept an execution policy as their first parameter, see "series/execution.hpp".
+*/
+
+namespace series
+{
+	template <typename T>
+	struct Vec3Lanes
+	{
+		Series<T> x;
+		Series<T> y;
+		Series<T> z;
+
+		explicit Vec3Lanes(const std::size_t N) : x(N), y(N), z(N) {}
+
+		inline std::size_t size() const { return x.size(); }
+		inline glm::vec<3,T,glm::defaultp> operator[](const std::size_t id) const
+		{
+			return glm::vec<3,T,glm::defaultp>(x[id], y[id], z[id]);
+		}
+	};
+
+	typedef Vec3Lanes<float>  vec3lanes;
+	typedef Vec3Lanes<double> dvec3lanes;
+
+	/*
+	`for_each_lane_block()` calls `f(begin, end)` for contiguous blocks that partition [0,N), according to a given policy.
+	Loops within `f` should be simple enough for the compiler to vectorize.
+	*/
+	template <typename F>
+	inline void for_each_lane_block(const SequencedPolicy policy, const std::size_t N, const F f)
+	{
+		f(std::size_t(0), N);
+	}
+	template <typename F>
+	inline void for_each_lane_block(const ParallelPolicy policy, const std::size_t N, const F f)
+	{
+		for_each_block(get_block_count(policy, N), N,
+			[&f](const std::size_t block_id, const std::size_t begin, const std::size_t end) { f(begin, end); });
+	}
+
+
+
+	template <typename Tpolicy, typename T, glm::qualifier Q, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void split(const Tpolicy policy, const Series<glm::vec<3,T,Q>>& a, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == out.size());
+		const glm::vec<3,T,Q>* ai = a.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				ox[i] = ai[i].x;
+				oy[i] = ai[i].y;
+				oz[i] = ai[i].z;
+			}
+		});
+	}
+	template <typename Tpolicy, typename T, glm::qualifier Q, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void join(const Tpolicy policy, const Vec3Lanes<T>& a, Series<glm::vec<3,T,Q>>& out)
+	{
+		assert(a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		glm::vec<3,T,Q>* oi = out.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				oi[i] = glm::vec<3,T,Q>(ax[i], ay[i], az[i]);
+			}
+		});
+	}
+
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void add(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == b.size() && a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		const T* bx = b.x.data(); const T* by = b.y.data(); const T* bz = b.z.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = ax[i] + bx[i];
+				const T y = ay[i] + by[i];
+				const T z = az[i] + bz[i];
+				ox[i] = x;
+				oy[i] = y;
+				oz[i] = z;
+			}
+		});
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void sub(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == b.size() && a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		const T* bx = b.x.data(); const T* by = b.y.data(); const T* bz = b.z.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = ax[i] - bx[i];
+				const T y = ay[i] - by[i];
+				const T z = az[i] - bz[i];
+				ox[i] = x;
+				oy[i] = y;
+				oz[i] = z;
+			}
+		});
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void mult(const Tpolicy policy, const Vec3Lanes<T>& a, const Series<T>& b, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == b.size() && a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		const T* bi = b.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = ax[i] * bi[i];
+				const T y = ay[i] * bi[i];
+				const T z = az[i] * bi[i];
+				ox[i] = x;
+				oy[i] = y;
+				oz[i] = z;
+			}
+		});
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void mult(const Tpolicy policy, const Vec3Lanes<T>& a, const T b, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = ax[i] * b;
+				const T y = ay[i] * b;
+				const T z = az[i] * b;
+				ox[i] = x;
+				oy[i] = y;
+				oz[i] = z;
+			}
+		});
+	}
+
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void dot(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Series<T>& out)
+	{
+		assert(a.size() == b.size() && a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		const T* bx = b.x.data(); const T* by = b.y.data(); const T* bz = b.z.data();
+		T* oi = out.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				oi[i] = ax[i]*bx[i] + ay[i]*by[i] + az[i]*bz[i];
+			}
+		});
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void cross(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == b.size() && a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		const T* bx = b.x.data(); const T* by = b.y.data(); const T* bz = b.z.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = ay[i]*bz[i] - by[i]*az[i];
+				const T y = az[i]*bx[i] - bz[i]*ax[i];
+				const T z = ax[i]*by[i] - bx[i]*ay[i];
+				ox[i] = x;
+				oy[i] = y;
+				oz[i] = z;
+			}
+		});
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void length(const Tpolicy policy, const Vec3Lanes<T>& a, Series<T>& out)
+	{
+		assert(a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		T* oi = out.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				oi[i] = std::sqrt(ax[i]*ax[i] + ay[i]*ay[i] + az[i]*az[i]);
+			}
+		});
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void distance(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Series<T>& out)
+	{
+		assert(a.size() == b.size() && a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		const T* bx = b.x.data(); const T* by = b.y.data(); const T* bz = b.z.data();
+		T* oi = out.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T dx = ax[i] - bx[i];
+				const T dy = ay[i] - by[i];
+				const T dz = az[i] - bz[i];
+				oi[i] = std::sqrt(dx*dx + dy*dy + dz*dz);
+			}
+		});
+	}
+	// NOTE: like `series::normalize()`, vectors with a length below 1e-5 are left unscaled
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void normalize(const Tpolicy policy, const Vec3Lanes<T>& a, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = ax[i];
+				const T y = ay[i];
+				const T z = az[i];
+				const T length = std::sqrt(x*x + y*y + z*z);
+				const T scale = T(1) / (length < T(1e-5)? T(1) : length);
+				ox[i] = x * scale;
+				oy[i] = y * scale;
+				oz[i] = z * scale;
+			}
+		});
+	}
+
+
+
+	/*
+	`transform_lanes()` stores `f(ai)` or `f(ai,bi)` in `out` for each component of each vector,
+	it is used to define the component-wise functions below, mirroring "common.hpp".
+	*/
+	template <typename Tpolicy, typename T, typename F, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void transform_lanes(const Tpolicy policy, const F f, const Vec3Lanes<T>& a, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = f(ax[i]);
+				const T y = f(ay[i]);
+				const T z = f(az[i]);
+				ox[i] = x;
+				oy[i] = y;
+				oz[i] = z;
+			}
+		});
+	}
+	template <typename Tpolicy, typename T, typename F, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void transform_lanes(const Tpolicy policy, const F f, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == b.size() && a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		const T* bx = b.x.data(); const T* by = b.y.data(); const T* bz = b.z.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = f(ax[i], bx[i]);
+				const T y = f(ay[i], by[i]);
+				const T z = f(az[i], bz[i]);
+				ox[i] = x;
+				oy[i] = y;
+				oz[i] = z;
+			}
+		});
+	}
+
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void abs(const Tpolicy policy, const Vec3Lanes<T>& a, Vec3Lanes<T>& out)
+	{
+		transform_lanes(policy, [](const T ai){ return ai < T(0)? -ai : ai; }, a, out);
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void floor(const Tpolicy policy, const Vec3Lanes<T>& a, Vec3Lanes<T>& out)
+	{
+		transform_lanes(policy, [](const T ai){ return std::floor(ai); }, a, out);
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void min(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)
+	{
+		transform_lanes(policy, [](const T ai, const T bi){ return bi < ai? bi : ai; }, a, b, out);
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void max(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)
+	{
+		transform_lanes(policy, [](const T ai, const T bi){ return ai < bi? bi : ai; }, a, b, out);
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void clamp(const Tpolicy policy, const Vec3Lanes<T>& a, const T lo, const T hi, Vec3Lanes<T>& out)
+	{
+		transform_lanes(policy, [lo, hi](const T ai){ return ai < lo? lo : hi < ai? hi : ai; }, a, out);
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void mix(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, const T t, Vec3Lanes<T>& out)
+	{
+		transform_lanes(policy, [t](const T ai, const T bi){ return ai * (T(1) - t) + bi * t; }, a, b, out);
+	}
+	template <typename Tpolicy, typename T, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void mix(const Tpolicy policy, const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, const Series<T>& t, Vec3Lanes<T>& out)
+	{
+		assert(a.size() == b.size() && a.size() == t.size() && a.size() == out.size());
+		const T* ax = a.x.data(); const T* ay = a.y.data(); const T* az = a.z.data();
+		const T* bx = b.x.data(); const T* by = b.y.data(); const T* bz = b.z.data();
+		const T* ti = t.data();
+		T* ox = out.x.data(); T* oy = out.y.data(); T* oz = out.z.data();
+		for_each_lane_block(policy, a.size(), [=](const std::size_t begin, const std::size_t end){
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const T x = ax[i] * (T(1) - ti[i]) + bx[i] * ti[i];
+				const T y = ay[i] * (T(1) - ti[i]) + by[i] * ti[i];
+				const T z = az[i] * (T(1) - ti[i]) + bz[i] * ti[i];
+				ox[i] = x;
+				oy[i] = y;
+				oz[i] = z;
+			}
+		});
+	}
+
+
+
+	template <typename T, glm::qualifier Q>
+	inline void split(const Series<glm::vec<3,T,Q>>& a, Vec3Lanes<T>& out)                 { split(sequenced, a, out); }
+	template <typename T, glm::qualifier Q>
+	inline void join(const Vec3Lanes<T>& a, Series<glm::vec<3,T,Q>>& out)                  { join(sequenced, a, out); }
+	template <typename T>
+	inline void add(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)       { add(sequenced, a, b, out); }
+	template <typename T>
+	inline void sub(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)       { sub(sequenced, a, b, out); }
+	template <typename T>
+	inline void mult(const Vec3Lanes<T>& a, const Series<T>& b, Vec3Lanes<T>& out)         { mult(sequenced, a, b, out); }
+	template <typename T>
+	inline void mult(const Vec3Lanes<T>& a, const T b, Vec3Lanes<T>& out)                  { mult(sequenced, a, b, out); }
+	template <typename T>
+	inline void dot(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Series<T>& out)          { dot(sequenced, a, b, out); }
+	template <typename T>
+	inline void cross(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)     { cross(sequenced, a, b, out); }
+	template <typename T>
+	inline void length(const Vec3Lanes<T>& a, Series<T>& out)                              { length(sequenced, a, out); }
+	template <typename T>
+	inline void distance(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Series<T>& out)     { distance(sequenced, a, b, out); }
+	template <typename T>
+	inline void normalize(const Vec3Lanes<T>& a, Vec3Lanes<T>& out)                        { normalize(sequenced, a, out); }
+	template <typename T>
+	inline void abs(const Vec3Lanes<T>& a, Vec3Lanes<T>& out)                              { abs(sequenced, a, out); }
+	template <typename T>
+	inline void floor(const Vec3Lanes<T>& a, Vec3Lanes<T>& out)                            { floor(sequenced, a, out); }
+	template <typename T>
+	inline void min(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)       { min(sequenced, a, b, out); }
+	template <typename T>
+	inline void max(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, Vec3Lanes<T>& out)       { max(sequenced, a, b, out); }
+	template <typename T>
+	inline void clamp(const Vec3Lanes<T>& a, const T lo, const T hi, Vec3Lanes<T>& out)    { clamp(sequenced, a, lo, hi, out); }
+	template <typename T>
+	inline void mix(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, const T t, Vec3Lanes<T>& out)         { mix(sequenced, a, b, t, out); }
+	template <typename T>
+	inline void mix(const Vec3Lanes<T>& a, const Vec3Lanes<T>& b, const Series<T>& t, Vec3Lanes<T>& out) { mix(sequenced, a, b, t, out); }
+}
@@ -0,0 +1,93 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>
+#include <glm/common.hpp>
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>  
+
+#include "lanes.hpp"
+#include "geometric.hpp"
+#include "relational.hpp"
+
+
+TEST_CASE( "Vec3Lanes<T> consistency", "[many]" ) {
+    std::mt19937 generator(2);
+    const std::size_t N = 1000;
+    series::vec3s a = series::get_random_vec3s(N, generator);
+    series::vec3s b = series::get_random_vec3s(N, generator);
+    a[0] = glm::vec3(0);
+    series::vec3lanes a_lanes(N);
+    series::vec3lanes b_lanes(N);
+    series::split(a, a_lanes);
+    series::split(b, b_lanes);
+    series::vec3lanes vector_out_lanes(N);
+    series::vec3s vector_out(N);
+    series::vec3s expected_vector_out(N);
+    series::floats scalar_out(N);
+    series::floats expected_scalar_out(N);
+
+    SECTION("split() and join() must be inverses"){
+        series::join(a_lanes, vector_out);
+        CHECK(series::equal(a, vector_out));
+    }
+    SECTION("dot() must produce the same output for lanes and interleaved vectors"){
+        series::dot(a_lanes, b_lanes, scalar_out);
+        series::dot(a, b, expected_scalar_out);
+        CHECK(series::equal(scalar_out, expected_scalar_out, 1e-4f));
+    }
+    SECTION("cross() must produce the same output for lanes and interleaved vectors"){
+        series::cross(a_lanes, b_lanes, vector_out_lanes);
+        series::join(vector_out_lanes, vector_out);
+        series::cross(a, b, expected_vector_out);
+        CHECK(series::equal(vector_out, expected_vector_out, 1e-4f));
+    }
+    SECTION("length() and distance() must produce the same output for lanes and interleaved vectors"){
+        series::length(a_lanes, scalar_out);
+        series::length(a, expected_scalar_out);
+        CHECK(series::equal(scalar_out, expected_scalar_out, 1e-4f));
+        series::distance(a_lanes, b_lanes, scalar_out);
+        series::distance(a, b, expected_scalar_out);
+        CHECK(series::equal(scalar_out, expected_scalar_out, 1e-4f));
+    }
+    SECTION("normalize() must produce the same output for lanes and interleaved vectors"){
+        series::normalize(a_lanes, vector_out_lanes);
+        series::join(vector_out_lanes, vector_out);
+        series::normalize(a, expected_vector_out);
+        CHECK(series::equal(vector_out, expected_vector_out, 1e-4f));
+    }
+    SECTION("component-wise functions must produce the same output for lanes and interleaved vectors"){
+        const auto check_unary = [&](const series::vec3lanes& lanes, const auto f) {
+            series::join(lanes, vector_out);
+            for (std::size_t i = 0; i < N; ++i) { expected_vector_out[i] = f(a[i], b[i]); }
+            CHECK(series::equal(vector_out, expected_vector_out, 1e-6f));
+        };
+        series::abs(a_lanes, vector_out_lanes);
+        check_unary(vector_out_lanes, [](glm::vec3 ai, glm::vec3 bi){ return glm::abs(ai); });
+        series::mult(a_lanes, 10.0f, vector_out_lanes);
+        series::floor(vector_out_lanes, vector_out_lanes);
+        check_unary(vector_out_lanes, [](glm::vec3 ai, glm::vec3 bi){ return glm::floor(ai * 10.0f); });
+        series::min(a_lanes, b_lanes, vector_out_lanes);
+        check_unary(vector_out_lanes, [](glm::vec3 ai, glm::vec3 bi){ return glm::min(ai, bi); });
+        series::max(a_lanes, b_lanes, vector_out_lanes);
+        check_unary(vector_out_lanes, [](glm::vec3 ai, glm::vec3 bi){ return glm::max(ai, bi); });
+        series::clamp(a_lanes, -0.5f, 0.5f, vector_out_lanes);
+        check_unary(vector_out_lanes, [](glm::vec3 ai, glm::vec3 bi){ return glm::clamp(ai, -0.5f, 0.5f); });
+        series::mix(a_lanes, b_lanes, 0.25f, vector_out_lanes);
+        check_unary(vector_out_lanes, [](glm::vec3 ai, glm::vec3 bi){ return glm::mix(ai, bi, 0.25f); });
+        series::floats t(N, 0.75f);
+        series::mix(a_lanes, b_lanes, t, vector_out_lanes);
+        check_unary(vector_out_lanes, [](glm::vec3 ai, glm::vec3 bi){ return glm::mix(ai, bi, 0.75f); });
+    }
+    SECTION("functions must produce the same output regardless of policy"){
+        series::vec3lanes parallel_out_lanes(N);
+        series::cross(a_lanes, b_lanes, vector_out_lanes);
+        series::cross(series::ParallelPolicy(4, 16), a_lanes, b_lanes, parallel_out_lanes);
+        CHECK(vector_out_lanes.x == parallel_out_lanes.x);
+        CHECK(vector_out_lanes.y == parallel_out_lanes.y);
+        CHECK(vector_out_lanes.z == parallel_out_lanes.z);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+// std libraries
+#include <cstddef>      // std::size_t
+#include <type_traits>  // std::enable_if_t
+#include <utility>      // std::declval
+
+#include <glm/geometric.hpp>// dot
+
+#include "../sparse.hpp"
+
+/*
+"glm/sparse.hpp" overloads `multiply()` from "../sparse.hpp" for matrices of vectors that are applied to series of vectors.
+The product of each entry with an element of the input is the dot product,
+so a matrix of `glm::vec3` multiplied with a series of `glm::vec3` produces a series of floats,
+as is needed for operators such as divergence, see "rasters/entities/Grid/sparse.hpp".
+*/
+
+namespace series
+{
+	template <typename Tpolicy, glm::length_t L, typename T, glm::qualifier Q, typename Tid, typename Tx, typename Tout,
+		std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0,
+		std::enable_if_t<std::is_same<std::remove_cv_t<std::remove_reference_t<decltype(std::declval<const Tx&>()[0])>>, glm::vec<L,T,Q>>::value, int> = 0>
+	void multiply(const Tpolicy policy, const SparseMatrix<glm::vec<L,T,Q>,Tid>& a, const Tx& x, Tout& out)
+	{
+		assert(x.size() == a.column_count);
+		assert(out.size() == a.row_count());
+		for_each_id(policy, a.row_count(), [&](const std::size_t i) {
+			T sum(0);
+			for (std::size_t j = a.row_offsets[i]; j < a.row_offsets[i+1]; ++j)
+			{
+				sum += glm::dot(a.values[j], x[a.column_ids[j]]);
+			}
+			out[i] = sum;
+		});
+	}
+}
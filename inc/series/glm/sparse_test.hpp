@@ -0,0 +1,34 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#include <series/series.hpp>  
+#include <series/sparse.hpp>  
+
+#include "types.hpp"
+#include "sparse.hpp"
+
+TEST_CASE( "SparseMatrix of vectors multiply() correctness", "[many]" ) {
+    /*
+    [ (1,0,0)  (0,1,0) ]
+    [    0     (0,0,2) ]
+    */
+    series::SparseMatrix<glm::vec3> a(2, 2, 3);
+    a.row_offsets = series::Series<std::size_t>({0, 2, 3});
+    a.column_ids  = series::uints({0, 1, 1});
+    a.values      = series::vec3s({glm::vec3(1,0,0), glm::vec3(0,1,0), glm::vec3(0,0,2)});
+    SECTION("multiply() must sum the dot products of entries with a series of vectors"){
+        const series::vec3s x({glm::vec3(1,2,3), glm::vec3(4,5,6)});
+        series::floats out(2);
+        series::multiply(a, x, out);
+        CHECK(out == series::floats({6, 12}));
+        series::multiply(series::ParallelPolicy(2, 1), a, x, out);
+        CHECK(out == series::floats({6, 12}));
+    }
+    SECTION("multiply() must scale entries by a series of scalars"){
+        const series::floats x({1, 2});
+        series::vec3s out(2);
+        series::multiply(a, x, out);
+        CHECK(out == series::vec3s({glm::vec3(1,2,0), glm::vec3(0,0,4)}));
+    }
+}
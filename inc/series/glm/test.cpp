@@ -4,3 +4,7 @@
 #include "./exponential_test.hpp"
 #include "./geometric_test.hpp"
 #include "./relational_test.hpp"
+#include "./view_test.hpp"
+#include "./lanes_test.hpp"
+#include "./sparse_test.hpp"
+#include "./expression_test.hpp"
@@ -0,0 +1,89 @@
+#pragma once
+
+// 3rd party libraries
+#include <glm/vec2.hpp>   // *vec2
+#include <glm/vec3.hpp>   // *vec3
+#include <glm/vec4.hpp>   // *vec4
+
+#include "../types.hpp"
+#include "../view.hpp"
+
+/*
+"view.hpp" contains views of the components of vector series, see "series/view.hpp" for more details on views.
+These are in-place alternatives to `get_x()`, `get_y()`, etc., e.g.
+
+	series::vec3s positions(100);
+	auto heights = series::view_z(positions);
+	series::add(heights, 1.f, heights);
+
+`get_x()`, `get_y()`, and `get_z()` also accept views as either input or output,
+so that components can be split out of a view of vectors, or into a view of another series.
+*/
+
+namespace series
+{
+	template <typename Tvector, typename T>
+	inline StridedSeriesView<T> view_component(T* values, const std::size_t count, const std::size_t component_id)
+	{
+		static_assert(sizeof(Tvector) == Tvector::length() * sizeof(T), "vectors must be tightly packed to be viewed by component");
+		assert(component_id < std::size_t(Tvector::length()));
+		return StridedSeriesView<T>(values + component_id, count, Tvector::length());
+	}
+
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	inline StridedSeriesView<T> view_x(Series<glm::vec<L,T,Q>>& a)
+	{
+		return view_component<glm::vec<L,T,Q>>(reinterpret_cast<T*>(a.data()), a.size(), 0);
+	}
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	inline StridedSeriesView<const T> view_x(const Series<glm::vec<L,T,Q>>& a)
+	{
+		return view_component<glm::vec<L,T,Q>>(reinterpret_cast<const T*>(a.data()), a.size(), 0);
+	}
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	inline StridedSeriesView<T> view_y(Series<glm::vec<L,T,Q>>& a)
+	{
+		return view_component<glm::vec<L,T,Q>>(reinterpret_cast<T*>(a.data()), a.size(), 1);
+	}
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	inline StridedSeriesView<const T> view_y(const Series<glm::vec<L,T,Q>>& a)
+	{
+		return view_component<glm::vec<L,T,Q>>(reinterpret_cast<const T*>(a.data()), a.size(), 1);
+	}
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	inline StridedSeriesView<T> view_z(Series<glm::vec<L,T,Q>>& a)
+	{
+		return view_component<glm::vec<L,T,Q>>(reinterpret_cast<T*>(a.data()), a.size(), 2);
+	}
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	inline StridedSeriesView<const T> view_z(const Series<glm::vec<L,T,Q>>& a)
+	{
+		return view_component<glm::vec<L,T,Q>>(reinterpret_cast<const T*>(a.data()), a.size(), 2);
+	}
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	inline StridedSeriesView<T> view_w(Series<glm::vec<L,T,Q>>& a)
+	{
+		return view_component<glm::vec<L,T,Q>>(reinterpret_cast<T*>(a.data()), a.size(), 3);
+	}
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	inline StridedSeriesView<const T> view_w(const Series<glm::vec<L,T,Q>>& a)
+	{
+		return view_component<glm::vec<L,T,Q>>(reinterpret_cast<const T*>(a.data()), a.size(), 3);
+	}
+
+	template <typename T, typename Tout, std::enable_if_t<is_series_view<T> || is_series_view<std::decay_t<Tout>>, int> = 0>
+	void get_x(const T& a, Tout&& out)
+	{
+		out.store([](const typename T::value_type ai){ return ai.x; }, a);
+	}
+	template <typename T, typename Tout, std::enable_if_t<is_series_view<T> || is_series_view<std::decay_t<Tout>>, int> = 0>
+	void get_y(const T& a, Tout&& out)
+	{
+		out.store([](const typename T::value_type ai){ return ai.y; }, a);
+	}
+	template <typename T, typename Tout, std::enable_if_t<is_series_view<T> || is_series_view<std::decay_t<Tout>>, int> = 0>
+	void get_z(const T& a, Tout&& out)
+	{
+		out.store([](const typename T::value_type ai){ return ai.z; }, a);
+	}
+}
@@ -0,0 +1,39 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>  
+#include <series/glm/view.hpp>  
+
+
+TEST_CASE( "Series<vec*> component view correctness", "[many]" ) {
+    series::vec3s a({glm::vec3(1,2,3), glm::vec3(4,5,6)});
+
+    SECTION("Component views must refer to the components of the series they view"){
+        auto y = series::view_y(a);
+        CHECK(y.size() == 2);
+        CHECK(y[0] == 2.f);
+        CHECK(y[1] == 5.f);
+        series::mult(y, 10.f, y);
+        CHECK(a[0] == glm::vec3(1,20,3));
+        CHECK(a[1] == glm::vec3(4,50,6));
+    }
+    SECTION("Component views must match the output of get_x(), get_y(), get_z()"){
+        series::floats z(2);
+        series::copy(z, series::view_z(static_cast<const series::vec3s&>(a)));
+        CHECK(z == series::floats({3,6}));
+    }
+    SECTION("get_x(), get_y(), get_z() must accept views as input and output"){
+        series::floats y(1);
+        series::get_y(series::view(a, 1, 2), y);
+        CHECK(y == series::floats({5}));
+        series::floats xs(4);
+        series::get_x(a, series::view(xs, 1, 3));
+        CHECK(xs == series::floats({0,1,4,0}));
+    }
+}
+
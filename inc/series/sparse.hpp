@@ -0,0 +1,135 @@
+#pragma once
+
+// C libraries
+#include <assert.h>     /* assert */
+
+// std libraries
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t
+#include <type_traits>  // std::enable_if_t
+
+#include "types.hpp"
+#include "execution.hpp"
+
+/*
+"sparse.hpp" contains a sparse matrix type, so that linear operators can be assembled once and applied many times.
+Matrices are stored in compressed sparse row ("CSR") format:
+the entries of row `i` occupy ids `row_offsets[i]` up to `row_offsets[i+1]` within `column_ids` and `values`.
+`Tid` only needs to represent column ids, such as vertex ids, while `row_offsets` are stored as `std::size_t`,
+since the number of entries can exceed the largest vertex id, e.g. on a `Grid<std::uint16_t>` with more than 65535 arrows.
+This is the same format that `Structure` uses to store the neighbors of each vertex,
+so an operator that gathers input from neighbors maps directly onto the rows of a matrix, see "rasters/entities/Grid/sparse.hpp".
+
+`multiply()` calculates the product of a matrix and a series.
+Each row only writes to its own output, so rows can be run in parallel without races, see "execution.hpp".
+Values may be of any type whose product with elements of the input is defined,
+e.g. a matrix of `glm::vec3` multiplied with a series of floats produces a series of `glm::vec3`.
+*/
+
+namespace series
+{
+	template <typename T, typename Tid=std::uint32_t>
+	struct SparseMatrix
+	{
+		std::size_t column_count;
+		Series<std::size_t> row_offsets;
+		Series<Tid>         column_ids;
+		Series<T>           values;
+
+		SparseMatrix(const std::size_t row_count, const std::size_t column_count, const std::size_t nonzero_count) :
+			column_count(column_count),
+			row_offsets(row_count+1, std::size_t(0)),
+			column_ids(nonzero_count),
+			values(nonzero_count)
+		{}
+
+		inline std::size_t row_count() const     { return row_offsets.size()-1; }
+		inline std::size_t nonzero_count() const { return values.size(); }
+	};
+
+	/*
+	`multiply()` stores the product of `a` and `x` in `out`.
+	If `rhs_count` is given, `x` and `out` store `rhs_count` interleaved right hand sides,
+	where element `j` of right hand side `k` is stored at `j*rhs_count+k`, as is done for the layers of a `LayeredRaster`.
+	All right hand sides are calculated while visiting each row once, so the matrix is only read once from memory.
+	*/
+	template <typename Tpolicy, typename T, typename Tid, typename Tx, typename Tout,
+		std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void multiply(const Tpolicy policy, const SparseMatrix<T,Tid>& a, const Tx& x, Tout& out, const std::size_t rhs_count)
+	{
+		typedef std::remove_cv_t<std::remove_reference_t<decltype(out[0])>> Tvalue;
+		assert(x.size() == a.column_count * rhs_count);
+		assert(out.size() == a.row_count() * rhs_count);
+		for_each_id(policy, a.row_count(), [&](const std::size_t i) {
+			for (std::size_t k = 0; k < rhs_count; ++k)
+			{
+				out[i*rhs_count+k] = Tvalue(0);
+			}
+			for (std::size_t j = a.row_offsets[i]; j < a.row_offsets[i+1]; ++j)
+			{
+				const std::size_t column_id = a.column_ids[j];
+				const T value = a.values[j];
+				for (std::size_t k = 0; k < rhs_count; ++k)
+				{
+					out[i*rhs_count+k] += value * x[column_id*rhs_count+k];
+				}
+			}
+		});
+	}
+	template <typename T, typename Tid, typename Tx, typename Tout>
+	void multiply(const SparseMatrix<T,Tid>& a, const Tx& x, Tout& out, const std::size_t rhs_count)
+	{
+		multiply(sequenced, a, x, out, rhs_count);
+	}
+	template <typename Tpolicy, typename T, typename Tid, typename Tx, typename Tout,
+		std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+	void multiply(const Tpolicy policy, const SparseMatrix<T,Tid>& a, const Tx& x, Tout& out)
+	{
+		typedef std::remove_cv_t<std::remove_reference_t<decltype(out[0])>> Tvalue;
+		assert(x.size() == a.column_count);
+		assert(out.size() == a.row_count());
+		for_each_id(policy, a.row_count(), [&](const std::size_t i) {
+			Tvalue sum(0);
+			for (std::size_t j = a.row_offsets[i]; j < a.row_offsets[i+1]; ++j)
+			{
+				sum += a.values[j] * x[a.column_ids[j]];
+			}
+			out[i] = sum;
+		});
+	}
+	template <typename T, typename Tid, typename Tx, typename Tout>
+	void multiply(const SparseMatrix<T,Tid>& a, const Tx& x, Tout& out)
+	{
+		multiply(sequenced, a, x, out);
+	}
+
+	/*
+	`transpose()` returns the transpose of `a`, with entries of each row in ascending order of column.
+	It is used to build an operator that scatters from the rows of `a`, such as restriction from prolongation,
+	so that it can be applied as a gather that is safe to run in parallel.
+	*/
+	template <typename T, typename Tid>
+	SparseMatrix<T,Tid> transpose(const SparseMatrix<T,Tid>& a)
+	{
+		SparseMatrix<T,Tid> out(a.column_count, a.row_count(), a.nonzero_count());
+		for (std::size_t j = 0; j < a.nonzero_count(); ++j)
+		{
+			++out.row_offsets[a.column_ids[j]+1];
+		}
+		for (std::size_t i = 0; i < a.column_count; ++i)
+		{
+			out.row_offsets[i+1] += out.row_offsets[i];
+		}
+		Series<std::size_t> next_ids(out.row_offsets.begin(), out.row_offsets.end()-1);
+		for (std::size_t i = 0; i < a.row_count(); ++i)
+		{
+			for (std::size_t j = a.row_offsets[i]; j < a.row_offsets[i+1]; ++j)
+			{
+				const std::size_t k = next_ids[a.column_ids[j]]++;
+				out.column_ids[k] = i;
+				out.values[k] = a.values[j];
+			}
+		}
+		return out;
+	}
+}
@@ -0,0 +1,82 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#include <series/series.hpp>  
+#include <series/sparse.hpp>  
+
+
+series::SparseMatrix<float> get_example_matrix()
+{
+    /*
+    [ 2  0  1 ]
+    [ 0  0  0 ]
+    [-1  3  0 ]
+    [ 0  0  4 ]
+    */
+    series::SparseMatrix<float> a(4, 3, 5);
+    a.row_offsets = series::Series<std::size_t>({0, 2, 2, 4, 5});
+    a.column_ids  = series::uints({0, 2, 0, 1, 2});
+    a.values      = series::floats({2, 1,-1, 3, 4});
+    return a;
+}
+
+TEST_CASE( "SparseMatrix multiply() correctness", "[many]" ) {
+    const series::SparseMatrix<float> a = get_example_matrix();
+    SECTION("multiply() must calculate the product of a matrix and a series"){
+        series::floats x({1, 2, 3});
+        series::floats out(4);
+        series::multiply(a, x, out);
+        CHECK(out == series::floats({5, 0, 5, 12}));
+    }
+    SECTION("multiply() must calculate the product of a matrix and each of several interleaved right hand sides"){
+        series::floats x({1,10, 2,20, 3,30});
+        series::floats out(8);
+        series::multiply(a, x, out, 2);
+        CHECK(out == series::floats({5,50, 0,0, 5,50, 12,120}));
+    }
+}
+
+TEST_CASE( "SparseMatrix transpose() correctness", "[many]" ) {
+    const series::SparseMatrix<float> a = get_example_matrix();
+    const series::SparseMatrix<float> b = series::transpose(a);
+    SECTION("transpose() must swap the rows and columns of a matrix"){
+        CHECK(b.row_count() == 3);
+        CHECK(b.column_count == 4);
+        CHECK(b.row_offsets == series::Series<std::size_t>({0, 2, 3, 5}));
+        CHECK(b.column_ids  == series::uints({0, 2, 2, 0, 3}));
+        CHECK(b.values      == series::floats({2,-1, 3, 1, 4}));
+    }
+    SECTION("transpose() must be its own inverse"){
+        const series::SparseMatrix<float> c = series::transpose(b);
+        CHECK(c.row_offsets == a.row_offsets);
+        CHECK(c.column_ids  == a.column_ids);
+        CHECK(c.values      == a.values);
+    }
+}
+
+TEST_CASE( "SparseMatrix multiply() execution policy consistency", "[many]" ) {
+    const std::size_t N = 10000;
+    series::SparseMatrix<float> a(N, N, 3*N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        a.row_offsets[i+1] = 3*(i+1);
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            a.column_ids[3*i+j] = (i + j*j*7) % N;
+            a.values[3*i+j] = float(j) - 1.5f;
+        }
+    }
+    series::floats x(2*N);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = float(i % 17) - 8.0f;
+    }
+    series::floats sequential_out(2*N);
+    series::floats parallel_out(2*N);
+    SECTION("multiply() must produce the same output regardless of policy"){
+        series::multiply(a, x, sequential_out, 2);
+        series::multiply(series::ParallelPolicy(4, 100), a, x, parallel_out, 2);
+        CHECK(sequential_out == parallel_out);
+    }
+}
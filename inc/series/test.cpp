@@ -10,3 +10,10 @@
 #include "./string_cast_test.hpp"
 #include "./exponential_test.hpp"
 #include "./relational_test.hpp"
+#include "./execution_test.hpp"
+#include "./binary_test.hpp"
+#include "./view_test.hpp"
+#include "./sparse_test.hpp"
+#include "./conjugate_gradient_test.hpp"
+#include "./expression_test.hpp"
+#include "./glm/expression_test.hpp"
@@ -9,10 +9,45 @@
 #include <iterator>			// std::distance
 #include <vector>			// std::distance
 
+#include "execution.hpp"
+
 namespace series
 {
 	class AbstractSeries {};
 
+	/*
+	`AbstractSeriesView` marks a series that refers to elements that are owned by another object, without copying them.
+	See "view.hpp" for more details.
+	*/
+	class AbstractSeriesView : public AbstractSeries {};
+
+	template <typename T>
+	constexpr bool is_series_view = std::is_base_of<AbstractSeriesView, T>::value;
+
+	/*
+	`AbstractExpression` marks a series whose elements are only calculated once they are requested.
+	It derives from `AbstractSeries` so that functions and operators will never mistake it for a singleton.
+	See "expression.hpp" for more details.
+	*/
+	class AbstractExpression : public AbstractSeries {};
+
+	/*
+	`get_element()` and `get_size()` allow variadic functions to treat series and singletons alike:
+	a singleton is treated as if it were a series of the appropriate size whose elements are all the same.
+	*/
+	template <typename Targ>
+	inline decltype(auto) get_element(const Targ& a, const std::size_t id)
+	{
+		if constexpr (std::is_base_of<AbstractSeries, Targ>::value) { return a[id]; }
+		else                                                       { return a;     }
+	}
+	template <typename Targ>
+	inline std::size_t get_size(const Targ& a, const std::size_t size)
+	{
+		if constexpr (std::is_base_of<AbstractSeries, Targ>::value) { return a.size(); }
+		else                                                       { return size;     }
+	}
+
 	/*
 	This template represents a statically-sized contiguous block of heap memory occupied by primitive data of the same arbitrary type.
 	It is a thin wrapper for a std::vector and shares most of the same method signatures.
@@ -66,6 +101,16 @@ namespace series
 			}
 		}
 
+		// expression constructor, evaluates each element of the expression in a single pass
+		template <typename Texpression, std::enable_if_t<std::is_base_of<AbstractExpression, Texpression>::value, int> = 0>
+		Series(const Texpression& a)  : values(a.size())
+		{
+			for (std::size_t i = 0; i < a.size(); ++i)
+			{
+				values[i] = a[i];
+			}
+		}
+
 		// NOTE: all wrapper functions should to be marked inline 
 		inline std::size_t size() const                               { return values.size();  }
 		inline std::size_t max_size() const                           { return values.size();  }
@@ -117,11 +162,33 @@ namespace series
 			fill(*this, other);
 			return *this;
 		}
+		/*
+		NOTE: an expression may safely refer to the series it is assigned to,
+		since every element of an expression only depends on elements at the same index.
+		*/
+		template <typename Texpression, std::enable_if_t<std::is_base_of<AbstractExpression, Texpression>::value, int> = 0>
+		inline Series<T>& operator=(const Texpression& other )
+		{
+			values.resize(other.size());
+			for (std::size_t i = 0; i < other.size(); ++i)
+			{
+				values[i] = other[i];
+			}
+			return *this;
+		}
 
 		inline std::vector<T>& vector()
 		{
 			return values;
 		}
+		inline T* data()
+		{
+			return values.data();
+		}
+		inline const T* data() const
+		{
+			return values.data();
+		}
 
 
 
@@ -206,7 +273,7 @@ namespace series
 				values[i] = f(a[i], b);
 			}
 		}
-		template <typename T1, typename T2, typename F, std::enable_if_t<!std::is_base_of<AbstractSeries, T1>::value, int> = 0>
+		template <typename T1, typename T2, typename F, std::enable_if_t<!std::is_base_of<AbstractSeries, T1>::value && !is_execution_policy<F>, int> = 0>
 		inline void store(const F f, const T1 a, const Series<T2>& b)
 		{
 			assert(b.size() == values.size());
@@ -250,7 +317,7 @@ namespace series
 			}
 		}
 		template <typename T1, typename T2, typename T3, typename F,
-			std::enable_if_t<!std::is_base_of<AbstractSeries, T2>::value && !std::is_base_of<AbstractSeries, T2>::value, int> = 0>
+			std::enable_if_t<!std::is_base_of<AbstractSeries, T2>::value && !std::is_base_of<AbstractSeries, T3>::value, int> = 0>
 		inline void store(const F f, const Series<T1>& a, const T2 b, const T3 c)
 		{
 			assert(a.size() == values.size());
@@ -259,7 +326,7 @@ namespace series
 				values[i] = f(a[i], b, c);
 			}
 		}
-		template <typename T1, typename T2, typename T3, typename F, std::enable_if_t<!std::is_base_of<AbstractSeries, T1>::value, int> = 0>
+		template <typename T1, typename T2, typename T3, typename F, std::enable_if_t<!std::is_base_of<AbstractSeries, T1>::value && !is_execution_policy<F>, int> = 0>
 		inline void store(const F f, const T1 a, const Series<T2>& b, const Series<T3>& c)
 		{
 			assert(b.size() == values.size());
@@ -270,7 +337,7 @@ namespace series
 			}
 		}
 		template <typename T1, typename T2, typename T3, typename F,
-			std::enable_if_t<!std::is_base_of<AbstractSeries, T1>::value && !std::is_base_of<AbstractSeries, T3>::value, int> = 0>
+			std::enable_if_t<!std::is_base_of<AbstractSeries, T1>::value && !std::is_base_of<AbstractSeries, T3>::value && !is_execution_policy<F>, int> = 0>
 		inline void store(const F f, const T1 a, const Series<T2>& b, const T3 c)
 		{
 			assert(b.size() == values.size());
@@ -280,7 +347,7 @@ namespace series
 			}
 		}
 		template <typename T1, typename T2, typename T3, typename F,
-			std::enable_if_t<!std::is_base_of<AbstractSeries, T1>::value && !std::is_base_of<AbstractSeries, T2>::value, int> = 0>
+			std::enable_if_t<!std::is_base_of<AbstractSeries, T1>::value && !std::is_base_of<AbstractSeries, T2>::value && !is_execution_policy<F>, int> = 0>
 		inline void store(const F f, const T1 a, const T2 b, const Series<T3>& c)
 		{
 			assert(c.size() == values.size());
@@ -291,6 +358,33 @@ namespace series
 		}
 
 
+		/*
+		PARALLEL TRANSFORM
+		This mirrors the behavior of the overloads above, but its loop is run according to a given execution policy.
+		See "execution.hpp" for more details.
+		*/
+		template <typename Tpolicy, typename F, typename... Targs, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+		inline void store(const Tpolicy policy, const F f, const Targs&... args)
+		{
+			assert(((get_size(args, values.size()) == values.size()) && ...));
+			for_each_id(policy, values.size(), 
+				[this, &f, &args...](const std::size_t i){ values[i] = f(get_element(args, i)...); },
+				write_alignment<T>);
+		}
+
+
+		/*
+		VIEW TRANSFORM
+		This mirrors the behavior of the overloads above for any combination of arguments that includes a series view.
+		See "view.hpp" for more details.
+		*/
+		template <typename F, typename... Targs, std::enable_if_t<!is_execution_policy<F> && (is_series_view<Targs> || ...), int> = 0>
+		inline void store(const F f, const Targs&... args)
+		{
+			store(sequenced, f, args...);
+		}
+
+
 
 
 
@@ -479,6 +573,77 @@ namespace series
 		}
 	}
 
+	/*
+	The following overloads run `aggregate_into()` according to a given execution policy.
+	Threads would race if they wrote to the same group, so we use an "owner computes" strategy:
+	each thread owns a contiguous range of group ids, and only that thread may write to groups within the range.
+	Input is first partitioned by the owner of each group, and each owner then visits its input in the original order,
+	so the output is identical to that of a sequential run, even for aggregators that are not associative or commutative.
+	*/
+	template<typename T, typename Tid, typename Taggregator>
+	inline void aggregate_into(const SequencedPolicy policy, const Series<T>& a, const Series<Tid>& group_ids, Taggregator aggregator, Series<T>& group_out)
+	{
+		aggregate_into(a, group_ids, aggregator, group_out);
+	}
+	template<typename T, typename Tid, typename Taggregator>
+	void aggregate_into(const ParallelPolicy policy, const Series<T>& a, const Series<Tid>& group_ids, Taggregator aggregator, Series<T>& group_out)
+	{
+		assert(a.size() == group_ids.size());
+		const std::size_t block_count = get_block_count(policy, group_ids.size());
+		if (block_count < 2)
+		{
+			aggregate_into(a, group_ids, aggregator, group_out);
+			return;
+		}
+		const std::size_t group_count = group_out.size();
+		auto get_owner = [block_count, group_count](const std::size_t group_id) -> std::size_t {
+			return (group_id * block_count) / group_count;
+		};
+		// counts[block_id*block_count + owner_id] counts ids within the input block of `block_id` whose groups are owned by `owner_id`
+		std::vector<std::size_t> counts(block_count*block_count, 0);
+		for_each_block(block_count, group_ids.size(), 
+			[&](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					assert(0 <= group_ids[i]);
+					assert(std::size_t(group_ids[i]) < group_count);
+					counts[block_id*block_count + get_owner(group_ids[i])]++;
+				}
+			});
+		// offsets[block_id*block_count + owner_id] is where ids of that bucket start within `owned_ids`,
+		// where buckets are ordered first by owner and then by input block, so each owner reads a contiguous range in the original order
+		std::vector<std::size_t> offsets(block_count*block_count, 0);
+		std::size_t offset = 0;
+		for (std::size_t owner_id = 0; owner_id < block_count; ++owner_id)
+		{
+			for (std::size_t block_id = 0; block_id < block_count; ++block_id)
+			{
+				offsets[block_id*block_count + owner_id] = offset;
+				offset += counts[block_id*block_count + owner_id];
+			}
+		}
+		std::vector<std::size_t> owned_ids(group_ids.size());
+		for_each_block(block_count, group_ids.size(), 
+			[&](const std::size_t block_id, const std::size_t begin, const std::size_t end) {
+				std::size_t* block_offsets = &offsets[block_id*block_count];
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					owned_ids[block_offsets[get_owner(group_ids[i])]++] = i;
+				}
+			});
+		// once filled, the bucket of the last input block marks the end of each owner's range
+		for_each_block(block_count, group_count, 
+			[&](const std::size_t owner_id, const std::size_t begin, const std::size_t end) {
+				const std::size_t owned_begin = owner_id == 0? 0 : offsets[(block_count-1)*block_count + owner_id-1];
+				const std::size_t owned_end = offsets[(block_count-1)*block_count + owner_id];
+				for (std::size_t j = owned_begin; j < owned_end; ++j)
+				{
+					const std::size_t i = owned_ids[j];
+					group_out[group_ids[i]] = aggregator(group_out[group_ids[i]], a[i]);
+				}
+			});
+	}
+
 
 
 
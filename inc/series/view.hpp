@@ -0,0 +1,270 @@
+#pragma once
+
+// C libraries
+#include <assert.h>     /* assert */
+
+// std libraries
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <type_traits>  // std::remove_const_t, std::decay_t, std::is_same
+
+#include "types.hpp"
+
+/*
+"view.hpp" contains series that refer to elements owned by other objects, without copying them.
+This allows subranges, layers, and components of a series to be read and written in place, e.g.
+
+	series::floats a(100);
+	auto first_half = series::view(a, 0, 50);
+	auto every_third = series::strided_view(a, 0, 3);
+	series::add(first_half, 1.f, first_half);
+
+`SeriesView` refers to a contiguous block of elements, and `StridedSeriesView` refers to elements
+that are separated by a constant number of elements (the "stride").
+Views can be passed as input or output to any function that is implemented using `store()`,
+in combination with any other series or singleton.
+Views can also be passed to `fill()`, `copy()`, `get()`, and `set()`, including the overloads that take ids or masks,
+so subsets of a view can be read and written without first copying the view into a series.
+A view of a `const` series is a view of `const` elements, and cannot be used as output.
+
+Views do not own their elements, so a view must not outlive the series that it refers to,
+and it is invalidated if that series is resized.
+*/
+
+namespace series
+{
+	template <typename T>
+	class SeriesView : public AbstractSeriesView
+	{
+		T* values;
+		std::size_t count;
+
+	public:
+		using size_type = std::size_t;
+		using value_type = std::remove_const_t<T>;
+
+		SeriesView(T* values, const std::size_t count) : values(values), count(count) {}
+
+		inline std::size_t size() const      { return count; }
+		inline bool empty() const            { return count == 0; }
+		inline T* data() const               { return values; }
+		inline T* begin() const              { return values; }
+		inline T* end() const                { return values + count; }
+		inline T& front() const              { return values[0]; }
+		inline T& back() const               { return values[count-1]; }
+		inline T& operator[](const std::size_t id) const
+		{
+			return values[id];
+		}
+
+		// see `Series::store()`
+		template <typename F, typename... Targs, std::enable_if_t<!is_execution_policy<F>, int> = 0>
+		inline void store(const F f, const Targs&... args) const
+		{
+			store(sequenced, f, args...);
+		}
+		template <typename Tpolicy, typename F, typename... Targs, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+		inline void store(const Tpolicy policy, const F f, const Targs&... args) const
+		{
+			assert(((get_size(args, count) == count) && ...));
+			T* out = values;
+			for_each_id(policy, count,
+				[out, &f, &args...](const std::size_t i){ out[i] = f(get_element(args, i)...); });
+		}
+	};
+
+	template <typename T>
+	class StridedSeriesView : public AbstractSeriesView
+	{
+		T* values;
+		std::size_t count;
+		std::ptrdiff_t stride;
+
+	public:
+		using size_type = std::size_t;
+		using value_type = std::remove_const_t<T>;
+
+		StridedSeriesView(T* values, const std::size_t count, const std::ptrdiff_t stride) :
+			values(values), count(count), stride(stride)
+		{}
+
+		inline std::size_t size() const      { return count; }
+		inline bool empty() const            { return count == 0; }
+		inline T& front() const              { return values[0]; }
+		inline T& back() const               { return values[(count-1)*stride]; }
+		inline T& operator[](const std::size_t id) const
+		{
+			return values[id*stride];
+		}
+
+		// see `Series::store()`
+		template <typename F, typename... Targs, std::enable_if_t<!is_execution_policy<F>, int> = 0>
+		inline void store(const F f, const Targs&... args) const
+		{
+			store(sequenced, f, args...);
+		}
+		template <typename Tpolicy, typename F, typename... Targs, std::enable_if_t<is_execution_policy<Tpolicy>, int> = 0>
+		inline void store(const Tpolicy policy, const F f, const Targs&... args) const
+		{
+			assert(((get_size(args, count) == count) && ...));
+			T* out = values;
+			const std::ptrdiff_t step = stride;
+			for_each_id(policy, count,
+				[out, step, &f, &args...](const std::size_t i){ out[i*step] = f(get_element(args, i)...); });
+		}
+	};
+
+
+
+	/*
+	`view()` returns a view of the elements of `a` from `first` up to but not including `last`,
+	or of all elements if no range is given.
+	*/
+	template <typename T>
+	inline SeriesView<T> view(Series<T>& a)
+	{
+		return SeriesView<T>(a.data(), a.size());
+	}
+	template <typename T>
+	inline SeriesView<const T> view(const Series<T>& a)
+	{
+		return SeriesView<const T>(a.data(), a.size());
+	}
+	template <typename T>
+	inline SeriesView<T> view(Series<T>& a, const std::size_t first, const std::size_t last)
+	{
+		assert(first <= last && last <= a.size());
+		return SeriesView<T>(a.data() + first, last - first);
+	}
+	template <typename T>
+	inline SeriesView<const T> view(const Series<T>& a, const std::size_t first, const std::size_t last)
+	{
+		assert(first <= last && last <= a.size());
+		return SeriesView<const T>(a.data() + first, last - first);
+	}
+
+	/*
+	`strided_view()` returns a view of every `stride`th element of `a`, starting at `offset`.
+	*/
+	template <typename T>
+	inline StridedSeriesView<T> strided_view(Series<T>& a, const std::size_t offset, const std::size_t stride)
+	{
+		assert(stride > 0);
+		const std::size_t count = offset < a.size()? (a.size() - offset + stride - 1) / stride : 0;
+		return StridedSeriesView<T>(a.data() + offset, count, stride);
+	}
+	template <typename T>
+	inline StridedSeriesView<const T> strided_view(const Series<T>& a, const std::size_t offset, const std::size_t stride)
+	{
+		assert(stride > 0);
+		const std::size_t count = offset < a.size()? (a.size() - offset + stride - 1) / stride : 0;
+		return StridedSeriesView<const T>(a.data() + offset, count, stride);
+	}
+
+
+
+	template <typename Tview, std::enable_if_t<is_series_view<Tview>, int> = 0>
+	void fill(const Tview& out, const typename Tview::value_type a)
+	{
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			out[i] = a;
+		}
+	}
+	template <typename Tout, typename T, std::enable_if_t<is_series_view<std::decay_t<Tout>> || is_series_view<T>, int> = 0>
+	void copy(Tout&& out, const T& a)
+	{
+		assert(out.size() == a.size());
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			out[i] = a[i];
+		}
+	}
+
+	/*
+	The following overloads mirror the subset operations of "types.hpp", 
+	and are used whenever any of their arguments is a view.
+	`ids` are indices into a series, and `mask` is a series of booleans with the same size as the series it masks.
+	*/
+	template <typename Tids>
+	constexpr bool is_mask = std::is_same<typename Tids::value_type, bool>::value;
+
+	template <typename T, typename Tids, typename Tout, 
+		std::enable_if_t<(is_series_view<T> || is_series_view<Tids> || is_series_view<std::decay_t<Tout>>) && !is_mask<Tids>, int> = 0>
+	void get(const T& a, const Tids& ids, Tout&& out)
+	{
+		assert(ids.size() == out.size());
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			assert(std::size_t(ids[i]) < a.size());
+			out[i] = a[ids[i]];
+		}
+	}
+	template <typename T, typename Tmask, typename Tout, 
+		std::enable_if_t<(is_series_view<T> || is_series_view<Tmask> || is_series_view<std::decay_t<Tout>>) && is_mask<Tmask>, int> = 0>
+	void get(const T& a, const Tmask& mask, Tout&& out)
+	{
+		assert(a.size() == mask.size());
+		std::size_t out_i = 0;
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			if (mask[i])
+			{
+				out[out_i] = a[i];
+				out_i++;
+			}
+		}
+	}
+	template <typename Tout, typename Tids, 
+		std::enable_if_t<(is_series_view<std::decay_t<Tout>> || is_series_view<Tids>) && !is_mask<Tids>, int> = 0>
+	void fill(Tout&& out, const Tids& ids, const typename std::decay_t<Tout>::value_type a)
+	{
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			assert(std::size_t(ids[i]) < out.size());
+			out[ids[i]] = a;
+		}
+	}
+	template <typename Tout, typename Tmask, 
+		std::enable_if_t<(is_series_view<std::decay_t<Tout>> || is_series_view<Tmask>) && is_mask<Tmask>, int> = 0>
+	void fill(Tout&& out, const Tmask& mask, const typename std::decay_t<Tout>::value_type a)
+	{
+		assert(out.size() == mask.size());
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			if (mask[i]) { out[i] = a; }
+		}
+	}
+	template <typename Tout, typename Tids, typename T, 
+		std::enable_if_t<(is_series_view<std::decay_t<Tout>> || is_series_view<Tids> || is_series_view<T>) && !is_mask<Tids>, int> = 0>
+	void copy(Tout&& out, const Tids& ids, const T& a)
+	{
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			assert(std::size_t(ids[i]) < out.size());
+			assert(std::size_t(ids[i]) < a.size());
+			out[ids[i]] = a[ids[i]];
+		}
+	}
+	template <typename Tout, typename Tmask, typename T, 
+		std::enable_if_t<(is_series_view<std::decay_t<Tout>> || is_series_view<Tmask> || is_series_view<T>) && is_mask<Tmask>, int> = 0>
+	void copy(Tout&& out, const Tmask& mask, const T& a)
+	{
+		assert(out.size() == mask.size());
+		assert(out.size() == a.size());
+		for (std::size_t i = 0; i < out.size(); ++i)
+		{
+			if (mask[i]) { out[i] = a[i]; }
+		}
+	}
+	template <typename Tout, typename Tids, typename T, 
+		std::enable_if_t<(is_series_view<std::decay_t<Tout>> || is_series_view<Tids> || is_series_view<T>) && !is_mask<Tids>, int> = 0>
+	void set(Tout&& out, const Tids& ids, const T& a)
+	{
+		assert(ids.size() == a.size());
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			assert(std::size_t(ids[i]) < out.size());
+			out[ids[i]] = a[i];
+		}
+	}
+}
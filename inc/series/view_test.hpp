@@ -0,0 +1,78 @@
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch/catch.hpp>
+
+#include <series/series.hpp>  
+#include <series/view.hpp>  
+
+
+TEST_CASE( "SeriesView<T> correctness", "[many]" ) {
+    series::floats a({1,2,3,4,5,6});
+    series::floats b({10,20,30});
+
+    SECTION("Views must refer to the elements of the series they view, without copying them"){
+        auto middle = series::view(a, 1, 4);
+        CHECK(middle.size() == 3);
+        CHECK(middle[0] == 2);
+        middle[0] = 7;
+        CHECK(a[1] == 7);
+    }
+    SECTION("Strided views must refer to every nth element of the series they view"){
+        auto odd = series::strided_view(a, 1, 2);
+        CHECK(odd.size() == 3);
+        CHECK(odd[0] == 2);
+        CHECK(odd[1] == 4);
+        CHECK(odd[2] == 6);
+        CHECK(series::strided_view(a, 0, 4).size() == 2);
+        CHECK(series::strided_view(a, 6, 4).size() == 0);
+    }
+    SECTION("Views must be usable as both input and output of series functions"){
+        auto head = series::view(a, 0, 3);
+        auto even = series::strided_view(a, 0, 2);
+        series::floats c(3);
+        series::add(head, b, c);
+        CHECK(c == series::floats({11,22,33}));
+        series::mult(b, 2.f, even);
+        CHECK(a == series::floats({20,2,40,4,60,6}));
+        series::add(even, series::strided_view(a, 1, 2), even);
+        CHECK(a == series::floats({22,2,44,4,66,6}));
+    }
+    SECTION("Views of const series must be usable as input"){
+        const series::floats& const_a = a;
+        auto tail = series::view(const_a, 3, 6);
+        series::floats c(3);
+        series::sub(tail, 1.f, c);
+        CHECK(c == series::floats({3,4,5}));
+    }
+    SECTION("Views must support fill() and copy()"){
+        auto odd = series::strided_view(a, 1, 2);
+        series::fill(odd, 0.f);
+        CHECK(a == series::floats({1,0,3,0,5,0}));
+        series::copy(odd, b);
+        CHECK(a == series::floats({1,10,3,20,5,30}));
+        series::floats c(3);
+        series::copy(c, series::view(a, 0, 3));
+        CHECK(c == series::floats({1,10,3}));
+    }
+    SECTION("Views must support subset operations that take ids or masks"){
+        auto odd = series::strided_view(a, 1, 2);
+        series::uints ids({2,0});
+        series::bools mask({true,false,true});
+        series::floats c(2);
+        series::get(odd, ids, c);
+        CHECK(c == series::floats({6,2}));
+        series::get(odd, mask, c);
+        CHECK(c == series::floats({2,6}));
+        series::set(odd, ids, series::floats({60,20}));
+        CHECK(a == series::floats({1,20,3,4,5,60}));
+        series::fill(odd, mask, 0.f);
+        CHECK(a == series::floats({1,0,3,4,5,0}));
+        series::fill(odd, series::view(ids, 1, 2), 9.f);
+        CHECK(a == series::floats({1,9,3,4,5,0}));
+        series::copy(odd, ids, b);
+        CHECK(a == series::floats({1,10,3,4,5,30}));
+        series::copy(series::view(a, 0, 3), mask, b);
+        CHECK(a == series::floats({10,10,30,4,5,30}));
+    }
+}
+
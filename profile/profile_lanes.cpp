@@ -0,0 +1,74 @@
+
+#include <iostream>     // std::cout
+#include <random>       // std::mt19937
+#include <chrono>       // high_resolution_clock
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+#include <series/glm/lanes.hpp>       // vec3lanes
+
+/*
+Compares the time needed to run geometric functions on 10 million vectors,
+when vectors are interleaved (`series::vec3s`) and when they are stored in lanes (`series::vec3lanes`).
+Compile with `-march=native` to allow the compiler to use the widest vector instructions that are available.
+*/
+
+template<typename F>
+double time_milliseconds(const int iteration_count, const F f)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iteration_count; ++i)
+    {
+        f();
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t2 - t1).count() / iteration_count;
+}
+
+int main(int argc, char const *argv[])
+{
+    const std::size_t N = 10000000;
+    const int iteration_count = 10;
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    series::vec3s a(N);
+    series::vec3s b(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        a[i] = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+        b[i] = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+    series::vec3s vector_out(N);
+    series::floats scalar_out(N);
+
+    series::vec3lanes a_lanes(N);
+    series::vec3lanes b_lanes(N);
+    series::vec3lanes vector_out_lanes(N);
+    series::split(a, a_lanes);
+    series::split(b, b_lanes);
+
+    std::cout << "function    interleaved (ms)  lanes (ms)  lanes, parallel (ms)" << std::endl;
+    std::cout << "dot         " 
+        << time_milliseconds(iteration_count, [&](){ series::dot(a, b, scalar_out); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::dot(a_lanes, b_lanes, scalar_out); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::dot(series::parallel, a_lanes, b_lanes, scalar_out); }) << std::endl;
+    std::cout << "cross       " 
+        << time_milliseconds(iteration_count, [&](){ series::cross(a, b, vector_out); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::cross(a_lanes, b_lanes, vector_out_lanes); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::cross(series::parallel, a_lanes, b_lanes, vector_out_lanes); }) << std::endl;
+    std::cout << "length      " 
+        << time_milliseconds(iteration_count, [&](){ series::length(a, scalar_out); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::length(a_lanes, scalar_out); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::length(series::parallel, a_lanes, scalar_out); }) << std::endl;
+    std::cout << "normalize   " 
+        << time_milliseconds(iteration_count, [&](){ series::normalize(a, vector_out); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::normalize(a_lanes, vector_out_lanes); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::normalize(series::parallel, a_lanes, vector_out_lanes); }) << std::endl;
+    std::cout << "split/join  " 
+        << time_milliseconds(iteration_count, [&](){ series::split(a, a_lanes); }) << "  "
+        << time_milliseconds(iteration_count, [&](){ series::join(a_lanes, vector_out); }) << std::endl;
+    return 0;
+}
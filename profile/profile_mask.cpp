@@ -0,0 +1,74 @@
+
+#include <iostream>     // std::cout
+#include <chrono>       // high_resolution_clock
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+
+#include <rasters/entities/Grid/Grid.hpp>
+#include <rasters/entities/Grid/Raster.hpp>
+#include <rasters/entities/Grid/Mask.hpp>
+#include <rasters/entities/Grid/morphologic.hpp>
+
+/*
+Compares the time needed to run boolean algebra and morphology on a plate-like region of a subdivided icosahedron,
+when the region is stored as a `Raster<bool>` and when it is stored as a `Mask`.
+*/
+
+template<typename F>
+double time_milliseconds(const F f)
+{
+    const int repetition_count = 10;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < repetition_count; ++i)
+    {
+        f();
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t2 - t1).count() / repetition_count;
+}
+
+int main(int argc, char const *argv[])
+{
+    const meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, 8, true);
+    const rasters::Grid<unsigned int, float> grid(icosphere.vertices, icosphere.faces);
+    auto a = rasters::make_Raster<bool>(grid);
+    auto b = rasters::make_Raster<bool>(grid);
+    auto out = rasters::make_Raster<bool>(grid);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = glm::dot(grid.metrics->vertex_positions[i], glm::vec3(1,2,3)) > 0.5f;
+        b[i] = glm::dot(grid.metrics->vertex_positions[i], glm::vec3(-3,1,2)) > 0.0f;
+    }
+    const rasters::Mask<rasters::Grid<unsigned int, float>> a_mask(a);
+    const rasters::Mask<rasters::Grid<unsigned int, float>> b_mask(b);
+    auto out_mask = rasters::make_Mask(grid);
+    std::size_t total = 0;
+    std::cout << "vertex count: " << a.size() << std::endl;
+    std::cout << "operation  Raster<bool> (ms)  Mask (ms)" << std::endl;
+    std::cout << "unite  " 
+        << time_milliseconds([&](){ series::unite(a, b, out); }) << "  "
+        << time_milliseconds([&](){ rasters::unite(a_mask, b_mask, out_mask); }) << std::endl;
+    std::cout << "count  " 
+        << time_milliseconds([&](){ for (std::size_t i = 0; i < a.size(); ++i) { total += a[i]; } }) << "  "
+        << time_milliseconds([&](){ total += rasters::count(a_mask); }) << std::endl;
+    std::cout << "dilate  " 
+        << time_milliseconds([&](){ rasters::dilate(a, out); }) << "  "
+        << time_milliseconds([&](){ rasters::dilate(a_mask, out_mask); }) << std::endl;
+    std::cout << "erode  " 
+        << time_milliseconds([&](){ rasters::erode(a, out); }) << "  "
+        << time_milliseconds([&](){ rasters::erode(a_mask, out_mask); }) << std::endl;
+    std::cout << "opening, radius 3  " 
+        << time_milliseconds([&](){ rasters::opening(a, out, 3); }) << "  "
+        << time_milliseconds([&](){ rasters::opening(a_mask, out_mask, 3); }) << std::endl;
+    std::cout << "margin  " 
+        << time_milliseconds([&](){ rasters::margin(a, out); }) << "  "
+        << time_milliseconds([&](){ rasters::margin(a_mask, out_mask); }) << std::endl;
+    std::cout << "(" << total << ")" << std::endl;
+    return 0;
+}
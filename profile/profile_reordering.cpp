@@ -0,0 +1,118 @@
+
+#include <algorithm>    // std::shuffle
+#include <iostream>     // std::cout
+#include <random>       // std::mt19937
+#include <chrono>       // high_resolution_clock
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+#include <rasters/entities/Grid/Grid.hpp>
+#include <rasters/entities/Grid/Raster.hpp>
+#include <rasters/entities/Grid/vector_calculus.hpp>
+
+/*
+Compares the time needed to gather the values of neighboring vertices, and to calculate gradient and divergence, 
+on a level 8 icosphere, before and after its vertices are renumbered using `meshes::reorder()` and `meshes::get_morton_order()`.
+The neighbor gather reads nothing but the value of each neighbor of each vertex, so it isolates the effect of the ordering on memory access,
+whereas gradient and divergence also depend on the order of arrows.
+Vertices of a subdivided mesh are already numbered with some locality, 
+so a random numbering is also timed, to represent meshes that are read from sources with no such guarantee.
+To compare cache misses, run this under `perf stat -e cache-misses,cache-references`
+once with each ordering, using the first argument to select an ordering ("original", "shuffled", or "morton").
+*/
+typedef rasters::Grid<unsigned int, float> Grid;
+
+template<typename Tduration>
+void profile(const std::string& label, const Grid& grid, const int iteration_count)
+{
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    rasters::Raster<float, Grid>     scalar_field(grid);
+    rasters::Raster<glm::vec3, Grid> vector_field(grid);
+    rasters::Raster<glm::vec3, Grid> gradient_out(grid);
+    rasters::Raster<float, Grid>     divergence_out(grid);
+    rasters::Raster<float, Grid, rasters::mapping::arrow>     arrow_scalars(grid);
+    rasters::Raster<glm::vec3, Grid, rasters::mapping::arrow> arrow_vectors(grid);
+    for (std::size_t i = 0; i < scalar_field.size(); ++i)
+    {
+        scalar_field[i] = distribution(generator);
+        vector_field[i] = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+
+    const auto& structure = *grid.structure;
+    rasters::Raster<float, Grid>     gather_out(grid);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iteration_count; ++i)
+    {
+        for (std::size_t j = 0; j < structure.vertex_count; ++j)
+        {
+            float sum = 0.f;
+            for (std::size_t k = structure.vertex_neighbor_offsets[j]; k < structure.vertex_neighbor_offsets[j+1]; ++k)
+            {
+                sum += scalar_field[structure.vertex_neighbor_ids[k]];
+            }
+            gather_out[j] = sum;
+        }
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iteration_count; ++i)
+    {
+        rasters::gradient(scalar_field, gradient_out, arrow_scalars, arrow_vectors);
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iteration_count; ++i)
+    {
+        rasters::divergence(vector_field, divergence_out, arrow_vectors, arrow_scalars);
+    }
+    auto t3 = std::chrono::high_resolution_clock::now();
+    std::cout << label << " gather:     " << std::chrono::duration_cast<Tduration>( t1 - t0 ).count() / iteration_count 
+              << " (checksum " << series::sum(gather_out) << ")" << std::endl;
+    std::cout << label << " gradient:   " << std::chrono::duration_cast<Tduration>( t2 - t1 ).count() / iteration_count << std::endl;
+    std::cout << label << " divergence: " << std::chrono::duration_cast<Tduration>( t3 - t2 ).count() / iteration_count << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    const std::string ordering = argc > 1? argv[1] : "all";
+    const int iteration_count = 10;
+
+    meshes::mesh icosphere_mesh(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    for (int level = 0; level < 8; ++level)
+    {
+        icosphere_mesh = meshes::subdivide(icosphere_mesh);
+    }
+    series::normalize(icosphere_mesh.vertices, icosphere_mesh.vertices);
+    std::cout << "vertex count: " << icosphere_mesh.vertices.size() << std::endl;
+    std::cout << "times are in microseconds per call" << std::endl;
+
+    if (ordering == "all" || ordering == "original")
+    {
+        Grid original(icosphere_mesh.vertices, icosphere_mesh.faces);
+        profile<std::chrono::microseconds>("original", original, iteration_count);
+    }
+    if (ordering == "all" || ordering == "shuffled")
+    {
+        series::uints old_ids(icosphere_mesh.vertices.size());
+        for (std::size_t i = 0; i < old_ids.size(); ++i)
+        {
+            old_ids[i] = i;
+        }
+        std::mt19937 generator(2);
+        std::shuffle(old_ids.begin(), old_ids.end(), generator);
+        meshes::mesh shuffled_mesh = meshes::reorder(icosphere_mesh, old_ids);
+        Grid shuffled(shuffled_mesh.vertices, shuffled_mesh.faces);
+        profile<std::chrono::microseconds>("shuffled", shuffled, iteration_count);
+    }
+    if (ordering == "all" || ordering == "morton")
+    {
+        series::uints old_ids = meshes::get_morton_order(icosphere_mesh.vertices);
+        meshes::mesh reordered_mesh = meshes::reorder(icosphere_mesh, old_ids);
+        Grid reordered(reordered_mesh.vertices, reordered_mesh.faces);
+        profile<std::chrono::microseconds>("morton  ", reordered, iteration_count);
+    }
+}
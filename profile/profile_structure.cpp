@@ -0,0 +1,55 @@
+
+#include <iostream>     // std::cout
+#include <string>       // std::stoi
+#include <chrono>       // high_resolution_clock
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+#include <rasters/components/Structure/Structure.hpp>
+
+/*
+Compares the time needed to construct a `Structure` using `SortedArrowConstruction` and `HashedArrowConstruction`,
+for icospheres subdivided 5 through 10 times. 
+Pass a maximum subdivision level as the first argument to stop early, since hashing requires a lot of memory at high levels.
+*/
+int main(int argc, char const *argv[])
+{
+    const int max_level = argc > 1? std::stoi(argv[1]) : 10;
+
+    std::chrono::_V2::system_clock::time_point t1, t2;
+
+    meshes::mesh icosphere_mesh(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    std::cout << "level  vertices    faces       sorted (ms)  hashed (ms)" << std::endl;
+    for (int level = 1; level <= max_level; ++level)
+    {
+        icosphere_mesh = meshes::subdivide(icosphere_mesh);
+        if (level < 5)
+        {
+            continue;
+        }
+
+        t1 = std::chrono::high_resolution_clock::now();
+        rasters::Structure sorted(icosphere_mesh.vertices.size(), icosphere_mesh.faces, rasters::SortedArrowConstruction());
+        t2 = std::chrono::high_resolution_clock::now();
+        auto sorted_duration = std::chrono::duration_cast<std::chrono::milliseconds>( t2 - t1 ).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        rasters::Structure hashed(icosphere_mesh.vertices.size(), icosphere_mesh.faces, rasters::HashedArrowConstruction());
+        t2 = std::chrono::high_resolution_clock::now();
+        auto hashed_duration = std::chrono::duration_cast<std::chrono::milliseconds>( t2 - t1 ).count();
+
+        std::cout 
+            << level << "      " 
+            << icosphere_mesh.vertices.size() << "    " 
+            << icosphere_mesh.faces.size() << "    " 
+            << sorted_duration << "    " 
+            << hashed_duration << "    "
+            << (sorted.arrow_count == hashed.arrow_count? "" : "MISMATCH") 
+            << std::endl;
+    }
+}
@@ -0,0 +1,52 @@
+
+#include <iostream>     // std::cout
+#include <chrono>       // high_resolution_clock
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+
+/*
+Compares the time needed to generate icospheres of increasing level,
+when each level is built by calling `subdivide()` and normalizing, 
+and when all levels are built by a single call to `subdivide()` that is given the number of levels.
+*/
+
+template<typename F>
+double time_milliseconds(const F f)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+    f();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+}
+
+int main(int argc, char const *argv[])
+{
+    std::cout << "level  vertex count  repeated subdivide (ms)  subdivide(level) (ms)  subdivide(level), parallel (ms)" << std::endl;
+    for (unsigned int level = 6; level <= 10; ++level)
+    {
+        std::size_t vertex_count = 0;
+        const double repeated = time_milliseconds([&](){ 
+            meshes::mesh icosphere = meshes::icosahedron;
+            for (unsigned int i = 0; i < level; ++i)
+            {
+                icosphere = meshes::subdivide(icosphere); 
+                series::normalize(icosphere.vertices, icosphere.vertices);
+            }
+            vertex_count = icosphere.vertices.size();
+        });
+        std::cout << level << "  " << vertex_count << "  " << repeated << "  "
+            << time_milliseconds([&](){ 
+                meshes::mesh icosphere = meshes::subdivide(meshes::icosahedron, level, true); 
+            }) << "  "
+            << time_milliseconds([&](){ 
+                meshes::mesh icosphere = meshes::subdivide(series::parallel, meshes::icosahedron, level, true); 
+            }) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+
+#include <iostream>     // std::cout
+#include <chrono>       // high_resolution_clock
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+
+#include <rasters/components/Structure/Structure.hpp>
+#include <rasters/components/Metrics/Metrics.hpp>
+#include <rasters/components/SpheroidVoronoi/SpheroidVoronoi.hpp>
+
+/*
+Compares the time needed to construct the voronoi lookup of a SpheroidGrid for subdivided icosahedra,
+when cells are populated from the neighborhood of each vertex and when they are populated by walking the mesh.
+*/
+
+template<typename F>
+double time_milliseconds(const F f)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+    f();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+}
+
+int main(int argc, char const *argv[])
+{
+    meshes::mesh icosphere(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    std::cout << "vertex count  vertex neighborhoods (ms)  mesh walk (ms)  mesh walk, parallel (ms)" << std::endl;
+    for (int level = 1; level <= 8; ++level)
+    {
+        icosphere = meshes::subdivide(icosphere);
+        rasters::Structure<unsigned int> structure(icosphere.vertices.size(), icosphere.faces);
+        rasters::Metrics<unsigned int, float> metrics(icosphere.vertices, structure);
+        const float cell_width = series::min(metrics.arrow_lengths / 8.f);
+        const float max_vertex_distance = series::max(metrics.arrow_lengths * 1.f);
+        std::cout << icosphere.vertices.size() << "  "
+            << time_milliseconds([&](){ 
+                rasters::SpheroidVoronoi voronoi(icosphere.vertices, cell_width, max_vertex_distance); 
+            }) << "  "
+            << time_milliseconds([&](){ 
+                rasters::SpheroidVoronoi voronoi(series::sequenced, icosphere.vertices, 
+                    structure.vertex_neighbor_offsets, structure.vertex_neighbor_ids, cell_width, max_vertex_distance); 
+            }) << "  "
+            << time_milliseconds([&](){ 
+                rasters::SpheroidVoronoi voronoi(series::parallel, icosphere.vertices, 
+                    structure.vertex_neighbor_offsets, structure.vertex_neighbor_ids, cell_width, max_vertex_distance); 
+            }) << std::endl;
+    }
+    return 0;
+}
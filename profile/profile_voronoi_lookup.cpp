@@ -0,0 +1,85 @@
+
+#include <iostream>     // std::cout
+#include <random>       // std::mt19937
+#include <chrono>       // high_resolution_clock
+
+#define GLM_FORCE_PURE      // disable anonymous structs so we can build with ISO C++
+#include <glm/vec3.hpp>               // *vec3
+
+#include <series/series.hpp>  
+#include <series/glm/glm.hpp>         // *vec*s
+
+#include <meshes/mesh.hpp>
+
+#include <rasters/components/Structure/Structure.hpp>
+#include <rasters/components/Metrics/Metrics.hpp>
+#include <rasters/components/SpheroidVoronoi/SpheroidVoronoi.hpp>
+#include <rasters/components/SpheroidVoronoi/CompactSpheroidVoronoi.hpp>
+
+/*
+Compares the time needed to look up the nearest vertex of a subdivided icosahedron for many query points,
+when each query is looked up individually (`get_value()`) and when queries are looked up in batches (`get_values()`),
+and when the lookup is stored densely (`SpheroidVoronoi`) and compactly (`CompactSpheroidVoronoi`).
+Compile with `-march=native` to allow the compiler to use the widest vector instructions that are available.
+*/
+
+template<typename F>
+double time_milliseconds(const int iteration_count, const F f)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iteration_count; ++i)
+    {
+        f();
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t2 - t1).count() / iteration_count;
+}
+
+series::vec3s get_random_points(const std::size_t N, std::mt19937& generator)
+{
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    series::vec3s points(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        points[i] = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+    return points;
+}
+
+int main(int argc, char const *argv[])
+{
+    const int iteration_count = 3;
+    std::mt19937 generator(2);
+    meshes::mesh icosphere(meshes::icosahedron.vertices, meshes::icosahedron.faces);
+    for (int level = 0; level < 7; ++level)
+    {
+        icosphere = meshes::subdivide(icosphere);
+    }
+    rasters::Structure<unsigned int> structure(icosphere.vertices.size(), icosphere.faces);
+    rasters::Metrics<unsigned int, float> metrics(icosphere.vertices, structure);
+    rasters::SpheroidVoronoi voronoi(series::sequenced, icosphere.vertices, 
+        structure.vertex_neighbor_offsets, structure.vertex_neighbor_ids, 
+        series::min(metrics.arrow_lengths / 8.f), series::max(metrics.arrow_lengths * 1.f));
+    rasters::CompactSpheroidVoronoi compact(voronoi);
+
+    std::cout << "vertex count: " << icosphere.vertices.size() << std::endl;
+    std::cout << "dense memory (MB): " << voronoi.memory_size() / 1e6 << std::endl;
+    std::cout << "compact memory (MB): " << compact.memory_size() / 1e6 << std::endl;
+    std::cout << "query count  individual (ms)  batched (ms)  batched, parallel (ms)  compact, batched (ms)" << std::endl;
+    for (std::size_t N : {1000000, 10000000, 50000000})
+    {
+        const series::vec3s points = get_random_points(N, generator);
+        series::uints out(N);
+        std::cout << N << "  "
+            << time_milliseconds(iteration_count, [&](){ 
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    out[i] = voronoi.get_value(points[i]);
+                }
+            }) << "  "
+            << time_milliseconds(iteration_count, [&](){ voronoi.get_values(points, out); }) << "  "
+            << time_milliseconds(iteration_count, [&](){ voronoi.get_values(series::parallel, points, out); }) << "  "
+            << time_milliseconds(iteration_count, [&](){ compact.get_values(points, out); }) << std::endl;
+    }
+    return 0;
+}